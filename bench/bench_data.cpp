@@ -0,0 +1,20 @@
+#include "bench_data.h"
+
+namespace cc::bench {
+    synthetic::GearSpec make_spec(const Resolution& resolution, int num_teeth) {
+        synthetic::GearSpec spec;
+
+        spec.m_Resolution = resolution;
+        spec.m_NumTeeth   = num_teeth;
+
+        return spec;
+    }
+
+    std::vector<cv::Point> make_gear_contour(size_t num_points, int num_teeth) {
+        return synthetic::make_gear_contour(make_spec({ 1000, 1000 }, num_teeth), num_points);
+    }
+
+    cv::Mat make_gear_image(const Resolution& resolution, int num_teeth) {
+        return synthetic::generate_gear(make_spec(resolution, num_teeth)).m_Image;
+    }
+}
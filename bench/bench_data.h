@@ -0,0 +1,34 @@
+#ifndef CC_BENCH_BENCH_DATA_H
+#define CC_BENCH_BENCH_DATA_H
+
+#include <array>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "synthetic/gear_generator.h"
+#include "types/resolution.h"
+
+namespace cc::bench {
+    // typical camera resolutions that the benchmarks are parameterised with
+    inline constexpr std::array<Resolution, 3> k_Resolutions = {{
+        {  640,  480 },
+        { 1280,  720 },
+        { 1920, 1080 }
+    }};
+
+    // number of points on the (largest) contour
+    inline constexpr std::array<size_t, 4> k_ContourLengths = { 256, 1024, 4096, 16384 };
+
+    inline constexpr int k_NumTeeth      = 24;
+    inline constexpr int k_GearTolerance = 30; // used to segment synthetic::GearSpec::m_GearColor
+
+    [[nodiscard]] synthetic::GearSpec make_spec(const Resolution& resolution, int num_teeth = k_NumTeeth);
+
+    // closed contour of a gear centered in a 1000 x 1000 image, with the requested number of points
+    [[nodiscard]] std::vector<cv::Point> make_gear_contour(size_t num_points, int num_teeth = k_NumTeeth);
+
+    [[nodiscard]] cv::Mat make_gear_image(const Resolution& resolution, int num_teeth = k_NumTeeth);
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <format>
+#include <map>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "util/flat_map.h"
+#include "util/small_flat_map.h"
+#include "util/sorted_flat_map.h"
+
+namespace {
+    // keys in a shuffled order, so that lookups don't simply follow insertion order
+    std::vector<int> make_keys(int count) {
+        std::vector<int> keys(count);
+        std::iota(std::begin(keys), std::end(keys), 0);
+
+        std::default_random_engine generator(123); // fixed seed for reproducibility
+        std::shuffle(std::begin(keys), std::end(keys), generator);
+
+        return keys;
+    }
+}
+
+TEST_CASE("FlatMap vs std containers - insert", "[bench][flat_map]") {
+    auto count = GENERATE(8, 64, 512);
+    auto keys  = make_keys(count);
+
+    BENCHMARK(std::format("FlatMap insert {}", count)) {
+        cc::FlatMap<int, double> map;
+
+        for (int key : keys)
+            map.insert(key, static_cast<double>(key));
+
+        return map.get_num_entries();
+    };
+
+    BENCHMARK(std::format("SortedFlatMap insert {}", count)) {
+        cc::SortedFlatMap<int, double> map;
+
+        for (int key : keys)
+            map.insert(key, static_cast<double>(key));
+
+        return map.get_num_entries();
+    };
+
+    BENCHMARK(std::format("std::map insert {}", count)) {
+        std::map<int, double> map;
+
+        for (int key : keys)
+            map.insert_or_assign(key, static_cast<double>(key));
+
+        return map.size();
+    };
+
+    BENCHMARK(std::format("std::unordered_map insert {}", count)) {
+        std::unordered_map<int, double> map;
+
+        for (int key : keys)
+            map.insert_or_assign(key, static_cast<double>(key));
+
+        return map.size();
+    };
+}
+
+TEST_CASE("FlatMap vs std containers - lookup", "[bench][flat_map]") {
+    auto count = GENERATE(8, 64, 512);
+    auto keys  = make_keys(count);
+
+    cc::FlatMap<int, double>        flat_map;
+    cc::SortedFlatMap<int, double>  sorted_flat_map;
+    std::map<int, double>           map;
+    std::unordered_map<int, double> unordered_map;
+
+    for (int key : keys) {
+        flat_map.insert(key, static_cast<double>(key));
+        sorted_flat_map.insert(key, static_cast<double>(key));
+        map.insert_or_assign(key, static_cast<double>(key));
+        unordered_map.insert_or_assign(key, static_cast<double>(key));
+    }
+
+    auto lookup_keys = make_keys(count * 2); // about half of these are misses
+
+    BENCHMARK(std::format("FlatMap lookup {}", count)) {
+        double total = 0.0;
+
+        for (int key : lookup_keys)
+            if (flat_map.contains(key))
+                total += flat_map[key];
+
+        return total;
+    };
+
+    BENCHMARK(std::format("SortedFlatMap lookup {}", count)) {
+        double total = 0.0;
+
+        for (int key : lookup_keys)
+            if (auto it = sorted_flat_map.find(key); it != sorted_flat_map.end())
+                total += it->second;
+
+        return total;
+    };
+
+    BENCHMARK(std::format("std::map lookup {}", count)) {
+        double total = 0.0;
+
+        for (int key : lookup_keys)
+            if (auto it = map.find(key); it != map.end())
+                total += it->second;
+
+        return total;
+    };
+
+    BENCHMARK(std::format("std::unordered_map lookup {}", count)) {
+        double total = 0.0;
+
+        for (int key : lookup_keys)
+            if (auto it = unordered_map.find(key); it != unordered_map.end())
+                total += it->second;
+
+        return total;
+    };
+}
+
+TEST_CASE("FlatMap vs SortedFlatMap - bulk construction", "[bench][flat_map]") {
+    auto count = GENERATE(512, 4096);
+    auto keys  = make_keys(count);
+
+    std::vector<std::pair<int, double>> entries;
+    entries.reserve(keys.size());
+
+    for (int key : keys)
+        entries.emplace_back(key, static_cast<double>(key));
+
+    BENCHMARK(std::format("FlatMap insert one by one {}", count)) {
+        cc::FlatMap<int, double> map;
+
+        for (const auto& [key, value] : entries)
+            map.insert(key, double(value));
+
+        return map.get_num_entries();
+    };
+
+    BENCHMARK(std::format("SortedFlatMap insert_range {}", count)) {
+        cc::SortedFlatMap<int, double> map;
+        map.insert_range(entries);
+
+        return map.get_num_entries();
+    };
+}
+
+TEST_CASE("FlatMap vs SmallFlatMap - small table lookup", "[bench][flat_map]") {
+    auto count = GENERATE(4, 8, 16);
+    auto keys  = make_keys(count);
+
+    cc::FlatMap<int, double>          flat_map;
+    cc::SortedFlatMap<int, double>    sorted_flat_map;
+    cc::SmallFlatMap<int, double, 16> small_flat_map;
+
+    for (int key : keys) {
+        flat_map.insert(key, static_cast<double>(key));
+        sorted_flat_map.insert(key, static_cast<double>(key));
+        small_flat_map.insert(key, static_cast<double>(key));
+    }
+
+    auto lookup_keys = make_keys(count * 2); // about half of these are misses
+
+    BENCHMARK(std::format("FlatMap small lookup {}", count)) {
+        double total = 0.0;
+
+        for (int key : lookup_keys)
+            if (flat_map.contains(key))
+                total += flat_map[key];
+
+        return total;
+    };
+
+    BENCHMARK(std::format("SortedFlatMap small lookup {}", count)) {
+        double total = 0.0;
+
+        for (int key : lookup_keys)
+            if (auto it = sorted_flat_map.find(key); it != sorted_flat_map.end())
+                total += it->second;
+
+        return total;
+    };
+
+    BENCHMARK(std::format("SmallFlatMap small lookup {}", count)) {
+        double total = 0.0;
+
+        for (int key : lookup_keys)
+            if (auto it = small_flat_map.find(key); it != small_flat_map.end())
+                total += it->second;
+
+        return total;
+    };
+}
@@ -0,0 +1,27 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+
+#include <filesystem>
+#include <format>
+
+#include "io/jpg.h"
+
+#include "bench_data.h"
+
+TEST_CASE("jpg io", "[bench][io]") {
+    auto resolution = GENERATE(from_range(cc::bench::k_Resolutions));
+    auto image      = cc::bench::make_gear_image(resolution);
+    auto path       = std::filesystem::temp_directory_path() / std::format("cc_bench_{}x{}.jpg", resolution.m_Width, resolution.m_Height);
+
+    BENCHMARK(std::format("save_jpg {}x{}", resolution.m_Width, resolution.m_Height)) {
+        cc::io::save_jpg(image, path);
+    };
+
+    BENCHMARK(std::format("load_jpg {}x{}", resolution.m_Width, resolution.m_Height)) {
+        return cc::io::load_jpg(path);
+    };
+
+    std::filesystem::remove(path);
+}
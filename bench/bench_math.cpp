@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cmath>
+#include <format>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "math/angles.h"
+#include "math/running_statistics.h"
+#include "math/statistics.h"
+
+using namespace cc::math;
+
+namespace {
+    std::vector<double> make_values(size_t count) {
+        std::default_random_engine             generator(123); // fixed seed for reproducibility
+        std::uniform_real_distribution<double> distribution(0.0, 2.0 * std::numbers::pi);
+
+        std::vector<double> values(count);
+
+        for (auto& value : values)
+            value = distribution(generator);
+
+        return values;
+    }
+
+    // the mean/variance/stddev chain this repo used before RunningStatistics, kept for comparison
+    double two_pass_variance(const std::vector<double>& values) {
+        const double mean = calculate_mean(values);
+
+        double sum_of_squares = 0.0;
+
+        for (double value : values)
+            sum_of_squares += (value - mean) * (value - mean);
+
+        return sum_of_squares / static_cast<double>(values.size());
+    }
+}
+
+TEST_CASE("statistics", "[bench][math]") {
+    auto count  = GENERATE(32, 1024, 16384);
+    auto values = make_values(count);
+
+    BENCHMARK(std::format("calculate_mean {}", count)) {
+        return calculate_mean(values);
+    };
+
+    BENCHMARK(std::format("calculate_variance {}", count)) {
+        return calculate_variance(values);
+    };
+
+    BENCHMARK(std::format("calculate_standard_deviation {}", count)) {
+        return calculate_standard_deviation(values);
+    };
+
+    // mean and stddev together, the way find_anomalies needs them
+    BENCHMARK(std::format("mean then stddev (three passes) {}", count)) {
+        return calculate_mean(values) + std::sqrt(two_pass_variance(values));
+    };
+
+    BENCHMARK(std::format("calculate_statistics {}", count)) {
+        auto stats = calculate_statistics(values);
+        return stats.get_mean() + stats.get_standard_deviation();
+    };
+}
+
+TEST_CASE("arc_length", "[bench][math]") {
+    auto values = make_values(1024);
+
+    BENCHMARK("arc_length x1024") {
+        double total = 0.0;
+
+        for (size_t i = 0; i + 1 < values.size(); i += 2)
+            total += arc_length(values[i], values[i + 1]);
+
+        return total;
+    };
+}
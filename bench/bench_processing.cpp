@@ -0,0 +1,243 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+#include "processing/anomalies.h"
+#include "processing/contours.h"
+#include "processing/count_teeth.h"
+#include "processing/foreground.h"
+#include "processing/polar_signature.h"
+#include "processing/radial_analysis.h"
+#include "types/color_range.h"
+
+#include "bench_data.h"
+
+using namespace cc;
+using namespace cc::processing;
+
+namespace {
+    // the intermediate results of process_contours for a single gear contour, so that
+    // the individual steps can be measured in isolation
+    struct RadialProfile {
+        std::vector<cv::Point> m_Contour;
+        cv::Point2f            m_Centroid;
+        std::vector<double>    m_Distances;
+        std::vector<uint8_t>   m_ToothMask;
+    };
+
+    RadialProfile make_radial_profile(size_t num_points, int num_teeth = bench::k_NumTeeth) {
+        RadialProfile result;
+
+        result.m_Contour  = bench::make_gear_contour(num_points, num_teeth);
+        result.m_Centroid = { 500.0f, 500.0f };
+
+        for (const auto& pt : result.m_Contour)
+            result.m_Distances.push_back(std::hypot(pt.x - result.m_Centroid.x, pt.y - result.m_Centroid.y));
+
+        auto [min_distance, max_distance] = std::minmax_element(result.m_Distances.begin(), result.m_Distances.end());
+        double threshold = (*min_distance + *max_distance) / 2.0;
+
+        for (double distance : result.m_Distances)
+            result.m_ToothMask.push_back((distance < threshold) ? 1 : 0);
+
+        return result;
+    }
+}
+
+TEST_CASE("determine_color_range", "[bench][processing]") {
+    const auto gear_color = synthetic::GearSpec{}.m_GearColor;
+
+    BENCHMARK("determine_color_range") {
+        return determine_color_range(gear_color, bench::k_GearTolerance);
+    };
+}
+
+TEST_CASE("determine_foreground", "[bench][processing]") {
+    auto resolution = GENERATE(from_range(bench::k_Resolutions));
+    auto image      = bench::make_gear_image(resolution);
+    auto gear_color = synthetic::GearSpec{}.m_GearColor;
+
+    cv::Mat foreground_mask;
+    cv::Mat foreground;
+
+    BENCHMARK(std::format("determine_foreground {}x{}", resolution.m_Width, resolution.m_Height)) {
+        determine_foreground(gear_color, bench::k_GearTolerance, image, foreground_mask, foreground);
+        return foreground.data;
+    };
+
+    BENCHMARK(std::format("determine_foreground_light {}x{}", resolution.m_Width, resolution.m_Height)) {
+        determine_foreground_light(gear_color, bench::k_GearTolerance, image, foreground_mask, foreground);
+        return foreground.data;
+    };
+}
+
+TEST_CASE("process_contours", "[bench][processing]") {
+    auto num_points = GENERATE(from_range(bench::k_ContourLengths));
+
+    std::vector<std::vector<cv::Point>> contours  = { bench::make_gear_contour(num_points) };
+    std::vector<cv::Vec4i>              hierarchy = { { -1, -1, -1, -1 } };
+
+    const cv::Mat source_image(1000, 1000, CV_8UC3, cv::Scalar::all(0));
+    cv::Mat       output_image = source_image.clone();
+
+    BENCHMARK(std::format("process_contours {} points", num_points)) {
+        return process_contours(contours, hierarchy, output_image);
+    };
+
+    BENCHMARK(std::format("process_contours_smoothed {} points", num_points)) {
+        return process_contours_smoothed(contours, hierarchy, output_image);
+    };
+
+    BENCHMARK(std::format("process_contours_subpixel {} points", num_points)) {
+        return process_contours_subpixel(contours, hierarchy, source_image, output_image);
+    };
+
+    BENCHMARK(std::format("process_contours_fused {} points", num_points)) {
+        return process_contours_fused(contours, hierarchy, output_image);
+    };
+
+    BENCHMARK(std::format("process_contours_polar {} points", num_points)) {
+        return process_contours_polar(contours, hierarchy, output_image);
+    };
+}
+
+// tracing the contour and resampling it, versus sampling the polar signature straight from the mask
+TEST_CASE("process_mask", "[bench][processing]") {
+    auto resolution = GENERATE(from_range(bench::k_Resolutions));
+    auto image      = bench::make_gear_image(resolution);
+    auto gear_color = synthetic::GearSpec{}.m_GearColor;
+
+    cv::Mat foreground_mask;
+    cv::Mat foreground;
+
+    determine_foreground_buffered(gear_color, bench::k_GearTolerance, image, foreground_mask, foreground);
+
+    cv::Mat output_image = image.clone();
+
+    BENCHMARK(std::format("findContours + process_contours_polar {}x{}", resolution.m_Width, resolution.m_Height)) {
+        std::vector<std::vector<cv::Point>> contours;
+        std::vector<cv::Vec4i>              hierarchy;
+
+        cv::findContours(foreground_mask, contours, hierarchy, cv::RETR_CCOMP, cv::CHAIN_APPROX_SIMPLE);
+
+        return process_contours_polar(contours, hierarchy, output_image);
+    };
+
+    BENCHMARK(std::format("process_mask_polar {}x{}", resolution.m_Width, resolution.m_Height)) {
+        return process_mask_polar(foreground_mask, output_image);
+    };
+
+    const cv::Point2f center(
+        static_cast<float>(resolution.m_Width)  / 2.0f,
+        static_cast<float>(resolution.m_Height) / 2.0f
+    );
+
+    const float outer_radius = static_cast<float>(std::min(resolution.m_Width, resolution.m_Height)) / 2.0f;
+
+    PolarSignature signature;
+
+    BENCHMARK(std::format("sample_polar {}x{}", resolution.m_Width, resolution.m_Height)) {
+        return sample_polar(foreground_mask, center, outer_radius, signature);
+    };
+}
+
+// distances, tooth mask, find_tooth_start and count_teeth, versus the fused passes
+TEST_CASE("measure_teeth", "[bench][processing]") {
+    auto num_points = GENERATE(from_range(bench::k_ContourLengths));
+    auto contour    = bench::make_gear_contour(num_points);
+
+    const cv::Point2i centroid_i = { 500, 500 };
+    const cv::Point2f centroid_f = { 500.0f, 500.0f };
+
+    BENCHMARK(std::format("measure_teeth separate passes {} points", num_points)) {
+        std::vector<double> distances;
+
+        for (const auto& pt : contour)
+            distances.push_back(std::hypot(pt.x - centroid_i.x, pt.y - centroid_i.y));
+
+        auto [min_distance, max_distance] = std::minmax_element(distances.begin(), distances.end());
+        double threshold = (*min_distance + *max_distance) / 2.0;
+
+        std::vector<uint8_t> tooth_mask(contour.size(), 0);
+
+        for (size_t i = 0; i < contour.size(); ++i)
+            tooth_mask[i] = (distances[i] < threshold) ? 1 : 0;
+
+        return count_teeth(*find_tooth_start(tooth_mask), tooth_mask, contour, distances, centroid_f);
+    };
+
+    BENCHMARK(std::format("measure_teeth_fused {} points", num_points)) {
+        return measure_teeth_fused(contour, centroid_i, centroid_f);
+    };
+
+    PolarSignature signature;
+
+    BENCHMARK(std::format("resample_polar {} points", num_points)) {
+        return resample_polar(contour, centroid_f, signature);
+    };
+
+    // the same amount of work for every contour length
+    resample_polar(contour, centroid_f, signature);
+
+    BENCHMARK(std::format("measure_teeth_polar {} points", num_points)) {
+        return measure_teeth_polar(signature);
+    };
+}
+
+TEST_CASE("find_tooth_start", "[bench][processing]") {
+    auto num_points = GENERATE(from_range(bench::k_ContourLengths));
+    auto profile    = make_radial_profile(num_points);
+
+    BENCHMARK(std::format("find_tooth_start {} points", num_points)) {
+        return find_tooth_start(profile.m_ToothMask);
+    };
+}
+
+TEST_CASE("count_teeth", "[bench][processing]") {
+    auto num_points  = GENERATE(from_range(bench::k_ContourLengths));
+    auto profile     = make_radial_profile(num_points);
+    auto first_tooth = find_tooth_start(profile.m_ToothMask);
+
+    REQUIRE(first_tooth.has_value());
+
+    BENCHMARK(std::format("count_teeth {} points", num_points)) {
+        return count_teeth(
+            *first_tooth,
+            profile.m_ToothMask,
+            profile.m_Contour,
+            profile.m_Distances,
+            profile.m_Centroid
+        );
+    };
+}
+
+TEST_CASE("find_anomalies", "[bench][processing]") {
+    auto num_teeth = GENERATE(8, 32, 128);
+    auto profile   = make_radial_profile(static_cast<size_t>(num_teeth) * 64, num_teeth);
+    auto teeth     = count_teeth(
+        *find_tooth_start(profile.m_ToothMask),
+        profile.m_ToothMask,
+        profile.m_Contour,
+        profile.m_Distances,
+        profile.m_Centroid
+    );
+
+    BENCHMARK(std::format("find_anomalies {} teeth", teeth.size())) {
+        return find_anomalies(teeth);
+    };
+
+    // reused between frames, like in the FrameProcessor
+    AnomalyScorer                  scorer;
+    std::vector<ToothAnomalyScore> scores;
+    std::vector<uint8_t>           mask;
+
+    BENCHMARK(std::format("AnomalyScorer::score {} teeth", teeth.size())) {
+        scorer.score(teeth, scores, mask);
+        return mask.data();
+    };
+}
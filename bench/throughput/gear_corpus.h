@@ -0,0 +1,64 @@
+#ifndef CC_BENCH_THROUGHPUT_GEAR_CORPUS_H
+#define CC_BENCH_THROUGHPUT_GEAR_CORPUS_H
+
+#include <array>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "synthetic/gear_generator.h"
+
+// The gears that the throughput runner measures and the engine tests compare, so both cover the same inputs
+
+namespace cc::bench {
+    struct Recording {
+        const char* m_Filename;  // in data/
+        cv::Scalar  m_Color;     // BGR
+        int         m_Tolerance; // selects the gear, and not the background
+    };
+
+    // the data/ images with a blue gear; the others have no segmentation that yields a gear -- an orange gear of
+    // which only the lit top face is selected, and brass gears on wood that are too close in color to separate
+    inline const std::array<Recording, 3> k_Recordings = {{
+        { "test_broken_tooth_001.jpg", {  69,  22,   3 }, 60 },
+        { "test_broken_tooth_002.jpg", {  79,  30,   7 }, 60 },
+        { "test_gear_003.jpg",         { 131,  56,   2 }, 60 }
+    }};
+
+    inline constexpr int k_GeneratedTolerance = 40; // around synthetic::GearSpec::m_GearColor
+
+    // a plain gear; noise and blur; missing and broken teeth between clutter; an eccentric, rotated gear; and a 4K
+    // gear with many teeth. The reference engine finds every intact tooth of each; a gear with small teeth can only
+    // be slightly eccentric, or the threshold no longer cuts through the teeth where the radius is largest and smallest
+    [[nodiscard]] inline std::vector<synthetic::GearSpec> make_generated_specs() {
+        std::vector<synthetic::GearSpec> result(5);
+
+        result[0].m_Resolution   = {  640,  480 };
+        result[0].m_NumTeeth     = 24;
+
+        result[1].m_Resolution   = { 1280,  720 };
+        result[1].m_NumTeeth     = 48;
+        result[1].m_NoiseSigma   = 6.0;
+        result[1].m_BlurRadius   = 1;
+
+        result[2].m_Resolution   = { 1920, 1080 };
+        result[2].m_NumTeeth     = 96;
+        result[2].m_MissingTeeth = { 10 };
+        result[2].m_BrokenTeeth  = { 50 };
+        result[2].m_NumClutter   = 20;
+
+        result[3].m_Resolution   = { 1280,  720 };
+        result[3].m_NumTeeth     = 12;
+        result[3].m_Eccentricity = 0.3;
+        result[3].m_Rotation     = 0.4;
+
+        result[4].m_Resolution   = { 3840, 2160 };
+        result[4].m_NumTeeth     = 200;
+        result[4].m_Eccentricity = 0.05;
+        result[4].m_NoiseSigma   = 4.0;
+
+        return result;
+    }
+}
+
+#endif
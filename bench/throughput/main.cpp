@@ -0,0 +1,281 @@
+// End-to-end throughput of the frame processing pipeline, over a corpus of the data/ recordings plus generated gears
+// (see gear_corpus.h)
+//
+// usage: CountVonCountThroughput [options]
+//     --duration <seconds>    how long to keep processing frames (default 10)
+//     --output <file.json>    where to write the metrics (default throughput.json)
+//     --baseline <file.json>  compare against an earlier run; exits with 1 when a metric regressed
+//     --threshold <percent>   allowed regression relative to the baseline (default 15)
+//     --corpus <all|data|synthetic>
+//     --engine <name>         processing engine to measure (default reference)
+//
+// The latency histograms have a resolution of 12.5%, so percentile comparisons below that are noise.
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "app/frame_processor.h"
+#include "app/frame_stats.h"
+#include "io/data_location.h"
+#include "io/jpg.h"
+#include "processing/engine.h"
+#include "synthetic/gear_generator.h"
+#include "util/allocation_tracker.h"
+#include "util/memory_usage.h"
+
+#include "gear_corpus.h"
+#include "throughput_report.h"
+
+namespace {
+    using cc::app::FrameStats;
+    using cc::bench::Metrics;
+
+    namespace fs = std::filesystem;
+
+    struct Options {
+        double      m_Duration     = 10.0;
+        fs::path    m_Output       = "throughput.json";
+        fs::path    m_Baseline;
+        double      m_Threshold    = 15.0; // percent
+        bool        m_UseData      = true;
+        bool        m_UseSynthetic = true;
+        std::string m_Engine       = "reference";
+    };
+
+    struct CorpusItem {
+        std::string m_Name;
+        cv::Mat     m_Image;
+        cv::Scalar  m_Color;
+        int         m_Tolerance;
+    };
+
+    Options parse_options(int argc, char* argv[]) {
+        Options result;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+
+            if (i + 1 >= argc)
+                throw std::runtime_error(std::format("Missing value for {}", arg));
+
+            std::string value = argv[++i];
+
+            if      (arg == "--duration")  result.m_Duration  = std::stod(value);
+            else if (arg == "--output")    result.m_Output    = value;
+            else if (arg == "--baseline")  result.m_Baseline  = value;
+            else if (arg == "--threshold") result.m_Threshold = std::stod(value);
+            else if (arg == "--engine")    result.m_Engine    = value;
+            else if (arg == "--corpus") {
+                result.m_UseData      = (value == "all" || value == "data");
+                result.m_UseSynthetic = (value == "all" || value == "synthetic");
+            }
+            else
+                throw std::runtime_error(std::format("Unknown option {}", arg));
+        }
+
+        return result;
+    }
+
+    std::vector<CorpusItem> make_corpus(const Options& options, const fs::path& exe_path) {
+        using namespace cc::bench;
+        using namespace cc::synthetic;
+
+        std::vector<CorpusItem> result;
+
+        if (options.m_UseData) {
+            auto data_path = cc::find_data_folder(exe_path);
+
+            for (const auto& recording : k_Recordings)
+                result.push_back(CorpusItem {
+                    .m_Name      = recording.m_Filename,
+                    .m_Image     = cc::io::load_jpg(data_path / recording.m_Filename),
+                    .m_Color     = recording.m_Color,
+                    .m_Tolerance = recording.m_Tolerance
+                });
+        }
+
+        if (options.m_UseSynthetic) {
+            for (const auto& spec : make_generated_specs())
+                result.push_back(CorpusItem {
+                    .m_Name      = std::format("synthetic_{}x{}_{}", spec.m_Resolution.m_Width, spec.m_Resolution.m_Height, spec.m_NumTeeth),
+                    .m_Image     = generate_gear(spec).m_Image,
+                    .m_Color     = spec.m_GearColor,
+                    .m_Tolerance = k_GeneratedTolerance
+                });
+        }
+
+        return result;
+    }
+
+    Metrics run(
+        const std::vector<CorpusItem>& corpus,
+        const cc::processing::Engine&  engine,
+              double                   duration_seconds
+    ) {
+        using e_Stage = FrameStats::e_Stage;
+        using Clock   = FrameStats::Clock;
+
+        FrameStats                stats;
+        cc::app::FrameProcessor   processor(stats);
+        cc::util::AllocationStats frame_allocations;
+
+        processor.set_engine(engine);
+
+        cv::Mat source_image;
+        cv::Mat output_image;
+
+        auto process = [&](const CorpusItem& item) {
+            {
+                auto measurement = stats.measure(e_Stage::capture);
+                source_image = item.m_Image.clone();
+            }
+
+            output_image = source_image.clone();
+
+            return processor.process(item.m_Color, item.m_Tolerance, source_image, output_image);
+        };
+
+        // warm up caches and buffers with one pass over the corpus, then start measuring; an image without a gear
+        // would only measure the early exit of the pipeline
+        for (const auto& item : corpus)
+            if (!process(item))
+                throw std::runtime_error(std::format("No gear found in {}", item.m_Name));
+
+        for (size_t i = 0; i < FrameStats::k_NumStages; ++i)
+            stats.get_histogram(static_cast<e_Stage>(i)).reset();
+
+        // the allocations of the warmup pass are in the per-stage totals as well; remember where we started
+        std::array<cc::util::AllocationStats, FrameStats::k_NumStages> warmup_allocations;
+
+        for (size_t i = 0; i < FrameStats::k_NumStages; ++i)
+            warmup_allocations[i] = stats.get_allocations(static_cast<e_Stage>(i));
+
+        const auto start    = Clock::now();
+        const auto deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration_seconds));
+
+        size_t num_frames = 0;
+        auto   now        = start;
+
+        while (now < deadline) {
+            const auto& item = corpus[num_frames % corpus.size()];
+
+            cc::util::AllocationProbe probe;
+
+            process(item);
+
+            frame_allocations += probe.get();
+
+            auto frame_end = Clock::now();
+            stats.record(e_Stage::total, frame_end - now);
+
+            now = frame_end;
+            ++num_frames;
+        }
+
+        const double elapsed = std::chrono::duration<double>(now - start).count();
+
+        Metrics result;
+
+        result["duration_s"]     = elapsed;
+        result["frames"]         = static_cast<double>(num_frames);
+        result["fps"]            = static_cast<double>(num_frames) / elapsed;
+        result["peak_rss_bytes"] = static_cast<double>(cc::util::get_peak_rss());
+
+        auto to_us = [](FrameStats::Duration d) {
+            return std::chrono::duration<double, std::micro>(d).count();
+        };
+
+        for (size_t i = 0; i < FrameStats::k_NumStages; ++i) {
+            auto stage    = static_cast<e_Stage>(i);
+            auto snapshot = stats.get_histogram(stage).snapshot();
+
+            if (snapshot.m_Count == 0)
+                continue;
+
+            std::string prefix = FrameStats::to_string(stage);
+
+            result[prefix + ".count"]   = static_cast<double>(snapshot.m_Count);
+            result[prefix + ".mean_us"] = to_us(snapshot.mean());
+            result[prefix + ".p50_us"]  = to_us(snapshot.percentile(50.0));
+            result[prefix + ".p90_us"]  = to_us(snapshot.percentile(90.0));
+            result[prefix + ".p99_us"]  = to_us(snapshot.percentile(99.0));
+            result[prefix + ".max_us"]  = to_us(snapshot.max());
+
+            if constexpr (cc::util::is_allocation_tracking_enabled()) {
+                auto allocations = (stage == e_Stage::total) ?
+                    frame_allocations :
+                    stats.get_allocations(stage) - warmup_allocations[i];
+
+                result[prefix + ".allocs_per_call"] =
+                    static_cast<double>(allocations.m_NumAllocations) / static_cast<double>(snapshot.m_Count);
+            }
+        }
+
+        return result;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        auto options = parse_options(argc, argv);
+        auto corpus  = make_corpus(options, fs::path(argv[0]));
+        auto engine  = cc::processing::find_engine(options.m_Engine);
+
+        if (!engine) {
+            std::cerr << std::format("Unknown engine {}\n", options.m_Engine);
+            return -1;
+        }
+
+        if (corpus.empty()) {
+            std::cerr << "Empty corpus\n";
+            return -1;
+        }
+
+        std::cout << std::format("Processing {} images for {} seconds with the {} engine\n", corpus.size(), options.m_Duration, engine->m_Name);
+
+        auto metrics = run(corpus, *engine, options.m_Duration);
+
+        cc::bench::write_metrics(std::cout, metrics);
+        cc::bench::save_metrics(options.m_Output, metrics);
+
+        if (options.m_Baseline.empty())
+            return 0;
+
+        auto baseline = cc::bench::load_metrics(options.m_Baseline);
+
+        if (!baseline) {
+            std::cerr << std::format("Cannot read baseline {}\n", options.m_Baseline.string());
+            return -1;
+        }
+
+        auto regressions = cc::bench::find_regressions(*baseline, metrics, options.m_Threshold / 100.0);
+
+        for (const auto& regression : regressions)
+            std::cout << std::format(
+                "REGRESSION {:<32} baseline {:12.2f}  current {:12.2f}  ({:+.1f}%)\n",
+                regression.m_Metric,
+                regression.m_Baseline,
+                regression.m_Current,
+                regression.m_Change * 100.0
+            );
+
+        if (!regressions.empty())
+            return 1;
+
+        std::cout << std::format("No regressions beyond {}% of the baseline\n", options.m_Threshold);
+    }
+    catch (std::exception& ex) {
+        std::cerr << "Exception: " << ex.what() << '\n';
+        return -1;
+    }
+
+    return 0;
+}
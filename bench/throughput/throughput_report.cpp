@@ -0,0 +1,191 @@
+#include "throughput_report.h"
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+    // minimal scanner for the flat { "name": number, ... } objects written by write_metrics
+    class MetricsParser {
+    public:
+        explicit MetricsParser(std::string text):
+            m_Text(std::move(text))
+        {
+        }
+
+        std::optional<cc::bench::Metrics> parse() {
+            cc::bench::Metrics result;
+
+            if (!expect('{'))
+                return std::nullopt;
+
+            if (peek() == '}')
+                return result;
+
+            while (true) {
+                auto name = parse_string();
+                if (!name || !expect(':'))
+                    return std::nullopt;
+
+                auto value = parse_number();
+                if (!value)
+                    return std::nullopt;
+
+                result[*name] = *value;
+
+                if (expect(','))
+                    continue;
+
+                if (expect('}'))
+                    return result;
+
+                return std::nullopt;
+            }
+        }
+
+    private:
+        void skip_whitespace() {
+            while (m_Pos < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Pos])))
+                ++m_Pos;
+        }
+
+        char peek() {
+            skip_whitespace();
+            return (m_Pos < m_Text.size()) ? m_Text[m_Pos] : '\0';
+        }
+
+        bool expect(char c) {
+            if (peek() != c)
+                return false;
+
+            ++m_Pos;
+            return true;
+        }
+
+        std::optional<std::string> parse_string() {
+            if (!expect('"'))
+                return std::nullopt;
+
+            auto end = m_Text.find('"', m_Pos); // metric names don't contain escapes
+            if (end == std::string::npos)
+                return std::nullopt;
+
+            std::string result = m_Text.substr(m_Pos, end - m_Pos);
+            m_Pos = end + 1;
+
+            return result;
+        }
+
+        std::optional<double> parse_number() {
+            skip_whitespace();
+
+            double value = 0.0;
+            auto [ptr, ec] = std::from_chars(m_Text.data() + m_Pos, m_Text.data() + m_Text.size(), value);
+
+            if (ec != std::errc())
+                return std::nullopt;
+
+            m_Pos = static_cast<size_t>(ptr - m_Text.data());
+            return value;
+        }
+
+        std::string m_Text;
+        size_t      m_Pos = 0;
+    };
+}
+
+namespace cc::bench {
+    void write_metrics(std::ostream& os, const Metrics& metrics) {
+        os << "{\n";
+
+        size_t i = 0;
+        for (const auto& [name, value] : metrics) {
+            os << std::format("    \"{}\": {}", name, value);
+            os << ((++i < metrics.size()) ? ",\n" : "\n");
+        }
+
+        os << "}\n";
+    }
+
+    std::optional<Metrics> read_metrics(std::istream& is) {
+        std::string text(
+            (std::istreambuf_iterator<char>(is)),
+             std::istreambuf_iterator<char>()
+        );
+
+        return MetricsParser(std::move(text)).parse();
+    }
+
+    void save_metrics(const std::filesystem::path& p, const Metrics& metrics) {
+        std::ofstream out(p);
+
+        if (!out)
+            throw std::runtime_error(std::format("Cannot write {}", p.string()));
+
+        write_metrics(out, metrics);
+    }
+
+    std::optional<Metrics> load_metrics(const std::filesystem::path& p) {
+        std::ifstream in(p);
+
+        if (!in)
+            return std::nullopt;
+
+        return read_metrics(in);
+    }
+
+    bool is_compared(const std::string& metric) {
+        return
+            metric == "fps"              ||
+            metric == "peak_rss_bytes"   ||
+            metric.ends_with(".mean_us") ||
+            metric.ends_with(".p99_us")  ||
+            metric.ends_with(".allocs_per_call");
+    }
+
+    bool is_higher_better(const std::string& metric) {
+        return metric == "fps";
+    }
+
+    std::vector<Regression> find_regressions(
+        const Metrics& baseline,
+        const Metrics& current,
+        double         threshold
+    ) {
+        std::vector<Regression> result;
+
+        for (const auto& [name, baseline_value] : baseline) {
+            auto it = current.find(name);
+
+            if (it == current.end() || !is_compared(name))
+                continue;
+
+            double current_value = it->second;
+            double change        = 0.0;
+
+            if (baseline_value != 0.0)
+                change = (current_value - baseline_value) / std::abs(baseline_value);
+            else if (current_value != 0.0)
+                change = std::numeric_limits<double>::infinity(); // e.g. a stage that used to not allocate
+
+            if (is_higher_better(name))
+                change = -change;
+
+            if (change > threshold)
+                result.push_back(Regression {
+                    .m_Metric   = name,
+                    .m_Baseline = baseline_value,
+                    .m_Current  = current_value,
+                    .m_Change   = change
+                });
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef CC_BENCH_THROUGHPUT_REPORT_H
+#define CC_BENCH_THROUGHPUT_REPORT_H
+
+#include <filesystem>
+#include <iosfwd>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cc::bench {
+    // metric name -> value, e.g. "fps" or "foreground.p99_us"; stored as a flat JSON object
+    using Metrics = std::map<std::string, double>;
+
+    struct Regression {
+        std::string m_Metric;
+        double      m_Baseline;
+        double      m_Current;
+        double      m_Change; // relative; positive is worse
+    };
+
+    void                   write_metrics(std::ostream& os, const Metrics& metrics);
+    std::optional<Metrics> read_metrics (std::istream& is); // nullopt when malformed
+
+    void                   save_metrics(const std::filesystem::path& p, const Metrics& metrics);
+    std::optional<Metrics> load_metrics(const std::filesystem::path& p);
+
+    // is the metric compared against the baseline, and is a higher value better?
+    [[nodiscard]] bool is_compared     (const std::string& metric);
+    [[nodiscard]] bool is_higher_better(const std::string& metric);
+
+    // metrics that are present in both and got worse by more than the threshold (0.1 = 10%)
+    [[nodiscard]] std::vector<Regression> find_regressions(
+        const Metrics& baseline,
+        const Metrics& current,
+        double         threshold
+    );
+}
+
+#endif
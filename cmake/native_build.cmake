@@ -8,6 +8,8 @@ find_package(Catch2 3 REQUIRED)
 add_executable(CountVonCount)       # main executable
 add_library   (CountVonCountLib)    # project code as a static library
 add_executable(CountVonCountTests)  # unit tests
+add_executable(CountVonCountBench)  # microbenchmarks
+add_executable(CountVonCountThroughput) # end-to-end throughput runner
 
 # while this is not particularly encouraged, it saves me from reloading CMakeLists all the time
 # and as such this is a kind of experiment for me to see if this causes any issues
@@ -29,6 +31,19 @@ file(GLOB_RECURSE CountUnitTestSources CONFIGURE_DEPENDS
         "${CMAKE_CURRENT_SOURCE_DIR}/tests/*.inl"
 )
 
+file(GLOB_RECURSE CountBenchSources CONFIGURE_DEPENDS
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench/*.cpp"
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench/*.h"
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench/*.inl"
+)
+
+# the throughput runner has its own entrypoint
+file(GLOB_RECURSE CountThroughputSources CONFIGURE_DEPENDS
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench/throughput/*.cpp"
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench/throughput/*.h"
+)
+list(REMOVE_ITEM CountBenchSources ${CountThroughputSources})
+
 # ----------- Main executable -------------
 target_sources            (CountVonCount PRIVATE "${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp")
 target_include_directories(CountVonCount PRIVATE
@@ -55,10 +70,14 @@ target_link_directories   (CountVonCountLib PRIVATE
 )
 
 # ----------- Test code --------------------
-target_sources            (CountVonCountTests PRIVATE ${CountUnitTestSources})
+# the baseline comparison of the throughput runner is tested as well
+target_sources            (CountVonCountTests PRIVATE ${CountUnitTestSources}
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench/throughput/throughput_report.cpp"
+)
 target_include_directories(CountVonCountTests PRIVATE
         "${CMAKE_CURRENT_SOURCE_DIR}/src"
         "${CMAKE_CURRENT_SOURCE_DIR}/tests"
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench/throughput"
         ${OpenCV_INCLUDE_DIRS}
         ${Stb_INCLUDE_DIR}
 )
@@ -71,10 +90,105 @@ target_link_directories   (CountVonCountTests PRIVATE
         ${OpenCV_LIB_DIR}
 )
 
+# ----------- Benchmarks -------------------
+# Catch2 benchmarks, not part of the ctest run; use a reporter for machine-readable results, e.g.
+#   CountVonCountBench --reporter JSON::out=bench.json
+#   CountVonCountBench "[processing]" --benchmark-samples 50 --reporter XML::out=bench.xml
+target_sources            (CountVonCountBench PRIVATE ${CountBenchSources})
+target_include_directories(CountVonCountBench PRIVATE
+        "${CMAKE_CURRENT_SOURCE_DIR}/src"
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench"
+        ${OpenCV_INCLUDE_DIRS}
+        ${Stb_INCLUDE_DIR}
+)
+target_link_libraries     (CountVonCountBench PRIVATE
+        ${OpenCV_LIBS}
+        Catch2::Catch2WithMain
+        CountVonCountLib
+)
+target_link_directories   (CountVonCountBench PRIVATE
+        ${OpenCV_LIB_DIR}
+)
+
+# ----------- Throughput -------------------
+# runs the complete frame pipeline over the data/ images plus generated gears for a fixed duration, e.g.
+#   CountVonCountThroughput --duration 30 --output current.json --baseline baseline.json --threshold 10
+# exits with 1 when a metric regressed beyond the threshold
+# compare processing engines by using the reference run as the baseline for another engine:
+#   CountVonCountThroughput --engine buffered --baseline reference.json
+target_sources            (CountVonCountThroughput PRIVATE ${CountThroughputSources})
+target_include_directories(CountVonCountThroughput PRIVATE
+        "${CMAKE_CURRENT_SOURCE_DIR}/src"
+        "${CMAKE_CURRENT_SOURCE_DIR}/bench/throughput"
+        ${OpenCV_INCLUDE_DIRS}
+        ${Stb_INCLUDE_DIR}
+)
+target_link_libraries     (CountVonCountThroughput PRIVATE
+        ${OpenCV_LIBS}
+        CountVonCountLib
+)
+target_link_directories   (CountVonCountThroughput PRIVATE
+        ${OpenCV_LIB_DIR}
+)
+
+# ----------- Logging ----------------------
+# compile-time minimum log level (0=debug, 1=info, 2=warning, 3=error, 4=off); calls below it are removed
+# when left empty, debug builds keep everything and release builds (NDEBUG) drop LOG_DEBUG
+set(CC_LOG_MIN_LEVEL "" CACHE STRING "Compile-time minimum log level (0=debug .. 4=off)")
+
+if (NOT CC_LOG_MIN_LEVEL STREQUAL "")
+    target_compile_definitions(CountVonCount      PRIVATE CC_LOG_MIN_LEVEL=${CC_LOG_MIN_LEVEL})
+    target_compile_definitions(CountVonCountLib   PRIVATE CC_LOG_MIN_LEVEL=${CC_LOG_MIN_LEVEL})
+    target_compile_definitions(CountVonCountTests PRIVATE CC_LOG_MIN_LEVEL=${CC_LOG_MIN_LEVEL})
+    target_compile_definitions(CountVonCountBench PRIVATE CC_LOG_MIN_LEVEL=${CC_LOG_MIN_LEVEL})
+    target_compile_definitions(CountVonCountThroughput PRIVATE CC_LOG_MIN_LEVEL=${CC_LOG_MIN_LEVEL})
+endif()
+
+# ----------- Tracing ----------------------
+# CC_TRACE_SCOPE instrumentation; when disabled the macros compile to nothing
+option(CC_ENABLE_TRACING "Enable scoped trace instrumentation (Chrome trace JSON export)" OFF)
+
+if (CC_ENABLE_TRACING)
+    target_compile_definitions(CountVonCount      PRIVATE CC_ENABLE_TRACING)
+    target_compile_definitions(CountVonCountLib   PRIVATE CC_ENABLE_TRACING)
+    target_compile_definitions(CountVonCountTests PRIVATE CC_ENABLE_TRACING)
+    target_compile_definitions(CountVonCountBench PRIVATE CC_ENABLE_TRACING)
+    target_compile_definitions(CountVonCountThroughput PRIVATE CC_ENABLE_TRACING)
+endif()
+
+# ----------- Allocation tracking ----------
+# replaces the global operator new/delete to count heap allocations per thread (see util/allocation_tracker.h)
+# NOTE this does not combine well with AddressSanitizer, which provides its own replacement
+option(CC_ENABLE_ALLOCATION_TRACKING "Count heap allocations per pipeline stage" OFF)
+
+if (CC_ENABLE_ALLOCATION_TRACKING)
+    target_compile_definitions(CountVonCount      PRIVATE CC_ENABLE_ALLOCATION_TRACKING)
+    target_compile_definitions(CountVonCountLib   PRIVATE CC_ENABLE_ALLOCATION_TRACKING)
+    target_compile_definitions(CountVonCountTests PRIVATE CC_ENABLE_ALLOCATION_TRACKING)
+    target_compile_definitions(CountVonCountBench PRIVATE CC_ENABLE_ALLOCATION_TRACKING)
+    target_compile_definitions(CountVonCountThroughput PRIVATE CC_ENABLE_ALLOCATION_TRACKING)
+endif()
+
+# ----------- Hardware counters ------------
+# per-stage cycles, instructions, cache and branch misses via perf_event_open (Linux only)
+# falls back to latency-only statistics when the counters cannot be opened, e.g. in VMs or with
+# a restrictive kernel.perf_event_paranoid
+option(CC_ENABLE_PERF_COUNTERS "Sample hardware performance counters per pipeline stage" OFF)
+
+if (CC_ENABLE_PERF_COUNTERS)
+    target_compile_definitions(CountVonCount      PRIVATE CC_ENABLE_PERF_COUNTERS)
+    target_compile_definitions(CountVonCountLib   PRIVATE CC_ENABLE_PERF_COUNTERS)
+    target_compile_definitions(CountVonCountTests PRIVATE CC_ENABLE_PERF_COUNTERS)
+    target_compile_definitions(CountVonCountBench PRIVATE CC_ENABLE_PERF_COUNTERS)
+    target_compile_definitions(CountVonCountThroughput PRIVATE CC_ENABLE_PERF_COUNTERS)
+endif()
+
 
 if (MSVC)
     target_compile_definitions(CountVonCountLib   PRIVATE _CRT_SECURE_NO_WARNINGS)
     target_compile_definitions(CountVonCountTests PRIVATE _CRT_SECURE_NO_WARNINGS)
+    target_compile_definitions(CountVonCountBench PRIVATE _CRT_SECURE_NO_WARNINGS)
+    target_compile_definitions(CountVonCountThroughput PRIVATE _CRT_SECURE_NO_WARNINGS)
 
     target_compile_options(CountVonCountLib PRIVATE
             /W4     # Enable all warnings
@@ -88,6 +202,18 @@ if (MSVC)
             /MP     # Enable multi-processor compilation
     )
 
+    target_compile_options(CountVonCountBench PRIVATE
+            /W4     # Enable all warnings
+            /WX     # Warnings as errors
+            /MP     # Enable multi-processor compilation
+    )
+
+    target_compile_options(CountVonCountThroughput PRIVATE
+            /W4     # Enable all warnings
+            /WX     # Warnings as errors
+            /MP     # Enable multi-processor compilation
+    )
+
     # MSVC specific, this will avoid showing a console window upon startup
     # (side note, gcc for windows uses '-mwindows': https://gcc.gnu.org/onlinedocs/gcc-4.4.2/gcc/i386-and-x86_002d64-Windows-Options.html
     #target_link_options(CountVonCount PRIVATE /SUBSYSTEM:WINDOWS /entry:mainCRTStartup)
@@ -106,6 +232,20 @@ else()
             -Werror    # Warnings as errors
             -Wpedantic # Enable pedantic warnings
     )
+
+    target_compile_options(CountVonCountBench PRIVATE
+            -Wall      # Enable all warnings
+            -Wextra    # Enable extra warnings
+            -Werror    # Warnings as errors
+            -Wpedantic # Enable pedantic warnings
+    )
+
+    target_compile_options(CountVonCountThroughput PRIVATE
+            -Wall      # Enable all warnings
+            -Wextra    # Enable extra warnings
+            -Werror    # Warnings as errors
+            -Wpedantic # Enable pedantic warnings
+    )
 endif()
 
 enable_testing()
@@ -6,13 +6,10 @@
 #include "platform/platform.h"
 #include "platform/build_date.h"
 
-#include "processing/foreground.h"
-#include "processing/anomalies.h"
-#include "processing/contours.h"
-
 #include "gui/visualization.h"
 
 #include "util/logger.h"
+#include "util/trace.h"
 
 namespace {
     void save_image(const cv::Mat& img) {
@@ -32,6 +29,40 @@ namespace {
 
         LOG_INFO("Saved image to {}", timestamped_filename);
     }
+
+    // first call starts a capture, second call writes it to a timestamped file
+    void toggle_trace_capture() {
+#ifndef CC_ENABLE_TRACING
+        LOG_WARNING("Tracing is not enabled in this build (CC_ENABLE_TRACING)");
+#else
+        auto& tracer = cc::util::Tracer::instance();
+
+        if (!tracer.is_capturing()) {
+            tracer.start();
+            LOG_INFO("Started trace capture");
+            return;
+        }
+
+        tracer.stop();
+
+        auto timestamped_filename = std::format(
+            "trace_{0:%F}_{0:%OH%OM%OS}.json",
+            std::chrono::system_clock::now()
+        );
+
+        tracer.save_chrome_trace(timestamped_filename);
+
+        LOG_INFO("Saved {} trace events to {}", tracer.get_num_events(), timestamped_filename);
+#endif
+    }
+
+    // engines are stored contiguously, the reference engine first
+    const cc::processing::Engine& get_next_engine(const cc::processing::Engine& current) {
+        auto engines = cc::processing::get_engines();
+        auto idx     = static_cast<size_t>(&current - engines.data());
+
+        return engines[(idx + 1) % engines.size()];
+    }
 }
 
 namespace cc::app {
@@ -40,12 +71,34 @@ namespace cc::app {
     {
         m_DataPath = find_data_folder(exe_path);
 
+        m_LogBackend = std::make_unique<util::AsyncLogBackend>();
+        m_LogBackend->add_sink(std::make_unique<util::StdoutSink>());
+
+        util::Logger::instance().set_backend(m_LogBackend.get());
+
+        // a data folder that isn't writable shouldn't keep the application from starting
+        try {
+            m_LogBackend->add_sink(std::make_unique<util::FileSink>(m_DataPath / "count_count.log"));
+        }
+        catch (std::runtime_error& ex) {
+            LOG_WARNING("Logging to the console only: {}", ex.what());
+        }
+
         m_SettingsManager = std::make_unique<SettingsManager>(m_DataPath / "count_count.cfg");
         m_CameraManager   = std::make_unique<CameraManager>();
         m_UiController    = std::make_unique<MainWindowController>(m_SettingsManager.get());
+        m_FrameStats      = std::make_unique<FrameStats>(m_DataPath / "count_count_stats.csv");
+        m_FrameProcessor  = std::make_unique<FrameProcessor>(*m_FrameStats);
+    }
+
+    Application::~Application() {
+        // revert to synchronous logging; the backend writes whatever is still pending when destroyed
+        util::Logger::instance().set_backend(nullptr);
     }
 
     int Application::run() {
+        CC_TRACE_THREAD_NAME("main");
+
         print_startup_info();
         main_loop();
 
@@ -58,20 +111,6 @@ namespace cc::app {
         m_Running = false;
     }
 
-    void Application::initialize_buffers() {
-        if (
-            m_Foreground.empty() ||
-            m_Foreground.size() != m_SourceImage.size()
-        )
-            m_Foreground.create(m_SourceImage.size(), CV_8UC3);
-
-        if (
-            m_ForegroundMask.empty() ||
-            m_ForegroundMask.size() != m_SourceImage.size()
-        )
-            m_ForegroundMask.create(m_SourceImage.size(), CV_8UC1);
-    }
-
     void Application::main_loop() {
         cv::Mat static_image;
         cv::Mat output_image;
@@ -81,11 +120,18 @@ namespace cc::app {
 
         m_Running = true;
 
+        using e_Stage = FrameStats::e_Stage;
+
         while (m_Running) {
-            auto settings = m_SettingsManager->get(); // fetch settings once per frame
+            CC_TRACE_SCOPE("frame");
+
+            auto frame_start = FrameStats::Clock::now();
+            auto settings    = m_SettingsManager->get(); // fetch settings once per frame
 
             // ----- video input -----
             if (m_UseLiveVideo) {
+                auto measurement = m_FrameStats->measure(e_Stage::capture);
+
                 if (!m_CameraManager->is_initialized()) {
                     if (!m_CameraManager->set_resolution(settings.m_SourceResolution))
                         LOG_ERROR("Cannot set resolution to {}", settings.m_SourceResolution);
@@ -99,70 +145,43 @@ namespace cc::app {
 
                 m_SourceImage = m_CameraManager->grab_frame(); // live video
             }
-            else
+            else {
+                auto measurement = m_FrameStats->measure(e_Stage::capture);
                 m_SourceImage = static_image.clone(); // single image
+            }
 
             if (m_SourceImage.empty()) {
                 LOG_ERROR("Cannot retrieve image from webcam");
                 break;
             }
 
-            // if the other images haven't been initialized yet, do so now
-            initialize_buffers();
             output_image = m_SourceImage.clone();
 
             // ----- video processing -----
-            processing::determine_foreground(
+            m_FrameProcessor->process(
                 settings.m_ForegroundColor,
                 settings.m_ForegroundColorTolerance,
                 m_SourceImage,
-                m_ForegroundMask,
-                m_Foreground
+                output_image
             );
 
-            std::vector<std::vector<cv::Point>> contours;
-            std::vector<cv::Vec4i> hierarchy;
+            // ----- statistics -----
+            m_FrameStats->record(e_Stage::total, FrameStats::Clock::now() - frame_start);
+            m_FrameStats->on_frame();
 
-            // https://docs.opencv.org/3.4/d3/dc0/group__imgproc__shape.html#ga17ed9f5d79ae97bd4c7cf18403e1689a
-            cv::findContours(
-                m_ForegroundMask,
-                contours,
-                hierarchy,
-                cv::RETR_CCOMP, // organizes in a multi-level list, with external boundaries at the top level
-                cv::CHAIN_APPROX_SIMPLE
-            );
+            // ----- rendering -----
+            {
+                auto measurement = m_FrameStats->measure(e_Stage::rendering);
 
-            if (!contours.empty()) {
-                auto maybe_result = processing::process_contours(
-                    contours,
-                    hierarchy,
-                    output_image
-                );
-
-                if (maybe_result) {
-                    auto [teeth, centroid_i] = *maybe_result;
-
-                    // early exit -- if we have found less than 8 teeth, it's probably not a gear that we found
-                    if (teeth.size() >= k_MinimumToothCount) {
-                        auto tooth_anomaly_mask = processing::find_anomalies(teeth);
-
-                        // and display the result in-image at the center of the gear
-                        display_results(
-                            centroid_i,
-                            teeth,
-                            tooth_anomaly_mask,
-                            output_image
-                        );
-                    }
-                }
-            }
+                if (m_ShowStats)
+                    draw_stats_panel(m_FrameStats->get_summary(), output_image);
 
-            // ----- rendering -----
-            switch (m_Show) {
-                case e_ShowImage::processed_image: m_UiController->show(output_image); break;
-                case e_ShowImage::foreground:      m_UiController->show(m_Foreground); break;
-                default:
-                    break;
+                switch (m_Show) {
+                    case e_ShowImage::processed_image: m_UiController->show(output_image); break;
+                    case e_ShowImage::foreground:      m_UiController->show(m_FrameProcessor->get_foreground()); break;
+                    default:
+                        break;
+                }
             }
 
             // ----- key input handling -----
@@ -180,6 +199,29 @@ namespace cc::app {
                     save_image(m_SourceImage);
                     break;
 
+                case 's':
+                case 'S':
+                    m_ShowStats = !m_ShowStats;
+                    break;
+
+                case 't':
+                case 'T':
+                    toggle_trace_capture();
+                    break;
+
+                case 'e':
+                case 'E':
+                    m_FrameProcessor->set_engine(get_next_engine(m_FrameProcessor->get_engine()));
+                    LOG_INFO("Using the {} processing engine", m_FrameProcessor->get_engine().m_Name);
+                    break;
+
+                case 'b':
+                case 'B':
+                    // e.g. when switching to another part type
+                    m_FrameProcessor->reset_baseline();
+                    LOG_INFO("Anomaly baseline reset");
+                    break;
+
                 case 'l':
                 case 'L':
                     m_UseLiveVideo = !m_UseLiveVideo;
@@ -219,5 +261,6 @@ namespace cc::app {
         LOG_INFO("Data path:  {}",          m_DataPath.string());
 
         LOG_INFO("Selected resolution: {}", m_SettingsManager->get().m_SourceResolution);
+        LOG_INFO("Processing engine:   {}", m_FrameProcessor->get_engine().m_Name);
     }
 }
\ No newline at end of file
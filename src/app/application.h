@@ -8,6 +8,10 @@
 #include "main_window_controller.h"
 #include "camera_manager.h"
 #include "settings_manager.h"
+#include "frame_stats.h"
+#include "frame_processor.h"
+
+#include "util/async_log_backend.h"
 
 namespace cc::app {
     class CameraManager;
@@ -16,7 +20,7 @@ namespace cc::app {
     class Application {
     public:
         explicit Application(const std::filesystem::path& exe_path);
-        ~Application() = default;
+        ~Application();
 
         Application             (const Application&) = delete;
         Application& operator = (const Application&) = delete;
@@ -30,25 +34,27 @@ namespace cc::app {
         std::filesystem::path m_ExePath;
         std::filesystem::path m_DataPath;
 
+        // the destructor detaches this from the logger before any member is destroyed, so the managers log
+        // synchronously from then on
+        std::unique_ptr<util::AsyncLogBackend> m_LogBackend;
+
         std::unique_ptr<SettingsManager>      m_SettingsManager;
         std::unique_ptr<CameraManager>        m_CameraManager;
         std::unique_ptr<MainWindowController> m_UiController;
+        std::unique_ptr<FrameStats>           m_FrameStats;
+        std::unique_ptr<FrameProcessor>       m_FrameProcessor; // refers to m_FrameStats
 
         bool m_Running      = false;
         bool m_UseLiveVideo = false;
-
-        static constexpr const size_t k_MinimumToothCount = 8;
+        bool m_ShowStats    = true;
 
         enum class e_ShowImage {
             processed_image,
             foreground
         } m_Show = e_ShowImage::processed_image;
 
-        cv::Mat m_SourceImage;    // BGR
-        cv::Mat m_Foreground;     // BGR
-        cv::Mat m_ForegroundMask; // grayscale
+        cv::Mat m_SourceImage; // BGR
 
-        void initialize_buffers(); // can only be done once the source image is set at least once
         void main_loop();
         void print_startup_info() const;
     };
@@ -0,0 +1,198 @@
+#include "frame_processor.h"
+
+#include "processing/anomalies.h"
+
+#include "gui/visualization.h"
+
+#include "util/trace.h"
+
+#include <algorithm>
+
+namespace cc::app {
+    FrameProcessor::FrameProcessor(FrameStats& stats):
+        m_Stats (stats),
+        m_Engine(&processing::get_reference_engine())
+    {
+    }
+
+    const FrameResult* FrameProcessor::process(
+        const cv::Scalar& foreground_color,
+              int         foreground_tolerance,
+        const cv::Mat&    source_image,
+              cv::Mat&    output_image
+    ) {
+        using e_Stage = FrameStats::e_Stage;
+        using processing::AnomalyScorer;
+
+        const double megapixels = static_cast<double>(source_image.total()) * 1e-6;
+
+        m_Stats.add_work(e_Stage::foreground, megapixels);
+
+        {
+            auto measurement = m_Stats.measure(e_Stage::foreground);
+
+            m_Engine->m_DetermineForeground(
+                foreground_color,
+                foreground_tolerance,
+                source_image,
+                m_ForegroundMask,
+                m_Foreground
+            );
+        }
+
+        auto maybe_result = m_Engine->m_ProcessMask ?
+            process_mask(output_image) :
+            process_contours(megapixels, source_image, output_image);
+
+        // early exit -- if we have found less than 8 teeth, it's probably not a gear that we found
+        if (!maybe_result || maybe_result->m_Teeth.size() < k_MinimumToothCount)
+            return nullptr;
+
+        auto& result = m_Result;
+
+        result.m_Teeth    = std::move(maybe_result->m_Teeth);
+        result.m_Centroid = maybe_result->m_Centroid;
+
+        {
+            auto measurement = m_Stats.measure(e_Stage::find_anomalies);
+
+            m_AnomalyScorer.score(result.m_Teeth, result.m_AnomalyScores, result.m_AnomalyMask);
+
+            if (m_AnomalyBaseline.is_ready()) {
+                const auto& baseline_scores = m_AnomalyBaseline.score(result.m_Teeth);
+                result.m_BaselineScores.assign(baseline_scores.begin(), baseline_scores.end());
+
+                // empty for another tooth count
+                if (!result.m_BaselineScores.empty())
+                    processing::merge_anomaly_mask(
+                        result.m_BaselineScores,
+                        AnomalyScorer::k_StrongAnomaly,
+                        result.m_AnomalyMask
+                    );
+            }
+            else
+                result.m_BaselineScores.clear();
+
+            auto is_regular = [](const ToothAnomalyScore& score) {
+                return
+                    score.m_Arc <= AnomalyScorer::k_StrongAnomaly &&
+                    score.m_Gap <= AnomalyScorer::k_StrongAnomaly;
+            };
+
+            // only learn from gears that look fine, so a defective run doesn't become the new normal
+            if (
+                std::ranges::all_of(result.m_AnomalyScores,  is_regular) &&
+                std::ranges::all_of(result.m_BaselineScores, is_regular)
+            )
+                m_AnomalyBaseline.add(result.m_Teeth);
+        }
+
+        // and display the result in-image at the center of the gear
+        {
+            auto measurement = m_Stats.measure(e_Stage::display_results);
+
+            display_results(
+                result.m_Centroid,
+                result.m_Teeth,
+                result.m_AnomalyMask,
+                output_image
+            );
+        }
+
+        return &result;
+    }
+
+    std::optional<processing::ContourResult> FrameProcessor::process_contours(
+              double   megapixels,
+        const cv::Mat& source_image,
+              cv::Mat& output_image
+    ) {
+        using e_Stage = FrameStats::e_Stage;
+
+        m_Stats.add_work(e_Stage::find_contours, megapixels);
+
+        std::vector<std::vector<cv::Point>> contours;
+        std::vector<cv::Vec4i> hierarchy;
+
+        // https://docs.opencv.org/3.4/d3/dc0/group__imgproc__shape.html#ga17ed9f5d79ae97bd4c7cf18403e1689a
+        {
+            CC_TRACE_SCOPE("findContours");
+            auto measurement = m_Stats.measure(e_Stage::find_contours);
+
+            cv::findContours(
+                m_ForegroundMask,
+                contours,
+                hierarchy,
+                cv::RETR_CCOMP, // organizes in a multi-level list, with external boundaries at the top level
+                cv::CHAIN_APPROX_SIMPLE
+            );
+        }
+
+        if (contours.empty())
+            return std::nullopt;
+
+        std::optional<processing::ContourResult> result;
+
+        {
+            auto measurement = m_Stats.measure(e_Stage::process_contours);
+
+            result = m_Engine->m_ProcessContours(
+                contours,
+                hierarchy,
+                source_image,
+                output_image
+            );
+        }
+
+        // the kernels only process the largest contour, and report its size
+        if (result)
+            m_Stats.add_work(e_Stage::process_contours, static_cast<double>(result->m_NumContourPoints));
+
+        return result;
+    }
+
+    std::optional<processing::ContourResult> FrameProcessor::process_mask(cv::Mat& output_image) {
+        using e_Stage = FrameStats::e_Stage;
+
+        std::optional<processing::ContourResult> result;
+
+        {
+            auto measurement = m_Stats.measure(e_Stage::process_contours);
+
+            result = m_Engine->m_ProcessMask(
+                m_ForegroundMask,
+                output_image
+            );
+        }
+
+        // there is no contour, the mask kernels report the bins of the polar signature as the closest equivalent
+        if (result)
+            m_Stats.add_work(e_Stage::process_contours, static_cast<double>(result->m_NumContourPoints));
+
+        return result;
+    }
+
+    void FrameProcessor::set_engine(const processing::Engine& engine) {
+        m_Engine = &engine;
+    }
+
+    void FrameProcessor::reset_baseline() {
+        m_AnomalyBaseline.reset();
+    }
+
+    const processing::Engine& FrameProcessor::get_engine() const {
+        return *m_Engine;
+    }
+
+    const processing::AnomalyBaseline& FrameProcessor::get_baseline() const {
+        return m_AnomalyBaseline;
+    }
+
+    const cv::Mat& FrameProcessor::get_foreground() const {
+        return m_Foreground;
+    }
+
+    const cv::Mat& FrameProcessor::get_foreground_mask() const {
+        return m_ForegroundMask;
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef CC_APP_FRAME_PROCESSOR_H
+#define CC_APP_FRAME_PROCESSOR_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "frame_stats.h"
+
+#include "processing/anomalies.h"
+#include "processing/anomaly_baseline.h"
+#include "processing/engine.h"
+#include "types/tooth_anomaly.h"
+#include "types/tooth_measurement.h"
+
+namespace cc::app {
+    struct FrameResult {
+        std::vector<ToothMeasurement>  m_Teeth;
+        std::vector<uint8_t>           m_AnomalyMask;    // the robust and baseline scores above AnomalyScorer::k_StrongAnomaly
+        std::vector<ToothAnomalyScore> m_AnomalyScores;  // robust scores, see processing::AnomalyScorer
+        std::vector<ToothAnomalyScore> m_BaselineScores; // against recent gears, empty when not ready or for another tooth count
+        cv::Point2i                    m_Centroid;
+    };
+
+    /*
+     * The per-frame processing of the main loop -- foreground segmentation, contours, tooth counting,
+     * anomaly detection and annotation of the output image. Every stage is measured in the FrameStats.
+     *
+     * Shared by the application and the throughput benchmark, so both measure the same work.
+     * The kernels come from the selected processing::Engine, the reference engine by default; engines
+     * that work on the foreground mask directly skip the contour stage.
+     *
+     * Gears without anomalies (on their own, and against the baseline once that is ready) are added to
+     * a rolling processing::AnomalyBaseline; reset it when switching to another part type. Teeth that are
+     * off the baseline are flagged in the anomaly mask, even when the gear is regular on its own.
+     */
+    class FrameProcessor {
+    public:
+        static constexpr size_t k_MinimumToothCount = 8;
+
+        explicit FrameProcessor(FrameStats& stats);
+
+        // output_image should be a copy of the source image; the results are drawn into it
+        // nullptr when no gear was found, otherwise the result is valid until the next call
+        const FrameResult* process(
+            const cv::Scalar& foreground_color,
+                  int         foreground_tolerance,
+            const cv::Mat&    source_image,
+                  cv::Mat&    output_image
+        );
+
+        void set_engine(const processing::Engine& engine);
+
+        void reset_baseline();
+
+        [[nodiscard]] const processing::Engine&          get_engine()          const;
+        [[nodiscard]] const processing::AnomalyBaseline& get_baseline()        const;
+        [[nodiscard]] const cv::Mat&                     get_foreground()      const; // BGR
+        [[nodiscard]] const cv::Mat&                     get_foreground_mask() const; // grayscale
+
+    private:
+        // findContours and the contour kernel of the engine, or the mask kernel for engines that have one
+        std::optional<processing::ContourResult> process_contours(
+                  double   megapixels,
+            const cv::Mat& source_image,
+                  cv::Mat& output_image
+        );
+        std::optional<processing::ContourResult> process_mask(cv::Mat& output_image);
+
+        FrameStats&               m_Stats;
+        const processing::Engine* m_Engine;
+
+        processing::AnomalyScorer   m_AnomalyScorer;
+        processing::AnomalyBaseline m_AnomalyBaseline;
+
+        FrameResult m_Result; // the buffers are reused between frames
+
+        cv::Mat m_Foreground;
+        cv::Mat m_ForegroundMask;
+    };
+}
+
+#endif
@@ -0,0 +1,264 @@
+#include "frame_stats.h"
+
+#include <format>
+#include <fstream>
+#include <utility>
+
+#include "util/logger.h"
+
+namespace {
+    double to_ms(cc::app::FrameStats::Duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    double to_us(cc::app::FrameStats::Duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
+
+    double to_seconds(cc::app::FrameStats::Clock::duration d) {
+        return std::chrono::duration<double>(d).count();
+    }
+
+    // average over the number of times a stage was measured
+    double per_call(uint64_t total, uint64_t num_calls) {
+        return (num_calls == 0) ? 0.0 : static_cast<double>(total) / static_cast<double>(num_calls);
+    }
+
+    // stages with a work unit are normalized by the work they reported, the others per call
+    double per_work(uint64_t total, double work, uint64_t num_calls) {
+        if (work > 0.0)
+            return static_cast<double>(total) / work;
+
+        return per_call(total, num_calls);
+    }
+}
+
+namespace cc::app {
+    FrameStats::StageScope::StageScope(FrameStats& stats, e_Stage stage):
+        m_Stats(stats),
+        m_Stage(stage),
+        m_Start(Clock::now()),
+        m_PerfStart(stats.m_PerfCounters.sample())
+    {
+    }
+
+    FrameStats::StageScope::~StageScope() {
+        if (m_Stats.has_perf_counters())
+            m_Stats.record_perf(m_Stage, m_Stats.m_PerfCounters.sample() - m_PerfStart);
+
+        m_Stats.record(m_Stage, Clock::now() - m_Start);
+
+        if constexpr (util::is_allocation_tracking_enabled())
+            m_Stats.record_allocations(m_Stage, m_Allocations.get());
+    }
+
+    FrameStats::FrameStats(
+        std::filesystem::path export_path,
+        Clock::duration       display_interval,
+        Clock::duration       export_interval
+    ):
+        m_ExportPath     (std::move(export_path)),
+        m_DisplayInterval(display_interval),
+        m_ExportInterval (export_interval)
+    {
+    }
+
+    util::LatencyHistogram& FrameStats::get_histogram(e_Stage stage) {
+        return m_Current[static_cast<size_t>(stage)];
+    }
+
+    const util::AllocationStats& FrameStats::get_allocations(e_Stage stage) const {
+        return m_CurrentAllocations[static_cast<size_t>(stage)];
+    }
+
+    const util::PerfSample& FrameStats::get_perf(e_Stage stage) const {
+        return m_CurrentPerf[static_cast<size_t>(stage)];
+    }
+
+    void FrameStats::record(e_Stage stage, Duration d) {
+        get_histogram(stage).record(d);
+    }
+
+    void FrameStats::record_allocations(e_Stage stage, const util::AllocationStats& allocations) {
+        m_CurrentAllocations[static_cast<size_t>(stage)] += allocations;
+    }
+
+    void FrameStats::record_perf(e_Stage stage, const util::PerfSample& sample) {
+        m_CurrentPerf[static_cast<size_t>(stage)] += sample;
+    }
+
+    void FrameStats::add_work(e_Stage stage, double amount) {
+        m_CurrentWork[static_cast<size_t>(stage)] += amount;
+    }
+
+    bool FrameStats::has_perf_counters() const {
+        return m_PerfCounters.is_available();
+    }
+
+    FrameStats::StageScope FrameStats::measure(e_Stage stage) {
+        return { *this, stage };
+    }
+
+    void FrameStats::on_frame(Clock::time_point now) {
+        // the first frame only marks the start of the first interval
+        if (m_IntervalStart == Clock::time_point{}) {
+            m_IntervalStart = now;
+            m_ExportStart   = now;
+            return;
+        }
+
+        ++m_NumFrames;
+
+        if (now - m_IntervalStart >= m_DisplayInterval)
+            complete_interval(now);
+    }
+
+    const std::vector<std::string>& FrameStats::get_summary() const {
+        return m_Summary;
+    }
+
+    double FrameStats::get_fps() const {
+        return m_Fps;
+    }
+
+    const char* FrameStats::to_string(e_Stage stage) {
+        switch (stage) {
+            case e_Stage::capture:          return "capture";
+            case e_Stage::foreground:       return "foreground";
+            case e_Stage::find_contours:    return "find_contours";
+            case e_Stage::process_contours: return "process_contours";
+            case e_Stage::find_anomalies:   return "find_anomalies";
+            case e_Stage::display_results:  return "display_results";
+            case e_Stage::rendering:        return "rendering";
+            case e_Stage::total:            return "total";
+            default:
+                                            return "unknown";
+        }
+    }
+
+    const char* FrameStats::get_work_unit(e_Stage stage) {
+        switch (stage) {
+            case e_Stage::foreground:       return "MP";
+            case e_Stage::find_contours:    return "MP";
+            case e_Stage::process_contours: return "pt";
+            default:
+                                            return "call";
+        }
+    }
+
+    void FrameStats::complete_interval(Clock::time_point now) {
+        m_Fps = static_cast<double>(m_NumFrames) / to_seconds(now - m_IntervalStart);
+
+        m_Summary.clear();
+        m_Summary.push_back(std::format("{:.1f} fps", m_Fps));
+
+        for (size_t i = 0; i < k_NumStages; ++i) {
+            Snapshot snapshot    = m_Current[i].snapshot();
+            auto     allocations = std::exchange(m_CurrentAllocations[i], {});
+            auto     perf        = std::exchange(m_CurrentPerf[i], {});
+            auto     work        = std::exchange(m_CurrentWork[i], 0.0);
+
+            m_Current[i].reset();
+
+            if (snapshot.m_Count == 0)
+                continue;
+
+            auto line = std::format(
+                "{:<16} p50 {:6.2f}  p99 {:6.2f}  max {:6.2f} ms",
+                to_string(static_cast<e_Stage>(i)),
+                to_ms(snapshot.percentile(50.0)),
+                to_ms(snapshot.percentile(99.0)),
+                to_ms(snapshot.max())
+            );
+
+            if constexpr (util::is_allocation_tracking_enabled())
+                line += std::format(
+                    "  {:6.1f} allocs {:8.1f} KB",
+                    per_call(allocations.m_NumAllocations, snapshot.m_Count),
+                    per_call(allocations.m_NumBytes,       snapshot.m_Count) / 1024.0
+                );
+
+            if (has_perf_counters())
+                line += std::format(
+                    "  IPC {:4.2f}  {:8.1f} cache / {:8.1f} branch misses per {}",
+                    perf.get_ipc(),
+                    per_work(perf.m_CacheMisses,  work, snapshot.m_Count),
+                    per_work(perf.m_BranchMisses, work, snapshot.m_Count),
+                    (work > 0.0) ? get_work_unit(static_cast<e_Stage>(i)) : "call"
+                );
+
+            m_Summary.push_back(std::move(line));
+
+            if (!m_ExportPath.empty()) {
+                m_Export[i].merge(snapshot);
+                m_ExportAllocations[i] += allocations;
+                m_ExportPerf[i]        += perf;
+                m_ExportWork[i]        += work;
+            }
+        }
+
+        m_ExportNumFrames += m_NumFrames;
+        m_NumFrames        = 0;
+        m_IntervalStart    = now;
+
+        if (!m_ExportPath.empty() && (now - m_ExportStart >= m_ExportInterval)) {
+            double fps = static_cast<double>(m_ExportNumFrames) / to_seconds(now - m_ExportStart);
+
+            export_stats(fps);
+
+            m_Export            = {};
+            m_ExportAllocations = {};
+            m_ExportPerf        = {};
+            m_ExportWork        = {};
+            m_ExportNumFrames   = 0;
+            m_ExportStart       = now;
+        }
+    }
+
+    void FrameStats::export_stats(double fps) {
+        bool write_header = !std::filesystem::exists(m_ExportPath);
+
+        std::ofstream out(m_ExportPath, std::ios::app);
+
+        if (!out) {
+            LOG_WARNING("Cannot write frame statistics to {}", m_ExportPath.string());
+            return;
+        }
+
+        if (write_header)
+            out << "time,stage,count,mean_us,p50_us,p99_us,max_us,fps,allocs_per_call,bytes_per_call,ipc,cache_misses_per_unit,branch_misses_per_unit,unit\n";
+
+        auto timestamp = std::format(
+            "{:%F %T}",
+            std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now())
+        );
+
+        for (size_t i = 0; i < k_NumStages; ++i) {
+            const auto& snapshot    = m_Export[i];
+            const auto& allocations = m_ExportAllocations[i];
+            const auto& perf        = m_ExportPerf[i];
+            const auto& work        = m_ExportWork[i];
+
+            if (snapshot.m_Count == 0)
+                continue;
+
+            out << std::format(
+                "{},{},{},{:.1f},{:.1f},{:.1f},{:.1f},{:.2f},{:.1f},{:.1f},{:.3f},{:.1f},{:.1f},{}\n",
+                timestamp,
+                to_string(static_cast<e_Stage>(i)),
+                snapshot.m_Count,
+                to_us(snapshot.mean()),
+                to_us(snapshot.percentile(50.0)),
+                to_us(snapshot.percentile(99.0)),
+                to_us(snapshot.max()),
+                fps,
+                per_call(allocations.m_NumAllocations, snapshot.m_Count),
+                per_call(allocations.m_NumBytes,       snapshot.m_Count),
+                perf.get_ipc(),
+                per_work(perf.m_CacheMisses,  work, snapshot.m_Count),
+                per_work(perf.m_BranchMisses, work, snapshot.m_Count),
+                (work > 0.0) ? get_work_unit(static_cast<e_Stage>(i)) : "call"
+            );
+        }
+    }
+}
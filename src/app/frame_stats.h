@@ -0,0 +1,135 @@
+#ifndef CC_APP_FRAME_STATS_H
+#define CC_APP_FRAME_STATS_H
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "util/allocation_tracker.h"
+#include "util/latency_histogram.h"
+#include "util/perf_counters.h"
+
+namespace cc::app {
+    /*
+     * Per-stage and end-to-end latency of the processing pipeline, plus the frame rate
+     * (and per-stage heap allocations and hardware counters, when those are enabled)
+     *
+     * Latencies are collected per display interval; when an interval completes its percentiles
+     * become the summary (so the displayed numbers reflect recent behavior rather than the
+     * entire session). Completed intervals are also accumulated and appended to a CSV file
+     * once per export interval.
+     *
+     * Hardware counters are normalized by the amount of work a stage did (see add_work), so that
+     * e.g. cache misses per megapixel can be compared across resolutions. Only the thread that
+     * created the FrameStats is counted; work that OpenCV spreads over its own threads is not.
+     *
+     * Not thread safe; intended to be driven by the main loop.
+     */
+    class FrameStats {
+    public:
+        using Clock    = std::chrono::steady_clock;
+        using Duration = util::LatencyHistogram::Duration;
+
+        enum class e_Stage {
+            capture,
+            foreground,
+            find_contours,
+            process_contours,
+            find_anomalies,
+            display_results,
+            rendering,
+            total            // end-to-end, capture up to and including display_results
+
+            // NOTE should be kept in sync with k_NumStages
+        };
+
+        static constexpr size_t k_NumStages = 8;
+
+        // measures latency and allocations of a stage from construction to destruction
+        class StageScope {
+        public:
+            StageScope(FrameStats& stats, e_Stage stage);
+            ~StageScope();
+
+            StageScope             (const StageScope&) = delete;
+            StageScope& operator = (const StageScope&) = delete;
+            StageScope             (StageScope&&) noexcept = delete;
+            StageScope& operator = (StageScope&&) noexcept = delete;
+
+        private:
+            FrameStats&           m_Stats;
+            e_Stage               m_Stage;
+            util::AllocationProbe m_Allocations;
+            Clock::time_point     m_Start;
+            util::PerfSample      m_PerfStart;
+        };
+
+        explicit FrameStats(
+            std::filesystem::path export_path      = {}, // no export when empty
+            Clock::duration       display_interval = std::chrono::seconds(1),
+            Clock::duration       export_interval  = std::chrono::seconds(10)
+        );
+
+        [[nodiscard]] util::LatencyHistogram& get_histogram(e_Stage stage); // e.g. for util::ScopedLatency
+
+        // of the current interval
+        [[nodiscard]] const util::AllocationStats& get_allocations(e_Stage stage) const;
+        [[nodiscard]] const util::PerfSample&      get_perf       (e_Stage stage) const;
+
+        void record(e_Stage stage, Duration d);
+        void record_allocations(e_Stage stage, const util::AllocationStats& allocations);
+        void record_perf       (e_Stage stage, const util::PerfSample& sample);
+
+        // amount of work done by a stage this frame, in get_work_unit(stage)
+        // (stages without a work unit are normalized per call instead)
+        void add_work(e_Stage stage, double amount);
+
+        [[nodiscard]] StageScope measure(e_Stage stage);
+
+        // call once per frame
+        void on_frame(Clock::time_point now = Clock::now());
+
+        [[nodiscard]] const std::vector<std::string>& get_summary() const; // of the last completed interval
+        [[nodiscard]] double                          get_fps() const;     // of the last completed interval
+
+        [[nodiscard]] bool has_perf_counters() const;
+
+        static const char* to_string    (e_Stage stage);
+        static const char* get_work_unit(e_Stage stage); // "MP" (megapixels), "pt" (contour points) or "call"
+
+    private:
+        using Snapshot = util::LatencyHistogram::Snapshot;
+
+        void complete_interval(Clock::time_point now);
+        void export_stats(double fps);
+
+        std::filesystem::path m_ExportPath;
+        Clock::duration       m_DisplayInterval;
+        Clock::duration       m_ExportInterval;
+
+        std::array<util::LatencyHistogram, k_NumStages> m_Current;
+        std::array<util::AllocationStats,  k_NumStages> m_CurrentAllocations;
+        std::array<util::PerfSample,       k_NumStages> m_CurrentPerf;
+        std::array<double,                 k_NumStages> m_CurrentWork = {};
+
+        util::PerfCounters m_PerfCounters;
+
+        Clock::time_point m_IntervalStart;
+        size_t            m_NumFrames = 0;
+        double            m_Fps       = 0;
+
+        std::vector<std::string> m_Summary;
+
+        // accumulated over completed intervals, until exported
+        std::array<Snapshot, k_NumStages>              m_Export;
+        std::array<util::AllocationStats, k_NumStages> m_ExportAllocations;
+        std::array<util::PerfSample,      k_NumStages> m_ExportPerf;
+        std::array<double,                k_NumStages> m_ExportWork = {};
+        Clock::time_point                              m_ExportStart;
+        size_t                                         m_ExportNumFrames = 0;
+    };
+}
+
+#endif
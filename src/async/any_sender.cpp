@@ -0,0 +1,16 @@
+#include "any_sender.h"
+
+namespace cc::async {
+    AnyOperationState::~AnyOperationState() {
+        if (m_Operation)
+            m_Destroy(m_Operation);
+    }
+
+    void AnyOperationState::start() {
+        m_Start(m_Operation);
+    }
+
+    bool AnyOperationState::is_inline() const {
+        return m_Operation == static_cast<const void*>(m_Storage);
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef ASYNC_ANY_SENDER_H
+#define ASYNC_ANY_SENDER_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace cc::async {
+    /*
+     * Type-erased reference to a receiver of t_Value; this is what type-erased operations are connected to
+     * (two pointers worth of state plus three function pointers, no allocation)
+     */
+    template <typename t_Value>
+    struct AnyReceiverRef {
+        void* m_Receiver;
+        void (*m_SetValue)  (void* receiver, t_Value&& value);
+        void (*m_SetError)  (void* receiver, std::exception_ptr err);
+        void (*m_SetStopped)(void* receiver);
+
+        template <typename t_Receiver>
+        static AnyReceiverRef create(t_Receiver& receiver);
+
+        void set_value(t_Value&& value);
+        void set_value(const t_Value& value);
+        void set_error(std::exception_ptr err);
+        void set_stopped();
+    };
+
+    /*
+     * Storage for a type-erased operation state
+     * Operation states that fit are constructed in-place, larger ones are heap allocated
+     */
+    class AnyOperationState {
+    public:
+        static constexpr size_t k_InlineSize = 128;
+
+        AnyOperationState() = default;
+        ~AnyOperationState();
+
+        AnyOperationState             (const AnyOperationState&)     = delete;
+        AnyOperationState& operator = (const AnyOperationState&)     = delete;
+        AnyOperationState             (AnyOperationState&&) noexcept = delete;
+        AnyOperationState& operator = (AnyOperationState&&) noexcept = delete;
+
+        template <typename t_Sender, typename t_Receiver>
+        void emplace(t_Sender&& sender, t_Receiver receiver);
+
+        void start();
+
+        [[nodiscard]] bool is_inline() const;
+
+    private:
+        alignas(std::max_align_t) std::byte m_Storage[k_InlineSize];
+
+        void* m_Operation = nullptr;
+        void (*m_Start)  (void* operation) = nullptr;
+        void (*m_Destroy)(void* operation) = nullptr;
+    };
+
+    template <
+        typename t_Value,
+        typename t_Receiver
+    >
+    struct AnyOperation {
+        using ConnectFn = void(*)(void* sender, AnyReceiverRef<t_Value> receiver, AnyOperationState& state);
+
+        AnyOperation(
+            t_Receiver receiver,
+            ConnectFn  connect,
+            void*      sender
+        );
+
+        AnyOperation             (const AnyOperation&)     = delete;
+        AnyOperation& operator = (const AnyOperation&)     = delete;
+        AnyOperation             (AnyOperation&&) noexcept = delete;
+        AnyOperation& operator = (AnyOperation&&) noexcept = delete;
+
+        t_Receiver        m_Receiver;
+        AnyOperationState m_Operation; // connected to a reference to m_Receiver
+
+        void start();
+    };
+
+    /*
+     * Sender of t_Value that can hold any concrete sender producing (something convertible to) t_Value
+     * This allows pipelines to be stored in containers, or to be selected at runtime
+     *
+     * Senders that fit are kept in-place, larger ones are heap allocated
+     * The cost compared to static composition is one indirect call per completion signal and
+     * one indirect call for connect and start
+     */
+    template <typename t_Value>
+    class AnySender {
+    public:
+        using result_t = t_Value;
+
+        static constexpr size_t k_InlineSize = 64;
+
+        template <typename t_Sender>
+        requires (!std::is_same_v<std::decay_t<t_Sender>, AnySender>)
+        AnySender(t_Sender&& sender);
+
+        ~AnySender();
+
+        AnySender             (const AnySender&) = delete;
+        AnySender& operator = (const AnySender&) = delete;
+        AnySender             (AnySender&& as) noexcept;
+        AnySender& operator = (AnySender&& as) noexcept;
+
+        template <typename t_Receiver>
+        auto connect(t_Receiver receiver) &&     -> AnyOperation<t_Value, t_Receiver>;
+
+        template <typename t_Receiver>
+        auto connect(t_Receiver receiver) const& -> AnyOperation<t_Value, t_Receiver>; // throws std::logic_error for non-copyable senders
+
+        [[nodiscard]] bool is_inline() const;
+
+    private:
+        struct VTable {
+            void (*m_Relocate)   (void* destination, void* source); // only used for in-place senders
+            void (*m_Destroy)    (void* sender);                    // in-place senders
+            void (*m_Delete)     (void* sender);                    // heap allocated senders
+            void (*m_Connect)    (void* sender, AnyReceiverRef<t_Value> receiver, AnyOperationState& state); // nullptr for non-copyable senders
+            void (*m_ConnectMove)(void* sender, AnyReceiverRef<t_Value> receiver, AnyOperationState& state);
+        };
+
+        template <typename t_Sender>
+        static constexpr bool k_FitsInline =
+            sizeof(t_Sender)  <= k_InlineSize &&
+            alignof(t_Sender) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<t_Sender>;
+
+        template <typename t_Sender>
+        static const VTable k_VTable;
+
+        void reset();
+
+        alignas(std::max_align_t) std::byte m_Storage[k_InlineSize];
+
+        void*         m_Sender = nullptr; // points to m_Storage or to a heap allocation
+        const VTable* m_VTable = nullptr;
+    };
+
+    template <typename t_Value>
+    using any_sender_of = AnySender<t_Value>;
+}
+
+#include "any_sender.inl"
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef ASYNC_ANY_SENDER_INL
+#define ASYNC_ANY_SENDER_INL
+
+#include "any_sender.h"
+
+#include <memory>
+#include <new>
+
+namespace cc::async {
+    template <typename T>
+    template <typename R>
+    AnyReceiverRef<T> AnyReceiverRef<T>::create(R& receiver) {
+        return {
+            &receiver,
+            [](void* r, T&& value)              { static_cast<R*>(r)->set_value(std::move(value)); },
+            [](void* r, std::exception_ptr err) { static_cast<R*>(r)->set_error(err); },
+            [](void* r)                         { static_cast<R*>(r)->set_stopped(); }
+        };
+    }
+
+    template <typename T>
+    void AnyReceiverRef<T>::set_value(T&& value) {
+        m_SetValue(m_Receiver, std::move(value));
+    }
+
+    template <typename T>
+    void AnyReceiverRef<T>::set_value(const T& value) {
+        T copy = value;
+        m_SetValue(m_Receiver, std::move(copy));
+    }
+
+    template <typename T>
+    void AnyReceiverRef<T>::set_error(std::exception_ptr err) {
+        m_SetError(m_Receiver, err);
+    }
+
+    template <typename T>
+    void AnyReceiverRef<T>::set_stopped() {
+        m_SetStopped(m_Receiver);
+    }
+
+    template <typename S, typename R>
+    void AnyOperationState::emplace(S&& sender, R receiver) {
+        using Operation = decltype(std::forward<S>(sender).connect(std::move(receiver)));
+
+        // operation states cannot be moved, so construct them directly from the result of connect
+        if constexpr (
+            sizeof(Operation)  <= k_InlineSize &&
+            alignof(Operation) <= alignof(std::max_align_t)
+        ) {
+            m_Operation = ::new (static_cast<void*>(m_Storage)) Operation(std::forward<S>(sender).connect(std::move(receiver)));
+            m_Destroy   = [](void* op) { std::destroy_at(static_cast<Operation*>(op)); };
+        }
+        else {
+            m_Operation = new Operation(std::forward<S>(sender).connect(std::move(receiver)));
+            m_Destroy   = [](void* op) { delete static_cast<Operation*>(op); };
+        }
+
+        m_Start = [](void* op) { static_cast<Operation*>(op)->start(); };
+    }
+
+    template <typename T, typename R>
+    AnyOperation<T, R>::AnyOperation(
+        R         receiver,
+        ConnectFn connect,
+        void*     sender
+    ):
+        m_Receiver(std::move(receiver))
+    {
+        connect(
+            sender,
+            AnyReceiverRef<T>::create(m_Receiver),
+            m_Operation
+        );
+    }
+
+    template <typename T, typename R>
+    void AnyOperation<T, R>::start() {
+        m_Operation.start();
+    }
+
+    template <typename T>
+    template <typename S>
+    const typename AnySender<T>::VTable AnySender<T>::k_VTable = {
+        [](void* destination, void* source) {
+            ::new (destination) S(std::move(*static_cast<S*>(source)));
+            std::destroy_at(static_cast<S*>(source));
+        },
+        [](void* sender) { std::destroy_at(static_cast<S*>(sender)); },
+        [](void* sender) { delete static_cast<S*>(sender); },
+        []() -> decltype(VTable::m_Connect) {
+            // senders that hold move-only state can only be connected once, as an rvalue
+            if constexpr (std::is_copy_constructible_v<S>)
+                return [](void* sender, AnyReceiverRef<T> receiver, AnyOperationState& state) {
+                    state.emplace(*static_cast<const S*>(sender), receiver);
+                };
+            else
+                return nullptr;
+        }(),
+        [](void* sender, AnyReceiverRef<T> receiver, AnyOperationState& state) {
+            state.emplace(std::move(*static_cast<S*>(sender)), receiver);
+        }
+    };
+
+    template <typename T>
+    template <typename S>
+    requires (!std::is_same_v<std::decay_t<S>, AnySender<T>>)
+    AnySender<T>::AnySender(S&& sender) {
+        using Sender = std::decay_t<S>;
+
+        if constexpr (k_FitsInline<Sender>)
+            m_Sender = ::new (static_cast<void*>(m_Storage)) Sender(std::forward<S>(sender));
+        else
+            m_Sender = new Sender(std::forward<S>(sender));
+
+        m_VTable = &k_VTable<Sender>;
+    }
+
+    template <typename T>
+    AnySender<T>::~AnySender() {
+        reset();
+    }
+
+    template <typename T>
+    AnySender<T>::AnySender(AnySender&& as) noexcept:
+        m_VTable(as.m_VTable)
+    {
+        if (as.is_inline()) {
+            m_Sender = m_Storage;
+            m_VTable->m_Relocate(m_Storage, as.m_Storage);
+        }
+        else
+            m_Sender = as.m_Sender;
+
+        as.m_Sender = nullptr;
+        as.m_VTable = nullptr;
+    }
+
+    template <typename T>
+    AnySender<T>& AnySender<T>::operator = (AnySender&& as) noexcept {
+        if (this != &as) {
+            reset();
+
+            m_VTable = as.m_VTable;
+
+            if (as.is_inline()) {
+                m_Sender = m_Storage;
+                m_VTable->m_Relocate(m_Storage, as.m_Storage);
+            }
+            else
+                m_Sender = as.m_Sender;
+
+            as.m_Sender = nullptr;
+            as.m_VTable = nullptr;
+        }
+
+        return *this;
+    }
+
+    template <typename T>
+    template <typename R>
+    auto AnySender<T>::connect(R receiver) && -> AnyOperation<T, R> {
+        return AnyOperation<T, R>(
+            std::move(receiver),
+            m_VTable->m_ConnectMove,
+            m_Sender
+        );
+    }
+
+    template <typename T>
+    template <typename R>
+    auto AnySender<T>::connect(R receiver) const& -> AnyOperation<T, R> {
+        if (!m_VTable->m_Connect)
+            throw std::logic_error("Sender holds move-only state and can only be connected as an rvalue");
+
+        return AnyOperation<T, R>(
+            std::move(receiver),
+            m_VTable->m_Connect,
+            m_Sender
+        );
+    }
+
+    template <typename T>
+    bool AnySender<T>::is_inline() const {
+        return m_Sender == static_cast<const void*>(m_Storage);
+    }
+
+    template <typename T>
+    void AnySender<T>::reset() {
+        if (!m_Sender)
+            return;
+
+        if (is_inline())
+            m_VTable->m_Destroy(m_Sender);
+        else
+            m_VTable->m_Delete(m_Sender);
+
+        m_Sender = nullptr;
+        m_VTable = nullptr;
+    }
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef ASYNC_ENSURE_STARTED_H
+#define ASYNC_ENSURE_STARTED_H
+
+#include <memory>
+#include <type_traits>
+
+#include "shared_state.h"
+
+namespace cc::async {
+    template <
+        typename t_Sender,
+        typename t_Receiver
+    >
+    struct EnsureStartedOperation:
+        SharedState<t_Sender>::Waiter
+    {
+        EnsureStartedOperation(
+            std::shared_ptr<SharedState<t_Sender>> state,
+            t_Receiver                             receiver
+        );
+
+        std::shared_ptr<SharedState<t_Sender>> m_State;
+        t_Receiver                             m_Receiver;
+
+        void start();
+        void complete() final;
+    };
+
+    /*
+     * The wrapped sender is started eagerly (when ensure_started() is called); connecting and starting
+     * this sender only waits for the result. Because there's a single consumer, the result is moved out.
+     * If the sender is dropped without being connected, the work still runs to completion.
+     */
+    template <typename t_Sender>
+    struct EnsureStartedSender {
+        using result_t = sender_result_t<t_Sender>;
+
+        std::shared_ptr<SharedState<t_Sender>> m_State;
+
+        template <typename t_Receiver>
+        auto connect(t_Receiver receiver) && -> EnsureStartedOperation<t_Sender, t_Receiver>;
+    };
+
+    template <typename t_Sender>
+    auto ensure_started(t_Sender&& sender) -> EnsureStartedSender<std::decay_t<t_Sender>>;
+}
+
+#include "ensure_started.inl"
+
+#endif
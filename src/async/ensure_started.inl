@@ -0,0 +1,50 @@
+#ifndef ASYNC_ENSURE_STARTED_INL
+#define ASYNC_ENSURE_STARTED_INL
+
+#include "ensure_started.h"
+
+namespace cc::async {
+    template <typename S, typename R>
+    EnsureStartedOperation<S, R>::EnsureStartedOperation(
+        std::shared_ptr<SharedState<S>> state,
+        R                               receiver
+    ):
+        m_State   (std::move(state)),
+        m_Receiver(std::move(receiver))
+    {
+    }
+
+    template <typename S, typename R>
+    void EnsureStartedOperation<S, R>::start() {
+        m_State->attach(this);
+    }
+
+    template <typename S, typename R>
+    void EnsureStartedOperation<S, R>::complete() {
+        if (m_State->m_Error)
+            m_Receiver.set_error(m_State->m_Error);
+        else if (m_State->m_Value)
+            m_Receiver.set_value(std::move(*m_State->m_Value));
+        else
+            m_Receiver.set_stopped();
+    }
+
+    template <typename S>
+    template <typename R>
+    auto EnsureStartedSender<S>::connect(R receiver) && -> EnsureStartedOperation<S, R> {
+        return { std::move(m_State), std::move(receiver) };
+    }
+
+    template <typename S>
+    auto ensure_started(S&& sender) -> EnsureStartedSender<std::decay_t<S>> {
+        auto state = std::make_shared<SharedState<std::decay_t<S>>>(
+            std::forward<S>(sender)
+        );
+
+        state->start();
+
+        return { std::move(state) };
+    }
+}
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef ASYNC_JUST_H
 #define ASYNC_JUST_H
 
+#include <stdexcept>
+#include <type_traits>
+
 namespace cc::async {
     template <
         typename t_Receiver,
@@ -10,7 +13,7 @@ namespace cc::async {
         t_Receiver m_Receiver;
         t_Value    m_Value;
 
-        void start();
+        void start(); // hands the value over to the receiver; an operation is only started once
     };
 
     template <typename t_Receiver>
@@ -34,28 +37,33 @@ namespace cc::async {
 
         t_Value m_Value;
 
+        // connecting an rvalue sender moves the value into the operation
         template <typename t_Receiver>
-        auto connect(t_Receiver receiver) -> JustOperation<t_Receiver, t_Value>;
+        auto connect(t_Receiver receiver) &&     -> JustOperation<t_Receiver, t_Value>;
+
+        template <typename t_Receiver>
+        auto connect(t_Receiver receiver) const& -> JustOperation<t_Receiver, t_Value>;
     };
 
     struct JustErrorSender {
         std::exception_ptr m_Error;
 
         template <typename t_Receiver>
-        auto connect(t_Receiver receiver) -> JustErrorOperation<t_Receiver>;
+        auto connect(t_Receiver receiver) const -> JustErrorOperation<t_Receiver>;
     };
 
     struct JustStoppedSender {
         template <typename t_Receiver>
-        auto connect(t_Receiver receiver) -> JustStoppedOperation<t_Receiver>;
+        auto connect(t_Receiver receiver) const -> JustStoppedOperation<t_Receiver>;
     };
 
     template <typename t_Value>
-    auto just        (t_Value value)            -> JustSender<t_Value>;
-    auto just_error  (std::exception_ptr error) -> JustErrorSender;
-    auto just_stopped()                         -> JustStoppedSender;
+    auto just(t_Value&& value) -> JustSender<std::decay_t<t_Value>>;
+
+    inline auto just_error  (std::exception_ptr error) -> JustErrorSender;
+    inline auto just_stopped()                         -> JustStoppedSender;
 }
 
 #include "just.inl"
 
-#endif
\ No newline at end of file
+#endif
@@ -6,7 +6,7 @@
 namespace cc::async {
     template <typename R, typename T>
     void JustOperation<R, T>::start() {
-        m_Receiver.set_value(m_Value);
+        m_Receiver.set_value(std::move(m_Value));
     }
 
     template <typename R>
@@ -21,42 +21,51 @@ namespace cc::async {
 
     template <typename T>
     template <typename R>
-    auto JustSender<T>::connect(R receiver) -> JustOperation<R, T> {
+    auto JustSender<T>::connect(R receiver) && -> JustOperation<R, T> {
         return {
-            receiver,
+            std::move(receiver),
+            std::move(m_Value)
+        };
+    }
+
+    template <typename T>
+    template <typename R>
+    auto JustSender<T>::connect(R receiver) const& -> JustOperation<R, T> {
+        return {
+            std::move(receiver),
             m_Value
         };
     }
 
     template <typename R>
-    auto JustErrorSender::connect(R receiver) -> JustErrorOperation<R> {
+    auto JustErrorSender::connect(R receiver) const -> JustErrorOperation<R> {
         return {
-            receiver,
+            std::move(receiver),
             m_Error
         };
     }
 
     template <typename R>
-    auto JustStoppedSender::connect(R receiver) -> JustStoppedOperation<R> {
+    auto JustStoppedSender::connect(R receiver) const -> JustStoppedOperation<R> {
         return {
-            receiver
+            std::move(receiver)
         };
     }
 
     template <typename T>
-    auto just(T value) -> JustSender<T> {
-        return JustSender<T>{
-            value
+    auto just(T&& value) -> JustSender<std::decay_t<T>> {
+        return JustSender<std::decay_t<T>>{
+            std::forward<T>(value)
         };
     }
 
-    auto just_error(std::exception_ptr error) -> JustErrorSender {
+    inline auto just_error(std::exception_ptr error) -> JustErrorSender {
         return JustErrorSender {
             error
         };
     }
 
-    auto just_stopped() -> JustStoppedSender {
+    inline auto just_stopped() -> JustStoppedSender {
         return JustStoppedSender {};
     }
 }
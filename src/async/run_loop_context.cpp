@@ -1,7 +1,16 @@
 #include "run_loop_context.h"
 
+#include <utility>
+
+#include "util/trace.h"
+
 namespace cc::async {
     void RunLoop::push_back(Task* task) {
+        if (auto* stats = m_Stats.load(std::memory_order_relaxed)) {
+            task->m_EnqueueTime = SchedulerStats::Clock::now();
+            stats->on_scheduled();
+        }
+
         std::unique_lock guard(m_Mutex);
 
         task->m_Next   = &m_Head;
@@ -44,8 +53,34 @@ namespace cc::async {
     }
 
     void RunLoop::run() {
-        while (auto* work = pop_front())
+        using Clock = SchedulerStats::Clock;
+
+        while (auto* work = pop_front()) {
+            CC_TRACE_SCOPE("RunLoop task");
+
+            auto* stats = m_Stats.load(std::memory_order_relaxed);
+
+            // tasks that were enqueued before the stats were attached are not tracked
+            if (!stats || work->m_EnqueueTime == Clock::time_point{}) {
+                work->execute();
+                continue;
+            }
+
+            // executing may destroy the task, so read what we need beforehand
+            auto enqueued = work->m_EnqueueTime;
+            auto started  = Clock::now();
+
             work->execute();
+
+            stats->on_executed(
+                started      - enqueued,
+                Clock::now() - started
+            );
+        }
+    }
+
+    void RunLoop::set_stats(SchedulerStats* stats) {
+        m_Stats.store(stats, std::memory_order_relaxed);
     }
 
     void RunLoop::finish() {
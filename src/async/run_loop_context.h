@@ -3,6 +3,10 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+#include "scheduler_stats.h"
 
 namespace cc::async {
     /*
@@ -15,6 +19,8 @@ namespace cc::async {
         struct Task {
             Task* m_Next = this;
 
+            SchedulerStats::Clock::time_point m_EnqueueTime; // only set when stats are attached
+
             virtual void execute() {} // maybe operator() would be nicer
         };
 
@@ -41,7 +47,7 @@ namespace cc::async {
             RunLoop* m_Loop;
 
             template <typename t_Receiver>
-            auto connect(t_Receiver receiver) -> TaskOperation<t_Receiver>;
+            auto connect(t_Receiver receiver) const -> TaskOperation<t_Receiver>;
         };
 
         struct Scheduler {
@@ -54,11 +60,15 @@ namespace cc::async {
         void      run();
         void      finish();
 
+        void set_stats(SchedulerStats* stats); // nullptr to detach; the stats object should outlive the loop
+
         Task                    m_Head;
         Task*                   m_Tail = &m_Head;
         std::mutex              m_Mutex;
         std::condition_variable m_Condition;
         bool                    m_Finishing = false;
+
+        std::atomic<SchedulerStats*> m_Stats = nullptr;
     };
 }
 
@@ -9,7 +9,7 @@ namespace cc::async {
         R receiver,
         RunLoop& loop
     ):
-        m_Receiver(receiver),
+        m_Receiver(std::move(receiver)),
         m_Loop(loop)
     {
     }
@@ -26,8 +26,8 @@ namespace cc::async {
     }
 
     template <typename R>
-    auto RunLoop::Sender::connect(R receiver) -> RunLoop::TaskOperation<R> {
-        return { receiver, *m_Loop };
+    auto RunLoop::Sender::connect(R receiver) const -> RunLoop::TaskOperation<R> {
+        return { std::move(receiver), *m_Loop };
     }
 }
 
@@ -0,0 +1,61 @@
+#include "scheduler_stats.h"
+
+#include <ostream>
+
+namespace cc::async {
+    void SchedulerStats::on_scheduled() {
+        m_NumScheduled.fetch_add(1, std::memory_order_relaxed);
+
+        int64_t depth   = m_QueueDepth.fetch_add(1, std::memory_order_relaxed) + 1;
+        int64_t current = m_MaxQueueDepth.load(std::memory_order_relaxed);
+
+        while (depth > current && !m_MaxQueueDepth.compare_exchange_weak(current, depth, std::memory_order_relaxed))
+            ;
+    }
+
+    void SchedulerStats::on_cancelled() {
+        m_QueueDepth.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void SchedulerStats::on_executed(
+        Clock::duration wait_time,
+        Clock::duration execution_time
+    ) {
+        m_NumExecuted.fetch_add(1, std::memory_order_relaxed);
+        m_QueueDepth .fetch_sub(1, std::memory_order_relaxed);
+
+        m_WaitTime     .record(wait_time);
+        m_ExecutionTime.record(execution_time);
+    }
+
+    SchedulerStats::Snapshot SchedulerStats::snapshot() const {
+        return {
+            .m_NumScheduled  = m_NumScheduled .load(std::memory_order_relaxed),
+            .m_NumExecuted   = m_NumExecuted  .load(std::memory_order_relaxed),
+            .m_QueueDepth    = m_QueueDepth   .load(std::memory_order_relaxed),
+            .m_MaxQueueDepth = m_MaxQueueDepth.load(std::memory_order_relaxed),
+            .m_WaitTime      = m_WaitTime     .snapshot(),
+            .m_ExecutionTime = m_ExecutionTime.snapshot()
+        };
+    }
+
+    void SchedulerStats::reset() {
+        m_NumScheduled .store(0, std::memory_order_relaxed);
+        m_NumExecuted  .store(0, std::memory_order_relaxed);
+        m_MaxQueueDepth.store(m_QueueDepth.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        m_WaitTime     .reset();
+        m_ExecutionTime.reset();
+    }
+
+    std::ostream& operator << (std::ostream& os, const SchedulerStats::Snapshot& s) {
+        os
+            << "scheduled: " << s.m_NumScheduled
+            << ", executed: " << s.m_NumExecuted
+            << ", queue depth: " << s.m_QueueDepth << " (max " << s.m_MaxQueueDepth << ')'
+            << ", wait [" << s.m_WaitTime << ']'
+            << ", exec [" << s.m_ExecutionTime << ']';
+
+        return os;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef ASYNC_SCHEDULER_STATS_H
+#define ASYNC_SCHEDULER_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+#include "util/latency_histogram.h"
+
+namespace cc::async {
+    /*
+     * Optional per-scheduler instrumentation; schedulers only touch this when one is attached
+     * (see RunLoop::set_stats and TimerContext::set_stats). Everything is updated with relaxed atomics,
+     * so a snapshot can be taken from any thread at any time.
+     *
+     * - wait time:      between enqueueing a task and the start of its execution
+     *                   (for timers: how late the timer fired relative to its deadline)
+     * - execution time: duration of the task itself
+     */
+    struct SchedulerStats {
+        using Clock = std::chrono::steady_clock;
+
+        struct Snapshot {
+            uint64_t m_NumScheduled  = 0;
+            uint64_t m_NumExecuted   = 0;
+            int64_t  m_QueueDepth    = 0;
+            int64_t  m_MaxQueueDepth = 0;
+
+            util::LatencyHistogram::Snapshot m_WaitTime;
+            util::LatencyHistogram::Snapshot m_ExecutionTime;
+
+            friend std::ostream& operator << (std::ostream& os, const Snapshot& s);
+        };
+
+        std::atomic<uint64_t>  m_NumScheduled  = 0;
+        std::atomic<uint64_t>  m_NumExecuted   = 0;
+        std::atomic<int64_t>   m_QueueDepth    = 0;
+        std::atomic<int64_t>   m_MaxQueueDepth = 0;
+        util::LatencyHistogram m_WaitTime;
+        util::LatencyHistogram m_ExecutionTime;
+
+        void on_scheduled();
+        void on_cancelled();
+        void on_executed(
+            Clock::duration wait_time,
+            Clock::duration execution_time
+        );
+
+        [[nodiscard]] Snapshot snapshot() const;
+        void reset();
+    };
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef ASYNC_SHARED_STATE_H
+#define ASYNC_SHARED_STATE_H
+
+#include <stdexcept>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "result.h"
+
+namespace cc::async {
+    template <typename t_Sender>
+    struct SharedState;
+
+    template <typename t_Sender>
+    struct SharedStateReceiver {
+        SharedState<t_Sender>* m_State;
+
+        template <typename U>
+        void set_value(U&& value);
+        void set_error(std::exception_ptr err);
+        void set_stopped();
+    };
+
+    /*
+     * Runs a sender at most once and keeps the result around, so multiple waiters can observe it
+     * Used by split() and ensure_started()
+     *
+     * Waiters form an intrusive (FIFO) list; they're embedded in the operation states of the consumers,
+     * so attaching doesn't allocate. The state keeps itself alive while the wrapped operation is in flight.
+     */
+    template <typename t_Sender>
+    struct SharedState:
+        std::enable_shared_from_this<SharedState<t_Sender>>
+    {
+        using value_t = sender_result_t<t_Sender>;
+
+        struct Waiter {
+            Waiter* m_Next = nullptr;
+
+            virtual void complete() = 0; // the shared result is available
+        };
+
+        explicit SharedState(t_Sender sender);
+
+        void start();              // starts the wrapped operation if that didn't happen yet
+        void attach(Waiter* w);    // completes the waiter immediately if the result is already available
+
+        std::mutex                   m_Mutex;
+        Waiter*                      m_Head      = nullptr;
+        Waiter*                      m_Tail      = nullptr;
+        bool                         m_Started   = false;
+        bool                         m_Completed = false;
+        std::optional<value_t>       m_Value;
+        std::exception_ptr           m_Error;
+        std::shared_ptr<SharedState> m_Self; // set while the wrapped operation is in flight
+
+        connect_result_t<
+            t_Sender,
+            SharedStateReceiver<t_Sender>
+        > m_OperationState;
+
+        void notify_waiters(); // called once the wrapped operation has completed
+    };
+}
+
+#include "shared_state.inl"
+
+#endif
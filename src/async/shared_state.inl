@@ -0,0 +1,103 @@
+#ifndef ASYNC_SHARED_STATE_INL
+#define ASYNC_SHARED_STATE_INL
+
+#include "shared_state.h"
+
+namespace cc::async {
+    template <typename S>
+    template <typename U>
+    void SharedStateReceiver<S>::set_value(U&& value) {
+        {
+            std::unique_lock guard(m_State->m_Mutex);
+            m_State->m_Value.emplace(std::forward<U>(value));
+        }
+
+        m_State->notify_waiters();
+    }
+
+    template <typename S>
+    void SharedStateReceiver<S>::set_error(std::exception_ptr err) {
+        {
+            std::unique_lock guard(m_State->m_Mutex);
+            m_State->m_Error = err;
+        }
+
+        m_State->notify_waiters();
+    }
+
+    template <typename S>
+    void SharedStateReceiver<S>::set_stopped() {
+        m_State->notify_waiters();
+    }
+
+    template <typename S>
+    SharedState<S>::SharedState(S sender):
+        m_OperationState(
+            std::move(sender).connect(
+                SharedStateReceiver<S>{ this }
+            )
+        )
+    {
+    }
+
+    template <typename S>
+    void SharedState<S>::start() {
+        {
+            std::unique_lock guard(m_Mutex);
+
+            if (m_Started)
+                return;
+
+            m_Started = true;
+            m_Self    = this->shared_from_this();
+        }
+
+        // the operation may complete synchronously, so don't hold the lock here
+        m_OperationState.start();
+    }
+
+    template <typename S>
+    void SharedState<S>::attach(Waiter* w) {
+        {
+            std::unique_lock guard(m_Mutex);
+
+            if (!m_Completed) {
+                if (m_Tail)
+                    m_Tail->m_Next = w;
+                else
+                    m_Head = w;
+
+                m_Tail = w;
+                return;
+            }
+        }
+
+        // the result is already available (and will not change anymore)
+        w->complete();
+    }
+
+    template <typename S>
+    void SharedState<S>::notify_waiters() {
+        Waiter* w = nullptr;
+        std::shared_ptr<SharedState> keep_alive;
+
+        {
+            std::unique_lock guard(m_Mutex);
+
+            m_Completed = true;
+
+            w          = std::exchange(m_Head, nullptr);
+            m_Tail     = nullptr;
+            keep_alive = std::move(m_Self);
+        }
+
+        while (w) {
+            // completing may destroy the waiter, so advance first
+            Waiter* next = w->m_Next;
+            w->complete();
+            w = next;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef ASYNC_SPLIT_H
+#define ASYNC_SPLIT_H
+
+#include <memory>
+#include <type_traits>
+
+#include "shared_state.h"
+
+namespace cc::async {
+    template <
+        typename t_Sender,
+        typename t_Receiver
+    >
+    struct SplitOperation:
+        SharedState<t_Sender>::Waiter
+    {
+        SplitOperation(
+            std::shared_ptr<SharedState<t_Sender>> state,
+            t_Receiver                             receiver
+        );
+
+        std::shared_ptr<SharedState<t_Sender>> m_State;
+        t_Receiver                             m_Receiver;
+
+        void start();
+        void complete() final;
+    };
+
+    /*
+     * Copyable sender; all copies share a single run of the wrapped sender, which is started when
+     * the first consumer starts. Every consumer receives a const reference to the same result, so
+     * the (possibly expensive) value is neither recomputed nor copied.
+     */
+    template <typename t_Sender>
+    struct SplitSender {
+        using result_t = sender_result_t<t_Sender>;
+
+        std::shared_ptr<SharedState<t_Sender>> m_State;
+
+        template <typename t_Receiver>
+        auto connect(t_Receiver receiver) const -> SplitOperation<t_Sender, t_Receiver>;
+    };
+
+    template <typename t_Sender>
+    auto split(t_Sender&& sender) -> SplitSender<std::decay_t<t_Sender>>;
+}
+
+#include "split.inl"
+
+#endif
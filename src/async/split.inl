@@ -0,0 +1,49 @@
+#ifndef ASYNC_SPLIT_INL
+#define ASYNC_SPLIT_INL
+
+#include "split.h"
+
+namespace cc::async {
+    template <typename S, typename R>
+    SplitOperation<S, R>::SplitOperation(
+        std::shared_ptr<SharedState<S>> state,
+        R                               receiver
+    ):
+        m_State   (std::move(state)),
+        m_Receiver(std::move(receiver))
+    {
+    }
+
+    template <typename S, typename R>
+    void SplitOperation<S, R>::start() {
+        m_State->attach(this);
+        m_State->start();
+    }
+
+    template <typename S, typename R>
+    void SplitOperation<S, R>::complete() {
+        if (m_State->m_Error)
+            m_Receiver.set_error(m_State->m_Error);
+        else if (m_State->m_Value)
+            m_Receiver.set_value(std::as_const(*m_State->m_Value));
+        else
+            m_Receiver.set_stopped();
+    }
+
+    template <typename S>
+    template <typename R>
+    auto SplitSender<S>::connect(R receiver) const -> SplitOperation<S, R> {
+        return { m_State, std::move(receiver) };
+    }
+
+    template <typename S>
+    auto split(S&& sender) -> SplitSender<std::decay_t<S>> {
+        return {
+            std::make_shared<SharedState<std::decay_t<S>>>(
+                std::forward<S>(sender)
+            )
+        };
+    }
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <optional>
+#include <type_traits>
 
 #include "result.h"
 
@@ -28,7 +29,7 @@ namespace cc::async {
     };
 
     template <typename t_Sender>
-    auto sync_wait(t_Sender sender);
+    auto sync_wait(t_Sender&& sender);
 }
 
 #include "sync_wait.inl"
@@ -32,13 +32,13 @@ namespace cc::async {
     }
 
     template <typename S>
-    auto sync_wait(S sender) {
-        using T = sender_result_t<S>;
+    auto sync_wait(S&& sender) {
+        using T = sender_result_t<std::decay_t<S>>;
 
         SyncWaitControlBlock control;
         std::optional<T>     result;
 
-        auto operational_state = sender.connect(SyncWaitReceiver<T> { control, result });
+        auto operational_state = std::forward<S>(sender).connect(SyncWaitReceiver<T> { control, result });
         operational_state.start();
 
         // wait for the operation to complete
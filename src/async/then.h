@@ -2,6 +2,7 @@
 #define ASYNC_THEN_H
 
 #include <stdexcept>
+#include <type_traits>
 #include "result.h"
 
 namespace cc::async {
@@ -13,7 +14,8 @@ namespace cc::async {
         t_Receiver m_Receiver;
         t_Function m_Function;
 
-        void set_value(auto value);
+        template <typename U>
+        void set_value(U&& value);
         void set_error(std::exception_ptr err);
         void set_stopped();
     };
@@ -45,14 +47,18 @@ namespace cc::async {
         t_Sender   m_Sender;
         t_Function m_Function;
 
+        // connecting an rvalue sender moves the wrapped sender and function into the operation
         template <typename t_Receiver>
-        auto connect(t_Receiver receiver) -> ThenOperation<t_Sender, t_Receiver, t_Function>;
+        auto connect(t_Receiver receiver) &&     -> ThenOperation<t_Sender, t_Receiver, t_Function>;
+
+        template <typename t_Receiver>
+        auto connect(t_Receiver receiver) const& -> ThenOperation<t_Sender, t_Receiver, t_Function>;
     };
 
     template <typename t_Sender, typename t_Function>
-    auto then(t_Sender sender, t_Function fn);
+    auto then(t_Sender&& sender, t_Function&& fn);
 }
 
 #include "then.inl"
 
-#endif
\ No newline at end of file
+#endif
@@ -5,9 +5,10 @@
 
 namespace cc::async {
         template <typename R, typename F>
-        void ThenReceiver<R, F>::set_value(auto value) {
+        template <typename U>
+        void ThenReceiver<R, F>::set_value(U&& value) {
             m_Receiver.set_value(
-                m_Function(value)
+                m_Function(std::forward<U>(value))
             );
         }
 
@@ -28,11 +29,24 @@ namespace cc::async {
 
         template <typename S, typename F>
         template <typename R>
-        ThenOperation<S, R, F> ThenSender<S, F>::connect(R receiver) {
+        ThenOperation<S, R, F> ThenSender<S, F>::connect(R receiver) && {
+            return {
+                std::move(m_Sender).connect(
+                    ThenReceiver<R, F>{
+                        std::move(receiver),
+                        std::move(m_Function)
+                    }
+                )
+            };
+        }
+
+        template <typename S, typename F>
+        template <typename R>
+        ThenOperation<S, R, F> ThenSender<S, F>::connect(R receiver) const& {
             return {
                 m_Sender.connect(
                     ThenReceiver<R, F>{
-                        receiver,
+                        std::move(receiver),
                         m_Function
                     }
                 )
@@ -40,10 +54,10 @@ namespace cc::async {
         }
 
     template <typename S, typename F>
-    auto then(S sender, F fn) {
-        return ThenSender<S, F>{
-            sender,
-            fn
+    auto then(S&& sender, F&& fn) {
+        return ThenSender<std::decay_t<S>, std::decay_t<F>>{
+            std::forward<S>(sender),
+            std::forward<F>(fn)
         };
     }
 }
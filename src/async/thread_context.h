@@ -2,6 +2,7 @@
 #define  ASYNC_THREAD_CONTEXT_H
 
 #include "run_loop_context.h"
+#include "util/trace.h"
 #include <thread>
 
 namespace cc::async {
@@ -10,11 +11,15 @@ namespace cc::async {
         // explicitly pull in methods from RunLoop
         using RunLoop::get_scheduler;
         using RunLoop::finish;
+        using RunLoop::set_stats;
 
         void join();
 
     private:
-        std::thread m_Thread{ [this] { run(); } };
+        std::thread m_Thread{ [this] {
+            CC_TRACE_THREAD_NAME("ThreadContext");
+            run();
+        } };
     };
 }
 
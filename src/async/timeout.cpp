@@ -0,0 +1,8 @@
+#include "timeout.h"
+
+namespace cc::async {
+    TimeoutError::TimeoutError():
+        std::runtime_error("Operation timed out")
+    {
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef ASYNC_TIMEOUT_H
+#define ASYNC_TIMEOUT_H
+
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "result.h"
+#include "timer_context.h"
+
+namespace cc::async {
+    class TimeoutError:
+        public std::runtime_error
+    {
+    public:
+        TimeoutError();
+    };
+
+    template <
+        typename t_Sender,
+        typename t_Receiver
+    >
+    struct TimeoutState;
+
+    template <
+        typename t_Sender,
+        typename t_Receiver
+    >
+    struct TimeoutReceiver {
+        TimeoutState<t_Sender, t_Receiver>* m_State;
+
+        template <typename U>
+        void set_value(U&& value);
+        void set_error(std::exception_ptr err);
+        void set_stopped();
+    };
+
+    /*
+     * Shared between the wrapped operation and the timer; whichever completes first is forwarded
+     * to the receiver, the other one is discarded.
+     *
+     * The state is heap allocated and keeps itself alive for as long as the wrapped operation is
+     * in flight, so the TimeoutOperation may be destroyed as soon as the receiver has been signalled
+     * (even if the wrapped operation only completes much later).
+     */
+    template <
+        typename t_Sender,
+        typename t_Receiver
+    >
+    struct TimeoutState:
+        TimerContext::Task
+    {
+        TimeoutState(
+            t_Sender               sender,
+            t_Receiver             receiver,
+            TimerContext&          context,
+            TimerContext::Duration duration
+        );
+
+        t_Receiver                    m_Receiver;
+        TimerContext&                 m_Context;
+        TimerContext::Duration        m_Duration;
+        std::atomic<bool>             m_Completed = false;
+        std::shared_ptr<TimeoutState> m_Self; // set while the wrapped operation is in flight
+
+        connect_result_t<
+            t_Sender,
+            TimeoutReceiver<t_Sender, t_Receiver>
+        > m_OperationState;
+
+        void execute() final; // timer expired
+        bool try_complete();  // true for the first completion only
+    };
+
+    template <
+        typename t_Sender,
+        typename t_Receiver
+    >
+    struct TimeoutOperation {
+        std::shared_ptr<TimeoutState<t_Sender, t_Receiver>> m_State;
+
+        void start();
+    };
+
+    template <typename t_Sender>
+    struct TimeoutSender {
+        using result_t = sender_result_t<t_Sender>;
+
+        t_Sender               m_Sender;
+        TimerContext*          m_Context;
+        TimerContext::Duration m_Duration;
+
+        template <typename t_Receiver>
+        auto connect(t_Receiver receiver) &&     -> TimeoutOperation<t_Sender, t_Receiver>;
+
+        template <typename t_Receiver>
+        auto connect(t_Receiver receiver) const& -> TimeoutOperation<t_Sender, t_Receiver>;
+    };
+
+    // completes with the result of the sender, or with a TimeoutError if that takes longer than the duration
+    template <typename t_Sender>
+    auto timeout(t_Sender&& sender, TimerContext::Scheduler scheduler, TimerContext::Duration duration);
+
+    template <typename t_Sender>
+    auto timeout(t_Sender&& sender, TimerContext::Duration duration); // uses TimerContext::instance()
+}
+
+#include "timeout.inl"
+
+#endif
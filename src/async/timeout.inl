@@ -0,0 +1,132 @@
+#ifndef ASYNC_TIMEOUT_INL
+#define ASYNC_TIMEOUT_INL
+
+#include "timeout.h"
+
+namespace cc::async {
+    template <typename S, typename R>
+    template <typename U>
+    void TimeoutReceiver<S, R>::set_value(U&& value) {
+        auto* state = m_State;
+        auto  keep_alive = std::move(state->m_Self); // released once this completion returns
+
+        bool first = state->try_complete();
+
+        // either disarm the timer, or wait for it to finish signalling the receiver
+        state->m_Context.cancel(state);
+
+        if (first)
+            state->m_Receiver.set_value(std::forward<U>(value));
+    }
+
+    template <typename S, typename R>
+    void TimeoutReceiver<S, R>::set_error(std::exception_ptr err) {
+        auto* state = m_State;
+        auto  keep_alive = std::move(state->m_Self);
+
+        bool first = state->try_complete();
+        state->m_Context.cancel(state);
+
+        if (first)
+            state->m_Receiver.set_error(err);
+    }
+
+    template <typename S, typename R>
+    void TimeoutReceiver<S, R>::set_stopped() {
+        auto* state = m_State;
+        auto  keep_alive = std::move(state->m_Self);
+
+        bool first = state->try_complete();
+        state->m_Context.cancel(state);
+
+        if (first)
+            state->m_Receiver.set_stopped();
+    }
+
+    template <typename S, typename R>
+    TimeoutState<S, R>::TimeoutState(
+        S                      sender,
+        R                      receiver,
+        TimerContext&          context,
+        TimerContext::Duration duration
+    ):
+        m_Receiver(std::move(receiver)),
+        m_Context(context),
+        m_Duration(duration),
+        m_OperationState(
+            std::move(sender).connect(
+                TimeoutReceiver<S, R>{ this }
+            )
+        )
+    {
+    }
+
+    template <typename S, typename R>
+    void TimeoutState<S, R>::execute() {
+        if (try_complete())
+            m_Receiver.set_error(std::make_exception_ptr(TimeoutError()));
+    }
+
+    template <typename S, typename R>
+    bool TimeoutState<S, R>::try_complete() {
+        return !m_Completed.exchange(true);
+    }
+
+    template <typename S, typename R>
+    void TimeoutOperation<S, R>::start() {
+        auto& state = *m_State;
+
+        state.m_Self     = m_State;
+        state.m_Deadline = TimerContext::Clock::now() + state.m_Duration;
+
+        // arm the timer before starting, the operation may complete synchronously
+        state.m_Context.add(&state);
+        state.m_OperationState.start();
+    }
+
+    template <typename S>
+    template <typename R>
+    auto TimeoutSender<S>::connect(R receiver) && -> TimeoutOperation<S, R> {
+        return {
+            std::make_shared<TimeoutState<S, R>>(
+                std::move(m_Sender),
+                std::move(receiver),
+                *m_Context,
+                m_Duration
+            )
+        };
+    }
+
+    template <typename S>
+    template <typename R>
+    auto TimeoutSender<S>::connect(R receiver) const& -> TimeoutOperation<S, R> {
+        return {
+            std::make_shared<TimeoutState<S, R>>(
+                m_Sender,
+                std::move(receiver),
+                *m_Context,
+                m_Duration
+            )
+        };
+    }
+
+    template <typename S>
+    auto timeout(S&& sender, TimerContext::Scheduler scheduler, TimerContext::Duration duration) {
+        return TimeoutSender<std::decay_t<S>>{
+            std::forward<S>(sender),
+            scheduler.m_Context,
+            duration
+        };
+    }
+
+    template <typename S>
+    auto timeout(S&& sender, TimerContext::Duration duration) {
+        return timeout(
+            std::forward<S>(sender),
+            TimerContext::instance().get_scheduler(),
+            duration
+        );
+    }
+}
+
+#endif
@@ -0,0 +1,167 @@
+#include "timer_context.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "util/trace.h"
+
+namespace {
+    // std heap algorithms build a max-heap, so invert the comparison to keep the earliest deadline in front
+    bool later_deadline(
+        const cc::async::TimerContext::Task* a,
+        const cc::async::TimerContext::Task* b
+    ) {
+        return a->m_Deadline > b->m_Deadline;
+    }
+}
+
+namespace cc::async {
+    TimerContext::~TimerContext() {
+        finish();
+
+        if (m_Thread.joinable())
+            m_Thread.join();
+    }
+
+    TimerContext& TimerContext::instance() {
+        static TimerContext x;
+        return x;
+    }
+
+    TimerContext::Sender TimerContext::Scheduler::schedule() {
+        return { m_Context, Clock::now() };
+    }
+
+    TimerContext::Sender TimerContext::Scheduler::schedule_at(TimePoint deadline) {
+        return { m_Context, deadline };
+    }
+
+    TimerContext::Sender TimerContext::Scheduler::schedule_after(Duration delay) {
+        return { m_Context, Clock::now() + delay };
+    }
+
+    TimerContext::TimePoint TimerContext::Scheduler::now() const {
+        return Clock::now();
+    }
+
+    TimerContext::Scheduler TimerContext::get_scheduler() {
+        return { this };
+    }
+
+    void TimerContext::finish() {
+        std::unique_lock guard(m_Mutex);
+
+        m_Finishing = true;
+        m_Condition.notify_all();
+    }
+
+    void TimerContext::join() {
+        m_Thread.join();
+    }
+
+    void TimerContext::set_stats(SchedulerStats* stats) {
+        m_Stats.store(stats, std::memory_order_relaxed);
+    }
+
+    void TimerContext::add(Task* task) {
+        std::unique_lock guard(m_Mutex);
+
+        if (m_Finishing) {
+            // the deadline will never be reached
+            guard.unlock();
+            task->stop();
+            return;
+        }
+
+        m_Timers.push_back(task);
+        std::push_heap(m_Timers.begin(), m_Timers.end(), later_deadline);
+
+        if (auto* stats = m_Stats.load(std::memory_order_relaxed))
+            stats->on_scheduled();
+
+        m_Condition.notify_all();
+    }
+
+    bool TimerContext::cancel(Task* task) {
+        std::unique_lock guard(m_Mutex);
+
+        auto it = std::find(m_Timers.begin(), m_Timers.end(), task);
+
+        if (it != m_Timers.end()) {
+            m_Timers.erase(it);
+            std::make_heap(m_Timers.begin(), m_Timers.end(), later_deadline);
+
+            if (auto* stats = m_Stats.load(std::memory_order_relaxed))
+                stats->on_cancelled();
+
+            return true;
+        }
+
+        // if the timer thread is completing this task right now, wait until it's done with it
+        // so the caller may safely destroy the task afterwards
+        m_Condition.wait(guard, [this, task] { return m_Executing != task; });
+
+        return false;
+    }
+
+    void TimerContext::run() {
+        std::unique_lock guard(m_Mutex);
+
+        CC_TRACE_THREAD_NAME("TimerContext");
+
+        auto complete = [&](Task* task, auto completion) {
+            CC_TRACE_SCOPE("TimerContext task");
+
+            m_Executing = task;
+
+            guard.unlock();
+            (task->*completion)();
+            guard.lock();
+
+            m_Executing = nullptr;
+            m_Condition.notify_all();
+        };
+
+        while (!m_Finishing) {
+            if (m_Timers.empty()) {
+                m_Condition.wait(guard);
+                continue;
+            }
+
+            // copy the deadline; the task may be cancelled (and destroyed) while we're waiting
+            TimePoint deadline = m_Timers.front()->m_Deadline;
+
+            if (Clock::now() < deadline) {
+                m_Condition.wait_until(guard, deadline);
+                continue;
+            }
+
+            std::pop_heap(m_Timers.begin(), m_Timers.end(), later_deadline);
+            Task* task = m_Timers.back();
+            m_Timers.pop_back();
+
+            auto* stats = m_Stats.load(std::memory_order_relaxed);
+
+            if (!stats) {
+                complete(task, &Task::execute);
+                continue;
+            }
+
+            auto started = Clock::now();
+            complete(task, &Task::execute);
+
+            stats->on_executed(
+                started      - deadline,
+                Clock::now() - started
+            );
+        }
+
+        // anything left over will never reach its deadline
+        while (!m_Timers.empty()) {
+            Task* task = m_Timers.back();
+            m_Timers.pop_back();
+
+            complete(task, &Task::stop);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef ASYNC_TIMER_CONTEXT_H
+#define ASYNC_TIMER_CONTEXT_H
+
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "scheduler_stats.h"
+
+namespace cc::async {
+    /*
+     * Dedicated thread that completes operations at (or shortly after) a requested point in time
+     * Pending timers are kept in a binary min-heap ordered by deadline; the thread sleeps until
+     * the earliest deadline (or until a new timer arrives), so waiting timers cost no cpu time
+     *
+     * Timers that are still pending when the context finishes are completed with set_stopped()
+     */
+    class TimerContext {
+    public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+        using Duration  = Clock::duration;
+
+        struct None {};
+
+        struct Task {
+            TimePoint m_Deadline;
+
+            virtual void execute() {} // deadline was reached
+            virtual void stop()    {} // context finished before the deadline was reached
+        };
+
+        template <typename t_Receiver>
+        struct TimerOperation: Task {
+            t_Receiver    m_Receiver;
+            TimerContext& m_Context;
+
+            TimerOperation(
+                t_Receiver    receiver,
+                TimerContext& context,
+                TimePoint     deadline
+            );
+
+            void execute() final;
+            void stop()    final;
+            void start();
+        };
+
+        struct Sender {
+            using result_t = None;
+
+            TimerContext* m_Context;
+            TimePoint     m_Deadline;
+
+            template <typename t_Receiver>
+            auto connect(t_Receiver receiver) const -> TimerOperation<t_Receiver>;
+        };
+
+        struct Scheduler {
+            TimerContext* m_Context;
+
+            Sender schedule();                        // complete as soon as possible
+            Sender schedule_at   (TimePoint deadline);
+            Sender schedule_after(Duration  delay);
+
+            [[nodiscard]] TimePoint now() const;
+        };
+
+        TimerContext()  = default;
+        ~TimerContext(); // finishes and joins if that hasn't happened yet
+
+        TimerContext             (const TimerContext&)     = delete;
+        TimerContext& operator = (const TimerContext&)     = delete;
+        TimerContext             (TimerContext&&) noexcept = delete;
+        TimerContext& operator = (TimerContext&&) noexcept = delete;
+
+        static TimerContext& instance(); // shared context, started on first use
+
+        Scheduler get_scheduler();
+        void      finish();
+        void      join();
+
+        void set_stats(SchedulerStats* stats); // wait time is measured as the lateness relative to the deadline
+
+        void add   (Task* task);
+        bool cancel(Task* task); // returns false if the task was not pending; blocks while the task is executing
+
+    private:
+        void run();
+
+        std::vector<Task*>      m_Timers;              // min-heap on m_Deadline
+        Task*                   m_Executing = nullptr; // task currently being completed outside of the lock
+        std::mutex              m_Mutex;
+        std::condition_variable m_Condition;
+        bool                    m_Finishing = false;
+
+        std::atomic<SchedulerStats*> m_Stats = nullptr;
+
+        std::thread m_Thread{ [this] { run(); } };
+    };
+}
+
+#include "timer_context.inl"
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef ASYNC_TIMER_CONTEXT_INL
+#define ASYNC_TIMER_CONTEXT_INL
+
+#include "timer_context.h"
+
+namespace cc::async {
+    template <typename R>
+    TimerContext::TimerOperation<R>::TimerOperation(
+        R             receiver,
+        TimerContext& context,
+        TimePoint     deadline
+    ):
+        m_Receiver(std::move(receiver)),
+        m_Context(context)
+    {
+        m_Deadline = deadline;
+    }
+
+    template <typename R>
+    void TimerContext::TimerOperation<R>::execute() {
+        m_Receiver.set_value(None{});
+    }
+
+    template <typename R>
+    void TimerContext::TimerOperation<R>::stop() {
+        m_Receiver.set_stopped();
+    }
+
+    template <typename R>
+    void TimerContext::TimerOperation<R>::start() {
+        // insert the operation into the timer heap
+        m_Context.add(this);
+    }
+
+    template <typename R>
+    auto TimerContext::Sender::connect(R receiver) const -> TimerContext::TimerOperation<R> {
+        return { std::move(receiver), *m_Context, m_Deadline };
+    }
+}
+
+#endif
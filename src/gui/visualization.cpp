@@ -1,5 +1,7 @@
 #include "visualization.h"
 #include "types/tooth_anomaly.h"
+#include "util/trace.h"
+#include <algorithm>
 #include <numbers>
 
 namespace cc {
@@ -37,6 +39,8 @@ namespace cc {
         const std::vector<uint8_t>&              tooth_anomaly_mask,
         cv::Mat&                                 output_image
     ) {
+        CC_TRACE_SCOPE("display_results");
+
         constexpr int    k_FontFace      = cv::FONT_HERSHEY_SIMPLEX;
         constexpr double k_FontScale     = 1.0;
         constexpr int    k_FontThickness = 3;
@@ -164,4 +168,52 @@ namespace cc {
             false       // when drawing in an image with bottom left origin, this should be true
         );
     }
+
+    void draw_stats_panel(
+        const std::vector<std::string>& lines,
+        cv::Mat&                        output_image
+    ) {
+        constexpr int    k_FontFace      = cv::FONT_HERSHEY_PLAIN;
+        constexpr double k_FontScale     = 1.0;
+        constexpr int    k_FontThickness = 1;
+        constexpr int    k_Margin        = 8;
+        constexpr int    k_LineSpacing   = 6;
+        const cv::Scalar k_TextColor     = cv::Scalar(255, 255, 255);
+
+        if (lines.empty() || output_image.empty())
+            return;
+
+        int line_height = 0;
+        int max_width   = 0;
+
+        for (const auto& line : lines) {
+            auto text_size = cv::getTextSize(line, k_FontFace, k_FontScale, k_FontThickness, nullptr);
+
+            line_height = std::max(line_height, text_size.height);
+            max_width   = std::max(max_width,   text_size.width);
+        }
+
+        // darken the area behind the text (clipped to the image)
+        cv::Rect panel(
+            0,
+            0,
+            max_width + 2 * k_Margin,
+            static_cast<int>(lines.size()) * (line_height + k_LineSpacing) + 2 * k_Margin
+        );
+        panel &= cv::Rect(0, 0, output_image.cols, output_image.rows);
+
+        output_image(panel) *= 0.35;
+
+        for (size_t i = 0; i < lines.size(); ++i)
+            cv::putText(
+                output_image,
+                lines[i],
+                cv::Point(k_Margin, k_Margin + static_cast<int>(i + 1) * (line_height + k_LineSpacing) - k_LineSpacing / 2),
+                k_FontFace,
+                k_FontScale,
+                k_TextColor,
+                k_FontThickness,
+                cv::LINE_AA
+            );
+    }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef CC_GUI_VISUALIZATION_H
 #define CC_GUI_VISUALIZATION_H
 
+#include <string>
+#include <vector>
+
 #include <opencv2/opencv.hpp>
 
 #include "types/tooth_measurement.h"
@@ -21,6 +24,12 @@ namespace cc {
         const std::vector<uint8_t>&          tooth_anomaly_mask,
         cv::Mat&                             output_image
     );
+
+    // text lines in the top left corner, on a darkened background
+    void draw_stats_panel(
+        const std::vector<std::string>& lines,
+        cv::Mat&                        output_image
+    );
 }
 
 #endif
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "util/trace.h"
+
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -51,6 +53,8 @@ namespace cc::io {
     }
 
     cv::Mat load_jpg(const std::filesystem::path& p) {
+        CC_TRACE_SCOPE("load_jpg");
+
         int width, height, channels;
 
         StbiResource raw_data(
@@ -79,6 +83,8 @@ namespace cc::io {
     }
 
     void save_jpg(const cv::Mat& image, const std::filesystem::path& p) {
+        CC_TRACE_SCOPE("save_jpg");
+
         if (image.empty())
             throw ImageError("Cannot save empty image");
 
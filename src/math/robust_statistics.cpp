@@ -0,0 +1,54 @@
+#include "robust_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cc::math {
+    double select_median(std::span<double> values) {
+        if (values.empty())
+            return 0.0;
+
+        const auto middle = values.begin() + values.size() / 2;
+
+        std::nth_element(values.begin(), middle, values.end());
+
+        if (values.size() % 2 == 1)
+            return *middle;
+
+        // everything before the middle is not greater than it, so the other middle value is the largest of those
+        const double lower = *std::max_element(values.begin(), middle);
+
+        return (lower + *middle) / 2.0;
+    }
+
+    double select_median_absolute_deviation(
+        std::span<double> values,
+        double            median
+    ) {
+        for (auto& value : values)
+            value = std::abs(value - median);
+
+        return select_median(values);
+    }
+
+    double select_low_median(std::span<double> values) {
+        if (values.empty())
+            return 0.0;
+
+        const auto middle = values.begin() + (values.size() - 1) / 2;
+
+        std::nth_element(values.begin(), middle, values.end());
+
+        return *middle;
+    }
+
+    double select_low_median_absolute_deviation(
+        std::span<double> values,
+        double            median
+    ) {
+        for (auto& value : values)
+            value = std::abs(value - median);
+
+        return select_low_median(values);
+    }
+}
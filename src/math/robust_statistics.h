@@ -0,0 +1,35 @@
+#ifndef CC_MATH_ROBUST_STATISTICS_H
+#define CC_MATH_ROBUST_STATISTICS_H
+
+#include <span>
+
+namespace cc::math {
+    // scales the median absolute deviation to the standard deviation of normally distributed values
+    constexpr double k_MadToStandardDeviation = 1.4826;
+
+    // linear time selection (std::nth_element), reorders the values
+    // even sizes average the two middle values; an empty span yields 0
+    [[nodiscard]]
+    double select_median(std::span<double> values);
+
+    // overwrites the values with their absolute deviation from the median, and selects the median of that
+    [[nodiscard]]
+    double select_median_absolute_deviation(
+        std::span<double> values,
+        double            median
+    );
+
+    // the lower of the two middle values for even sizes (the "lo-median"), so a single selection suffices;
+    // cheaper than select_median when the values are only used to estimate a scale. An empty span yields 0
+    [[nodiscard]]
+    double select_low_median(std::span<double> values);
+
+    // select_median_absolute_deviation with the lo-median of the deviations
+    [[nodiscard]]
+    double select_low_median_absolute_deviation(
+        std::span<double> values,
+        double            median
+    );
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include "running_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <ostream>
+
+#include "square.h"
+
+namespace cc::math {
+    void RunningStatistics::add(double value) {
+        ++m_Count;
+
+        double delta = value - m_Mean;
+        m_Mean += delta / static_cast<double>(m_Count);
+        m_M2   += delta * (value - m_Mean); // uses both the old and the new mean
+
+        m_Min = std::min(m_Min, value);
+        m_Max = std::max(m_Max, value);
+    }
+
+    void RunningStatistics::merge(const RunningStatistics& other) {
+        merge(
+            other.m_Count,
+            other.m_Mean,
+            other.m_M2,
+            other.m_Min,
+            other.m_Max
+        );
+    }
+
+    void RunningStatistics::merge(
+        size_t count,
+        double mean,
+        double m2,
+        double min,
+        double max
+    ) {
+        if (count == 0)
+            return;
+
+        if (m_Count == 0) {
+            m_Count = count;
+            m_Mean  = mean;
+            m_M2    = m2;
+            m_Min   = min;
+            m_Max   = max;
+
+            return;
+        }
+
+        const auto   a     = static_cast<double>(m_Count);
+        const auto   b     = static_cast<double>(count);
+        const double n     = a + b;
+        const double delta = mean - m_Mean;
+
+        m_Mean += delta * b / n;
+        m_M2   += m2 + cc::square(delta) * a * b / n;
+
+        m_Count += count;
+
+        m_Min = std::min(m_Min, min);
+        m_Max = std::max(m_Max, max);
+    }
+
+    void RunningStatistics::reset() {
+        *this = RunningStatistics();
+    }
+
+    size_t RunningStatistics::get_count() const {
+        return m_Count;
+    }
+
+    double RunningStatistics::get_mean() const {
+        return m_Mean;
+    }
+
+    double RunningStatistics::get_variance() const {
+        if (m_Count == 0)
+            return 0.0;
+
+        return m_M2 / static_cast<double>(m_Count);
+    }
+
+    double RunningStatistics::get_sample_variance() const {
+        if (m_Count < 2)
+            return 0.0;
+
+        return m_M2 / static_cast<double>(m_Count - 1);
+    }
+
+    double RunningStatistics::get_standard_deviation() const {
+        return std::sqrt(get_variance());
+    }
+
+    double RunningStatistics::get_min() const {
+        return m_Min;
+    }
+
+    double RunningStatistics::get_max() const {
+        return m_Max;
+    }
+
+    std::ostream& operator << (std::ostream& os, const RunningStatistics& rs) {
+        os << std::format(
+            "n={} mean={:.4f} stddev={:.4f} min={:.4f} max={:.4f}",
+            rs.m_Count,
+            rs.m_Mean,
+            rs.get_standard_deviation(),
+            rs.m_Min,
+            rs.m_Max
+        );
+
+        return os;
+    }
+}
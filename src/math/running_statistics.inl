@@ -0,0 +1,51 @@
+#ifndef CC_MATH_RUNNING_STATISTICS_INL
+#define CC_MATH_RUNNING_STATISTICS_INL
+
+#include "running_statistics.h"
+#include "square.h"
+
+#include <algorithm>
+
+namespace cc::math {
+    template <std::ranges::contiguous_range t_Range>
+    void RunningStatistics::add_range(const t_Range& values) {
+        const auto*  data       = std::ranges::data(values);
+        const size_t num_values = std::ranges::size(values);
+
+        for (size_t offset = 0; offset < num_values; offset += k_BlockSize) {
+            const size_t block_size = std::min(k_BlockSize, num_values - offset);
+            const auto*  block      = data + offset;
+
+            double sum = 0.0;
+
+            for (size_t i = 0; i < block_size; ++i)
+                sum += static_cast<double>(block[i]);
+
+            const double block_mean = sum / static_cast<double>(block_size);
+
+            double block_m2  = 0.0;
+            double block_min =  std::numeric_limits<double>::infinity();
+            double block_max = -std::numeric_limits<double>::infinity();
+
+            // the block is still in cache for the second pass
+            for (size_t i = 0; i < block_size; ++i) {
+                const auto value = static_cast<double>(block[i]);
+
+                block_m2 += cc::square(value - block_mean);
+                block_min = std::min(block_min, value);
+                block_max = std::max(block_max, value);
+            }
+
+            merge(block_size, block_mean, block_m2, block_min, block_max);
+        }
+    }
+
+    template <std::ranges::contiguous_range t_Range>
+    RunningStatistics calculate_statistics(const t_Range& values) {
+        RunningStatistics result;
+        result.add_range(values);
+        return result;
+    }
+}
+
+#endif
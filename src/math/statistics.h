@@ -1,20 +1,23 @@
 #ifndef CC_MATH_STATISTICS_H
 #define CC_MATH_STATISTICS_H
 
-#include <vector>
+#include <ranges>
 
 namespace cc::math {
-    template <typename T>
+    // these accept any contiguous range of numbers (std::vector, std::array, std::span, ...)
+    // when more than one of these is needed, calculate_statistics (running_statistics.h) gets all of them in a single pass
+
+    template <std::ranges::contiguous_range t_Range>
     [[nodiscard]]
-    double calculate_mean(const std::vector<T>& values);
+    double calculate_mean(const t_Range& values);
 
-    template <typename T>
+    template <std::ranges::contiguous_range t_Range>
     [[nodiscard]]
-    double calculate_variance(const std::vector<T>& values);
+    double calculate_variance(const t_Range& values); // population variance
 
-    template <typename T>
+    template <std::ranges::contiguous_range t_Range>
     [[nodiscard]]
-    double calculate_standard_deviation(const std::vector<T>& values);
+    double calculate_standard_deviation(const t_Range& values);
 }
 
 #include "statistics.inl"
@@ -2,38 +2,28 @@
 #define CC_MATH_STATISTICS_INL
 
 #include "statistics.h"
-#include "square.h"
+#include "running_statistics.h"
 
 #include <numeric>
-#include <cmath>
 
 namespace cc::math {
-    template <typename T>
-    double calculate_mean(const std::vector<T>& values) {
+    template <std::ranges::contiguous_range t_Range>
+    double calculate_mean(const t_Range& values) {
         return std::accumulate(
-                std::begin(values),
-                std::end(values),
+                std::ranges::begin(values),
+                std::ranges::end(values),
                 0.0
-        ) / values.size();
+        ) / std::ranges::size(values);
     }
 
-    template <typename T>
-    double calculate_variance(const std::vector<T>& values) {
-        auto mean = calculate_mean(values);
-
-        return std::accumulate(
-                std::begin(values),
-                std::end(values),
-                0.0,
-                [mean](double acc, const auto &value) {
-                    return acc + cc::square(value - mean);
-                }
-        ) / values.size();;
+    template <std::ranges::contiguous_range t_Range>
+    double calculate_variance(const t_Range& values) {
+        return calculate_statistics(values).get_variance();
     }
 
-    template <typename T>
-    double calculate_standard_deviation(const std::vector<T>& values) {
-        return std::sqrt(calculate_variance(values));
+    template <std::ranges::contiguous_range t_Range>
+    double calculate_standard_deviation(const t_Range& values) {
+        return calculate_statistics(values).get_standard_deviation();
     }
 }
 
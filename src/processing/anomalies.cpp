@@ -1,17 +1,26 @@
 #include "anomalies.h"
 
-#include "math/statistics.h"
 #include "math/angles.h"
+#include "math/robust_statistics.h"
+#include "math/running_statistics.h"
 
 #include "types/tooth_anomaly.h"
 
+#include "util/trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <span>
+
 namespace cc::processing {
     std::vector<uint8_t> find_anomalies(
         const std::vector<cc::ToothMeasurement>& teeth
     ) {
+        CC_TRACE_SCOPE("find_anomalies");
+
         using cc::math::arc_length;
-        using cc::math::calculate_mean;
-        using cc::math::calculate_standard_deviation;
+        using cc::math::calculate_statistics;
 
         auto tooth_anomaly_mask = cc::create_anomaly_mask(teeth.size());
 
@@ -22,30 +31,36 @@ namespace cc::processing {
         std::vector<double> tooth_arc_gaps_to_next;
         std::vector<double> tooth_arcs;
 
+        tooth_arc_gaps_to_next.reserve(teeth.size());
+        tooth_arcs            .reserve(teeth.size());
+
         for (size_t i = 0; i < teeth.size(); ++i) {
             const auto& current = teeth[i];
             const auto& next    = teeth[(i + 1) % teeth.size()];;
 
-            tooth_arcs.push_back(
-                arc_length(
-                    current.m_StartingAngle,
-                    current.m_EndingAngle
-                )
+            const double tooth_arc = arc_length(
+                current.m_StartingAngle,
+                current.m_EndingAngle
             );
 
-            tooth_arc_gaps_to_next.push_back(
-                arc_length(
-                    current.m_EndingAngle,
-                    next.m_StartingAngle
-                )
+            const double tooth_gap = arc_length(
+                current.m_EndingAngle,
+                next.m_StartingAngle
             );
+
+            tooth_arcs            .push_back(tooth_arc);
+            tooth_arc_gaps_to_next.push_back(tooth_gap);
         }
 
-        const double tooth_arc_mean   = calculate_mean(tooth_arcs);
-        const double tooth_arc_stddev = calculate_standard_deviation(tooth_arcs);
+        // mean and stddev in a single pass over each vector
+        const auto tooth_arc_statistics = calculate_statistics(tooth_arcs);
+        const auto tooth_gap_statistics = calculate_statistics(tooth_arc_gaps_to_next);
+
+        const double tooth_arc_mean   = tooth_arc_statistics.get_mean();
+        const double tooth_arc_stddev = tooth_arc_statistics.get_standard_deviation();
 
-        const double tooth_gap_mean   = calculate_mean(tooth_arc_gaps_to_next);
-        const double tooth_gap_stddev = calculate_standard_deviation(tooth_arc_gaps_to_next);
+        const double tooth_gap_mean   = tooth_gap_statistics.get_mean();
+        const double tooth_gap_stddev = tooth_gap_statistics.get_standard_deviation();
 
         // strong anomalies several times the distance of the stddev from the mean,
         // weak anomalies between stddev and strong anomaly threshold
@@ -71,4 +86,115 @@ namespace cc::processing {
 
         return tooth_anomaly_mask;
     }
+
+    std::vector<uint8_t> create_anomaly_mask(
+        const std::vector<ToothAnomalyScore>& scores,
+              double                          threshold
+    ) {
+        auto tooth_anomaly_mask = cc::create_anomaly_mask(scores.size());
+
+        merge_anomaly_mask(scores, threshold, tooth_anomaly_mask);
+
+        return tooth_anomaly_mask;
+    }
+
+    void merge_anomaly_mask(
+        const std::vector<ToothAnomalyScore>& scores,
+              double                          threshold,
+              std::vector<uint8_t>&           tooth_anomaly_mask
+    ) {
+        for (size_t i = 0; i < scores.size(); ++i) {
+            if (scores[i].m_Gap > threshold)
+                tooth_anomaly_mask[i] |= cc::gap;
+
+            if (scores[i].m_Arc > threshold)
+                tooth_anomaly_mask[i] |= cc::arc;
+        }
+    }
+
+    namespace {
+        // 1 / the estimated standard deviation, so scoring is a multiplication instead of a division per tooth
+        struct RobustScale {
+            double m_Median;
+            double m_InvDeviation;
+        };
+
+        // reorders the values
+        RobustScale calculate_robust_scale(std::span<double> values) {
+            using namespace cc::math;
+
+            // lo-medians, a single selection each
+            const double median = select_low_median(values);
+            const double mad    = select_low_median_absolute_deviation(values, median);
+
+            const double deviation = std::max(
+                k_MadToStandardDeviation * mad,
+                AnomalyScorer::k_MinRelativeDeviation * std::abs(median)
+            );
+
+            return {
+                .m_Median       = median,
+                .m_InvDeviation = (deviation > 0.0) ? (1.0 / deviation) : 0.0 // only 0 when all values are 0
+            };
+        }
+
+        // math::arc_length for angles within one turn of each other, as the angles of the teeth of a gear are;
+        // a single wrap instead of a loop, and inlined -- the calls cost about as much as one of the selections
+        double wrapped_arc_length(double starting_radians, double ending_radians) {
+            const double arc = ending_radians - starting_radians;
+
+            return (arc < 0.0) ? (arc + 2.0 * std::numbers::pi) : arc;
+        }
+
+        double robust_score(double value, const RobustScale& scale) {
+            return std::abs(value - scale.m_Median) * scale.m_InvDeviation;
+        }
+    }
+
+    void AnomalyScorer::score(
+        const std::vector<ToothMeasurement>&  teeth,
+              std::vector<ToothAnomalyScore>& scores,
+              std::vector<uint8_t>&           tooth_anomaly_mask,
+              double                          threshold
+    ) {
+        CC_TRACE_SCOPE("AnomalyScorer::score");
+
+        const size_t num_teeth = teeth.size();
+
+        // only allocate when there are more teeth than before
+        m_Scratch         .resize(2 * num_teeth);
+        scores            .resize(num_teeth);
+        tooth_anomaly_mask.resize(num_teeth);
+
+        // the scores hold the arcs and gaps in tooth order until they are scored, the selections reorder the scratch
+        std::span<double> arc_scratch(m_Scratch.data(),             num_teeth);
+        std::span<double> gap_scratch(m_Scratch.data() + num_teeth, num_teeth);
+
+        for (size_t i = 0; i < num_teeth; ++i) {
+            const auto& current = teeth[i];
+            const auto& next    = teeth[(i + 1 == num_teeth) ? 0 : i + 1];
+
+            scores[i].m_Arc = arc_scratch[i] = wrapped_arc_length(current.m_StartingAngle, current.m_EndingAngle);
+            scores[i].m_Gap = gap_scratch[i] = wrapped_arc_length(current.m_EndingAngle,   next.m_StartingAngle);
+        }
+
+        const auto arc_scale = calculate_robust_scale(arc_scratch);
+        const auto gap_scale = calculate_robust_scale(gap_scratch);
+
+        // stores of uint8_t may alias anything, so the mask is written through a pointer, once per tooth
+        uint8_t* anomaly = tooth_anomaly_mask.data();
+
+        for (auto& score : scores) {
+            const double arc_score = robust_score(score.m_Arc, arc_scale);
+            const double gap_score = robust_score(score.m_Gap, gap_scale);
+
+            score.m_Arc = arc_score;
+            score.m_Gap = gap_score;
+
+            *anomaly++ = static_cast<uint8_t>(
+                ((gap_score > threshold) ? cc::gap : cc::none) |
+                ((arc_score > threshold) ? cc::arc : cc::none)
+            );
+        }
+    }
 }
\ No newline at end of file
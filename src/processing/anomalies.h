@@ -4,10 +4,54 @@
 #include <vector>
 #include <cstdint>
 
+#include "types/tooth_anomaly.h"
 #include "types/tooth_measurement.h"
 
 namespace cc::processing {
+    // flags teeth further than 3 standard deviations from the mean
     std::vector<uint8_t> find_anomalies(const std::vector<ToothMeasurement>& teeth);
+
+    // ToothAnomaly mask of the scores above the threshold
+    std::vector<uint8_t> create_anomaly_mask(
+        const std::vector<ToothAnomalyScore>& scores,
+              double                          threshold
+    );
+
+    // adds the ToothAnomaly flags of the scores above the threshold to a mask of the same size, in place
+    void merge_anomaly_mask(
+        const std::vector<ToothAnomalyScore>& scores,
+              double                          threshold,
+              std::vector<uint8_t>&           tooth_anomaly_mask
+    );
+
+    /*
+     * Robust alternative to find_anomalies -- scores every tooth by its distance to the median, in standard
+     * deviations estimated from the median absolute deviation (MAD). A single broken tooth inflates the
+     * standard deviation enough to hide itself from find_anomalies, but barely moves the median or the MAD.
+     *
+     * The medians are lo-medians (the lower middle value for even sizes), each selected in linear time with a
+     * single std::nth_element in a scratch buffer of the scorer; the scores and the mask go into buffers of the
+     * caller. All of them are reused between calls, so after the first frame scoring doesn't allocate (unless
+     * the number of teeth grows).
+     */
+    class AnomalyScorer {
+    public:
+        static constexpr double k_StrongAnomaly = 3.5; // modified z-score threshold (Iglewicz and Hoaglin)
+
+        // the lowest standard deviation assumed, relative to the median; perfectly regular gears have a MAD of 0
+        static constexpr double k_MinRelativeDeviation = 0.01;
+
+        // resizes the scores and the ToothAnomaly mask (of the scores above the threshold) to the number of teeth
+        void score(
+            const std::vector<ToothMeasurement>&  teeth,
+                  std::vector<ToothAnomalyScore>& scores,
+                  std::vector<uint8_t>&           tooth_anomaly_mask,
+                  double                          threshold = k_StrongAnomaly
+        );
+
+    private:
+        std::vector<double> m_Scratch;
+    };
 }
 
 #endif
\ No newline at end of file
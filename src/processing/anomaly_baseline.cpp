@@ -0,0 +1,152 @@
+#include "anomaly_baseline.h"
+
+#include "math/angles.h"
+
+#include "util/trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace cc::processing {
+    namespace {
+        double inverse_deviation(const math::RunningStatistics& stats) {
+            const double deviation = std::max(
+                stats.get_standard_deviation(),
+                AnomalyBaseline::k_MinRelativeDeviation * std::abs(stats.get_mean())
+            );
+
+            return (deviation > 0.0) ? (1.0 / deviation) : 0.0;
+        }
+    }
+
+    AnomalyBaseline::AnomalyBaseline(size_t window):
+        m_Window(window)
+    {
+        if (window == 0)
+            throw std::runtime_error("AnomalyBaseline window should hold at least one gear");
+    }
+
+    bool AnomalyBaseline::add(const std::vector<ToothMeasurement>& teeth) {
+        CC_TRACE_SCOPE("AnomalyBaseline::add");
+
+        using cc::math::arc_length;
+
+        if (teeth.empty())
+            return false;
+
+        if (m_NumTeeth == 0) {
+            if (teeth.size() != m_CandidateTeeth) {
+                // the gears so far disagree with this one, start over with its count
+                clear_window();
+
+                m_CandidateTeeth = teeth.size();
+                m_NumAgreeing    = 0;
+            }
+
+            if (++m_NumAgreeing >= k_MinAgreeingGears)
+                m_NumTeeth = m_CandidateTeeth;
+        }
+        else if (teeth.size() != m_NumTeeth)
+            return false;
+
+        auto& slot = m_Window[m_NextSlot]; // replaces the oldest gear once the window is full
+        slot = {};
+
+        for (size_t i = 0; i < teeth.size(); ++i) {
+            const auto& current = teeth[i];
+            const auto& next    = teeth[(i + 1 == teeth.size()) ? 0 : i + 1];
+
+            slot.m_Arcs.add(arc_length(current.m_StartingAngle, current.m_EndingAngle));
+            slot.m_Gaps.add(arc_length(current.m_EndingAngle,   next.m_StartingAngle));
+        }
+
+        m_NextSlot = (m_NextSlot + 1) % m_Window.size();
+        m_NumGears = std::min(m_NumGears + 1, m_Window.size());
+
+        merge_window();
+
+        return true;
+    }
+
+    void AnomalyBaseline::reset() {
+        clear_window();
+
+        m_NumTeeth       = 0;
+        m_CandidateTeeth = 0;
+        m_NumAgreeing    = 0;
+    }
+
+    bool AnomalyBaseline::is_ready() const {
+        return m_NumTeeth != 0 && m_NumGears >= std::min(k_MinGears, m_Window.size());
+    }
+
+    size_t AnomalyBaseline::get_num_gears() const {
+        return m_NumGears;
+    }
+
+    size_t AnomalyBaseline::get_num_teeth() const {
+        return m_NumTeeth;
+    }
+
+    const math::RunningStatistics& AnomalyBaseline::get_arc_statistics() const {
+        return m_Arcs;
+    }
+
+    const math::RunningStatistics& AnomalyBaseline::get_gap_statistics() const {
+        return m_Gaps;
+    }
+
+    const std::vector<ToothAnomalyScore>& AnomalyBaseline::score(const std::vector<ToothMeasurement>& teeth) {
+        CC_TRACE_SCOPE("AnomalyBaseline::score");
+
+        using cc::math::arc_length;
+
+        if (teeth.size() != m_NumTeeth) {
+            m_Scores.clear();
+            return m_Scores;
+        }
+
+        const double arc_mean = m_Arcs.get_mean();
+        const double gap_mean = m_Gaps.get_mean();
+
+        const double arc_inv_deviation = inverse_deviation(m_Arcs);
+        const double gap_inv_deviation = inverse_deviation(m_Gaps);
+
+        m_Scores.resize(teeth.size()); // only allocates the first time
+
+        for (size_t i = 0; i < teeth.size(); ++i) {
+            const auto& current = teeth[i];
+            const auto& next    = teeth[(i + 1 == teeth.size()) ? 0 : i + 1];
+
+            const double arc = arc_length(current.m_StartingAngle, current.m_EndingAngle);
+            const double gap = arc_length(current.m_EndingAngle,   next.m_StartingAngle);
+
+            m_Scores[i].m_Arc = std::abs(arc - arc_mean) * arc_inv_deviation;
+            m_Scores[i].m_Gap = std::abs(gap - gap_mean) * gap_inv_deviation;
+        }
+
+        return m_Scores;
+    }
+
+    void AnomalyBaseline::clear_window() {
+        std::ranges::fill(m_Window, GearStatistics {});
+
+        m_NextSlot = 0;
+        m_NumGears = 0;
+
+        m_Arcs.reset();
+        m_Gaps.reset();
+    }
+
+    void AnomalyBaseline::merge_window() {
+        // recombining the (at most a few dozen) summaries is cheaper and more accurate than un-merging the oldest
+        m_Arcs.reset();
+        m_Gaps.reset();
+
+        for (const auto& gear : m_Window) {
+            m_Arcs.merge(gear.m_Arcs);
+            m_Gaps.merge(gear.m_Gaps);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef CC_PROCESSING_ANOMALY_BASELINE_H
+#define CC_PROCESSING_ANOMALY_BASELINE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "math/running_statistics.h"
+
+#include "types/tooth_anomaly.h"
+#include "types/tooth_measurement.h"
+
+namespace cc::processing {
+    /*
+     * Rolling baseline of the tooth arc and gap distributions of recent good gears, for production runs of a
+     * single part type. Gears scored against it are compared to many earlier gears instead of only to their
+     * own teeth, which lowers the noise floor and catches defects that are shared by several teeth.
+     *
+     * Every added gear is summarized in a RunningStatistics per distribution; the last k_DefaultWindow of those
+     * are kept in a ring and merged, so memory is bounded; scoring is O(teeth), adding O(teeth + window).
+     *
+     * The expected number of teeth is only fixed once k_MinAgreeingGears consecutive gears had the same count, so
+     * a single miscounted gear can't lock the baseline to the wrong part; until then a gear with another count
+     * replaces the gears added so far. Afterwards gears with a different count are neither added nor scored
+     * (reset when switching to another part type).
+     */
+    class AnomalyBaseline {
+    public:
+        static constexpr size_t k_DefaultWindow = 64; // gears
+        static constexpr size_t k_MinGears      = 8;  // before scoring against the baseline is meaningful
+
+        // consecutive gears with the same tooth count before that count is fixed
+        static constexpr size_t k_MinAgreeingGears = 3;
+
+        // the lowest standard deviation assumed, relative to the mean (see AnomalyScorer)
+        static constexpr double k_MinRelativeDeviation = 0.01;
+
+        explicit AnomalyBaseline(size_t window = k_DefaultWindow);
+
+        // returns false when the gear was not added because of its tooth count
+        bool add(const std::vector<ToothMeasurement>& teeth);
+
+        void reset();
+
+        [[nodiscard]] bool   is_ready()          const; // the tooth count is fixed and at least k_MinGears were added
+        [[nodiscard]] size_t get_num_gears()     const; // within the window
+        [[nodiscard]] size_t get_num_teeth()     const; // 0 until the tooth count is fixed
+
+        [[nodiscard]] const math::RunningStatistics& get_arc_statistics() const;
+        [[nodiscard]] const math::RunningStatistics& get_gap_statistics() const;
+
+        // z-scores against the baseline, none when the tooth count isn't fixed or differs from the baseline's;
+        // the scores are valid until the next call
+        const std::vector<ToothAnomalyScore>& score(const std::vector<ToothMeasurement>& teeth);
+
+    private:
+        struct GearStatistics {
+            math::RunningStatistics m_Arcs;
+            math::RunningStatistics m_Gaps;
+        };
+
+        void clear_window();
+        void merge_window();
+
+        std::vector<GearStatistics> m_Window; // ring buffer
+        size_t                      m_NextSlot  = 0;
+        size_t                      m_NumGears  = 0;
+        size_t                      m_NumTeeth  = 0;
+
+        // the tooth count of the gears added since the last change, until it is fixed
+        size_t                      m_CandidateTeeth = 0;
+        size_t                      m_NumAgreeing    = 0;
+
+        // merged over the window
+        math::RunningStatistics m_Arcs;
+        math::RunningStatistics m_Gaps;
+
+        std::vector<ToothAnomalyScore> m_Scores;
+    };
+}
+
+#endif
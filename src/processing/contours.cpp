@@ -2,15 +2,22 @@
 
 #include "centroid.h"
 #include "count_teeth.h"
+#include "edge_refinement.h"
 #include "anomalies.h"
+#include "signal_filter.h"
 
 #include "types/tooth_measurement.h"
 
+#include "util/logger.h"
+#include "util/trace.h"
+
+#include <algorithm>
+#include <cmath>
+
 namespace cc::processing {
-    std::optional<ContourResult> process_contours(
+    int find_largest_contour(
         const std::vector<std::vector<cv::Point>>& all_contours,
-        const std::vector<cv::Vec4i>&              hierarchy,
-              cv::Mat&                             output_image
+        const std::vector<cv::Vec4i>&              hierarchy
     ) {
         int    idx                   = 0;
         int    largest_component_idx = 0;
@@ -29,6 +36,16 @@ namespace cc::processing {
             }
         }
 
+        return largest_component_idx;
+    }
+
+    LargestContour select_largest_contour(
+        const std::vector<std::vector<cv::Point>>& all_contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    ) {
+        int largest_component_idx = find_largest_contour(all_contours, hierarchy);
+
         cv::drawContours(
             output_image,
             all_contours,
@@ -45,31 +62,65 @@ namespace cc::processing {
             largest_component_idx
         );
 
-        const auto &largest_contour = all_contours[largest_component_idx];
+        return LargestContour {
+            .m_Points    = all_contours[largest_component_idx],
+            .m_CentroidF = centroid_f,
+            .m_CentroidI = centroid_i
+        };
+    }
 
-        // loop over the largest contour, collect 'similar' distances to the center point
+    std::vector<double> find_distances(const LargestContour& contour) {
         std::vector<double> distances;
-        for (const auto &pt: largest_contour) {
-            auto distance = std::hypot(
-                pt.x - centroid_i.x,
-                pt.y - centroid_i.y
-            );
+        distances.reserve(contour.m_Points.size());
 
-            distances.push_back(distance);
-        }
+        for (const auto &pt: contour.m_Points)
+            distances.push_back(std::hypot(
+                pt.x - contour.m_CentroidI.x,
+                pt.y - contour.m_CentroidI.y
+            ));
+
+        return distances;
+    }
+
+    std::optional<ContourResult> process_contours(
+        const std::vector<std::vector<cv::Point>>& all_contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    ) {
+        CC_TRACE_SCOPE("process_contours");
+
+        const auto  contour         = select_largest_contour(all_contours, hierarchy, output_image);
+        const auto &largest_contour = contour.m_Points;
+        const auto  centroid_f      = contour.m_CentroidF;
+        const auto  centroid_i      = contour.m_CentroidI;
+
+        // loop over the largest contour, collect 'similar' distances to the center point
+        auto distances = find_distances(contour);
 
         // find the largest and smallest distances to the center, use half that as a threshold
         auto min_max = std::minmax_element(distances.begin(), distances.end());
         auto distance_threshold = (*min_max.first + *min_max.second) / 2.0;
 
+        LOG_DEBUG(
+            "Largest contour: {} points, centroid ({}, {}), distance {:.1f} - {:.1f}, threshold {:.1f}",
+            largest_contour.size(),
+            centroid_i.x,
+            centroid_i.y,
+            *min_max.first,
+            *min_max.second,
+            distance_threshold
+        );
+
         std::vector<uint8_t> tooth_mask(largest_contour.size(), 0);
 
         for (size_t i = 0; i < largest_contour.size(); ++i)
             tooth_mask[i] = (distances[i] < distance_threshold) ? 1 : 0;
 
         auto first_tooth = find_tooth_start(tooth_mask);
-        if (!first_tooth)
+        if (!first_tooth) {
+            LOG_DEBUG("No tooth transitions found in the largest contour");
             return std::nullopt;
+        }
 
         auto teeth = count_teeth(
             *first_tooth,
@@ -80,8 +131,102 @@ namespace cc::processing {
         );
 
         return ContourResult {
-            .m_Teeth      = std::move(teeth),
-            .m_Centroid   = centroid_i
+            .m_Teeth            = std::move(teeth),
+            .m_Centroid         = centroid_i,
+            .m_NumContourPoints = largest_contour.size()
+        };
+    }
+
+    std::optional<ContourResult> process_contours_smoothed(
+        const std::vector<std::vector<cv::Point>>& all_contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    ) {
+        CC_TRACE_SCOPE("process_contours_smoothed");
+
+        constexpr size_t k_MedianSize = 5;     // contour points
+        constexpr double k_Hysteresis = 0.03;  // of the distance range, on either side of the threshold
+
+        const auto  contour         = select_largest_contour(all_contours, hierarchy, output_image);
+        const auto &largest_contour = contour.m_Points;
+        const auto  distances       = find_distances(contour);
+
+        std::vector<double> smoothed;
+        median_filter(distances, k_MedianSize, smoothed);
+
+        // the range of the smoothed signal, a single stray point can't move the threshold
+        auto [min_distance, max_distance] = std::ranges::minmax(smoothed);
+
+        const double distance_threshold = (min_distance + max_distance) / 2.0;
+        const double band               = k_Hysteresis * (max_distance - min_distance);
+
+        std::vector<uint8_t> tooth_mask;
+        threshold_hysteresis(smoothed, distance_threshold - band, distance_threshold + band, tooth_mask);
+
+        auto first_tooth = find_tooth_start(tooth_mask);
+        if (!first_tooth) {
+            LOG_DEBUG("No tooth transitions found in the largest contour");
+            return std::nullopt;
+        }
+
+        auto teeth = count_teeth(
+            *first_tooth,
+            tooth_mask,
+            largest_contour,
+            distances,
+            contour.m_CentroidF
+        );
+
+        return ContourResult {
+            .m_Teeth            = std::move(teeth),
+            .m_Centroid         = contour.m_CentroidI,
+            .m_NumContourPoints = largest_contour.size()
         };
     }
+
+    std::optional<ContourResult> process_contours_subpixel(
+        const std::vector<std::vector<cv::Point>>& all_contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+        const cv::Mat&                             source_image,
+              cv::Mat&                             output_image
+    ) {
+        CC_TRACE_SCOPE("process_contours_subpixel");
+
+        const auto  contour         = select_largest_contour(all_contours, hierarchy, output_image);
+        const auto &largest_contour = contour.m_Points;
+        const auto  distances       = find_distances(contour);
+
+        auto [min_distance, max_distance] = std::ranges::minmax(distances);
+
+        const double distance_threshold = (min_distance + max_distance) / 2.0;
+
+        std::vector<uint8_t> tooth_mask(largest_contour.size(), 0);
+
+        for (size_t i = 0; i < largest_contour.size(); ++i)
+            tooth_mask[i] = (distances[i] < distance_threshold) ? 1 : 0;
+
+        std::optional<ContourResult> result;
+
+        if (auto first_tooth = find_tooth_start(tooth_mask)) {
+            auto teeth = count_teeth(
+                *first_tooth,
+                tooth_mask,
+                largest_contour,
+                distances,
+                contour.m_CentroidF
+            );
+
+            refine_tooth_edges(teeth, largest_contour, distances, distance_threshold, contour.m_CentroidF, source_image);
+
+            result = ContourResult {
+                .m_Teeth            = std::move(teeth),
+                .m_Centroid         = contour.m_CentroidI,
+                .m_NumContourPoints = largest_contour.size()
+            };
+        }
+        else
+            LOG_DEBUG("No tooth transitions found in the largest contour");
+
+        return result;
+    }
 }
\ No newline at end of file
@@ -13,13 +13,58 @@ namespace cc::processing {
     struct ContourResult {
         std::vector<ToothMeasurement> m_Teeth;
         cv::Point2i                   m_Centroid;
+        size_t                        m_NumContourPoints = 0; // processed by the kernel, the bins of the polar signature for mask kernels
     };
 
+    // the top-level contour with the largest area, and its centroid
+    struct LargestContour {
+        const std::vector<cv::Point>& m_Points;
+        cv::Point2f                   m_CentroidF;
+        cv::Point2i                   m_CentroidI; // truncated, the distances are measured from here
+    };
+
+    // index of the top-level contour with the largest area
+    int find_largest_contour(
+        const std::vector<std::vector<cv::Point>>& contours,
+        const std::vector<cv::Vec4i>&              hierarchy
+    );
+
+    // the prologue of the contour kernels -- finds the largest contour and its centroid, and draws the contour
+    // into output_image
+    LargestContour select_largest_contour(
+        const std::vector<std::vector<cv::Point>>& contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    );
+
+    // the distance of every point of the contour to its (integer) centroid
+    std::vector<double> find_distances(const LargestContour& contour);
+
     std::optional<ContourResult> process_contours(
         const std::vector<std::vector<cv::Point>>& contours,
         const std::vector<cv::Vec4i>&              hierarchy,
               cv::Mat&                             output_image
     );
+
+    // process_contours with the tooth mask taken from the median filtered distances, with hysteresis around the
+    // threshold, instead of from the distances themselves -- denoises along the contour, so the foreground needs
+    // less blurring (see determine_foreground_light). The teeth still report the unfiltered distances.
+    std::optional<ContourResult> process_contours_smoothed(
+        const std::vector<std::vector<cv::Point>>& contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    );
+
+    // process_contours with sub-pixel tooth edges (see refine_tooth_edges) -- the crossings of the threshold are
+    // interpolated between the contour points, then moved onto the strongest luminance edge of source_image nearby
+    // (a CV_8UC3 image, otherwise the interpolated crossings are kept). The transition indices and distances are
+    // unchanged.
+    std::optional<ContourResult> process_contours_subpixel(
+        const std::vector<std::vector<cv::Point>>& contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+        const cv::Mat&                             source_image,
+              cv::Mat&                             output_image
+    );
 }
 
 #endif
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <cmath>
 #include <numbers>
 
+#include "util/logger.h"
+#include "util/trace.h"
+
 namespace cc::processing {
     // find the first (low) position where the mask changes from low to high
     std::optional<size_t> find_tooth_start(const std::vector<uint8_t>& mask) {
@@ -30,6 +33,8 @@ namespace cc::processing {
         const std::vector<double>&           distances,
         const cv::Point2f&                   centroid_f
     ) {
+        CC_TRACE_SCOPE("count_teeth");
+
         int tooth_count = 0;
 
         std::vector<ToothMeasurement> teeth;
@@ -78,17 +83,26 @@ namespace cc::processing {
                 // find the min and max distances for this tooth
                 // at the low->high transition index the distance should still be low, so start at the next index
                 // at the high->low transition index the distance should still be high
-                for (
-                    size_t j = (measurement.m_LowHighTransitionIdx + 1) % tooth_mask.size();
-                           j <= measurement.m_HighLowTransitionIdx;
-                    ++j, j %= tooth_mask.size()
-                ) {
+                // (a tooth that wraps around the end of the contour has its high->low index before the low->high one)
+                for (size_t j = (measurement.m_LowHighTransitionIdx + 1) % tooth_mask.size();; j = (j + 1) % tooth_mask.size()) {
                     if (distances[j] < measurement.m_MinDistance)
                         measurement.m_MinDistance = distances[j];
 
                     if (distances[j] > measurement.m_MaxDistance)
                         measurement.m_MaxDistance = distances[j];
+
+                    if (j == measurement.m_HighLowTransitionIdx)
+                        break;
                 }
+
+                LOG_DEBUG(
+                    "Tooth {}: angle {:.3f} - {:.3f}, distance {:.1f} - {:.1f}",
+                    measurement.m_ToothIdx,
+                    measurement.m_StartingAngle,
+                    measurement.m_EndingAngle,
+                    measurement.m_MinDistance,
+                    measurement.m_MaxDistance
+                );
             }
         }
 
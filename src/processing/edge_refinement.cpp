@@ -0,0 +1,170 @@
+#include "edge_refinement.h"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <optional>
+
+#include "util/trace.h"
+
+namespace cc::processing {
+    namespace {
+        constexpr int    k_SearchRadius = 3;   // pixels, on either side of the starting angle
+        constexpr double k_MinContrast  = 2.0; // gray levels per pixel, weaker gradients are treated as noise
+
+        // bilinear interpolation of the luminance (BT.601, as cv::COLOR_BGR2GRAY) at a sub-pixel position
+        std::optional<double> sample_luminance(const cv::Mat& bgr_image, double x, double y) {
+            const double fx = std::floor(x);
+            const double fy = std::floor(y);
+
+            // written so that NaN coordinates fail as well
+            if (!(fx >= 0.0 && fy >= 0.0 && fx + 1.0 < bgr_image.cols && fy + 1.0 < bgr_image.rows))
+                return std::nullopt;
+
+            const int x0 = static_cast<int>(fx);
+            const int y0 = static_cast<int>(fy);
+
+            auto luminance = [&](int row, int col) {
+                const auto& bgr = bgr_image.at<cv::Vec3b>(row, col);
+
+                return 0.114 * bgr[0] + 0.587 * bgr[1] + 0.299 * bgr[2];
+            };
+
+            const double tx = x - fx;
+            const double ty = y - fy;
+
+            const double top    = (1.0 - tx) * luminance(y0,     x0) + tx * luminance(y0,     x0 + 1);
+            const double bottom = (1.0 - tx) * luminance(y0 + 1, x0) + tx * luminance(y0 + 1, x0 + 1);
+
+            return (1.0 - ty) * top + ty * bottom;
+        }
+
+        double wrap_angle(double angle) {
+            angle = std::fmod(angle, 2.0 * std::numbers::pi);
+
+            if (angle < 0.0)
+                angle += 2.0 * std::numbers::pi;
+
+            return angle;
+        }
+
+        double refine_crossing(
+            const std::vector<cv::Point>& contour,
+            const std::vector<double>&    distances,
+                  size_t                  transition_idx,
+                  double                  threshold,
+            const cv::Point2f&            centroid_f,
+            const cv::Mat&                source_image
+        ) {
+            const size_t next_idx = (transition_idx + 1) % contour.size();
+
+            const auto crossing = interpolate_crossing(
+                contour[transition_idx],
+                contour[next_idx],
+                distances[transition_idx],
+                distances[next_idx],
+                threshold
+            );
+
+            const double dx    = crossing.x - centroid_f.x;
+            const double dy    = crossing.y - centroid_f.y;
+            const double angle = std::atan2(dy, dx);
+
+            if (source_image.type() != CV_8UC3)
+                return wrap_angle(angle);
+
+            return wrap_angle(refine_edge_angle(source_image, centroid_f, std::hypot(dx, dy), angle));
+        }
+    }
+
+    cv::Point2f interpolate_crossing(
+        const cv::Point& a,
+        const cv::Point& b,
+              double     distance_a,
+              double     distance_b,
+              double     threshold
+    ) {
+        if (distance_a == distance_b)
+            return a;
+
+        const double t = (distance_a - threshold) / (distance_a - distance_b);
+
+        return {
+            static_cast<float>(a.x + t * (b.x - a.x)),
+            static_cast<float>(a.y + t * (b.y - a.y))
+        };
+    }
+
+    double refine_edge_angle(
+        const cv::Mat&     bgr_image,
+        const cv::Point2f& center,
+              double       radius,
+              double       angle
+    ) {
+        if (radius < 1.0)
+            return angle;
+
+        // one sample per pixel along the circle, with an extra one on either end for the central differences
+        constexpr int k_NumSamples = 2 * k_SearchRadius + 3;
+
+        std::array<double, k_NumSamples> luminance;
+
+        for (int i = 0; i < k_NumSamples; ++i) {
+            const double sample_angle = angle + (i - k_SearchRadius - 1) / radius;
+
+            auto value = sample_luminance(
+                bgr_image,
+                center.x + radius * std::cos(sample_angle),
+                center.y + radius * std::sin(sample_angle)
+            );
+
+            if (!value)
+                return angle;
+
+            luminance[i] = *value;
+        }
+
+        // gradient magnitude at offsets -k_SearchRadius ... k_SearchRadius
+        std::array<double, k_NumSamples - 2> gradient;
+
+        for (size_t i = 0; i < gradient.size(); ++i)
+            gradient[i] = std::abs(luminance[i + 2] - luminance[i]) / 2.0;
+
+        size_t peak = 0;
+
+        for (size_t i = 1; i < gradient.size(); ++i)
+            if (gradient[i] > gradient[peak])
+                peak = i;
+
+        if (peak == 0 || peak == gradient.size() - 1 || gradient[peak] < k_MinContrast)
+            return angle;
+
+        // vertex of the parabola through the peak and its neighbours
+        const double left      = gradient[peak - 1];
+        const double right     = gradient[peak + 1];
+        const double curvature = left - 2.0 * gradient[peak] + right;
+
+        double offset = static_cast<double>(peak) - k_SearchRadius;
+
+        if (curvature < 0.0)
+            offset += 0.5 * (left - right) / curvature;
+
+        return angle + offset / radius;
+    }
+
+    void refine_tooth_edges(
+              std::vector<ToothMeasurement>& teeth,
+        const std::vector<cv::Point>&        contour,
+        const std::vector<double>&           distances,
+              double                         threshold,
+        const cv::Point2f&                   centroid_f,
+        const cv::Mat&                       source_image
+    ) {
+        CC_TRACE_SCOPE("refine_tooth_edges");
+
+        for (auto& tooth : teeth) {
+            tooth.m_StartingAngle = refine_crossing(contour, distances, tooth.m_LowHighTransitionIdx, threshold, centroid_f, source_image);
+            tooth.m_EndingAngle   = refine_crossing(contour, distances, tooth.m_HighLowTransitionIdx, threshold, centroid_f, source_image);
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef CC_PROCESSING_EDGE_REFINEMENT_H
+#define CC_PROCESSING_EDGE_REFINEMENT_H
+
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "types/tooth_measurement.h"
+
+namespace cc::processing {
+    // Sub-pixel tooth edges -- the contour points are on the pixel grid, so an edge angle taken from a contour point
+    // is off by up to a pixel along the outline; at lower resolutions that is a large fraction of a tooth.
+
+    // the point between a and b where the distance to the centroid crosses the threshold, interpolated linearly
+    cv::Point2f interpolate_crossing(
+        const cv::Point& a,
+        const cv::Point& b,
+              double     distance_a,
+              double     distance_b,
+              double     threshold
+    );
+
+    // the angle of the strongest luminance edge near angle, searched along the circle of the given radius around
+    // center; the gradient peak is located to a fraction of a pixel with a parabola through it and its neighbours.
+    // Without a clear edge -- too little contrast, the peak at the border of the search range, or the circle leaving
+    // the image -- the angle is returned unchanged. bgr_image must be CV_8UC3.
+    double refine_edge_angle(
+        const cv::Mat&     bgr_image,
+        const cv::Point2f& center,
+              double       radius,
+              double       angle
+    );
+
+    // replaces the starting and ending angles of the teeth (as found by count_teeth) with the interpolated threshold
+    // crossings, refined against source_image when that is a CV_8UC3 image. The transition indices are unchanged.
+    void refine_tooth_edges(
+              std::vector<ToothMeasurement>& teeth,
+        const std::vector<cv::Point>&        contour,
+        const std::vector<double>&           distances,
+              double                         threshold,
+        const cv::Point2f&                   centroid_f,
+        const cv::Mat&                       source_image
+    );
+}
+
+#endif
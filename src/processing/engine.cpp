@@ -0,0 +1,84 @@
+#include "engine.h"
+
+#include <algorithm>
+#include <array>
+
+#include "foreground.h"
+#include "radial_analysis.h"
+
+namespace cc::processing {
+    namespace {
+        // a ContourKernel for the kernels that only measure the contours, and don't look at the source image
+        template <auto Kernel>
+        std::optional<ContourResult> contours_only(
+            const std::vector<std::vector<cv::Point>>& contours,
+            const std::vector<cv::Vec4i>&              hierarchy,
+            const cv::Mat&,
+                  cv::Mat&                             output_image
+        ) {
+            return Kernel(contours, hierarchy, output_image);
+        }
+
+        constexpr std::array k_Engines = {
+            Engine {
+                .m_Name                = "reference",
+                .m_DetermineForeground = &determine_foreground,
+                .m_ProcessContours     = &contours_only<&process_contours>,
+                .m_ProcessMask         = nullptr
+            },
+            Engine {
+                .m_Name                = "buffered",
+                .m_DetermineForeground = &determine_foreground_buffered,
+                .m_ProcessContours     = &contours_only<&process_contours>,
+                .m_ProcessMask         = nullptr
+            },
+            Engine {
+                .m_Name                = "fused",
+                .m_DetermineForeground = &determine_foreground_buffered,
+                .m_ProcessContours     = &contours_only<&process_contours_fused>,
+                .m_ProcessMask         = nullptr
+            },
+            Engine {
+                .m_Name                = "smoothed",
+                .m_DetermineForeground = &determine_foreground_light,
+                .m_ProcessContours     = &contours_only<&process_contours_smoothed>,
+                .m_ProcessMask         = nullptr
+            },
+            Engine {
+                .m_Name                = "subpixel",
+                .m_DetermineForeground = &determine_foreground_buffered,
+                .m_ProcessContours     = &process_contours_subpixel,
+                .m_ProcessMask         = nullptr
+            },
+            Engine {
+                .m_Name                = "polar",
+                .m_DetermineForeground = &determine_foreground_buffered,
+                .m_ProcessContours     = &contours_only<&process_contours_polar>,
+                .m_ProcessMask         = nullptr
+            },
+            Engine {
+                .m_Name                = "polar_mask",
+                .m_DetermineForeground = &determine_foreground_buffered,
+                .m_ProcessContours     = nullptr,
+                .m_ProcessMask         = &process_mask_polar
+            }
+        };
+    }
+
+    std::span<const Engine> get_engines() {
+        return k_Engines;
+    }
+
+    const Engine& get_reference_engine() {
+        return k_Engines.front();
+    }
+
+    const Engine* find_engine(std::string_view name) {
+        auto it = std::ranges::find(k_Engines, name, &Engine::m_Name);
+
+        if (it == k_Engines.end())
+            return nullptr;
+
+        return &*it;
+    }
+}
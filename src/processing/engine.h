@@ -0,0 +1,60 @@
+#ifndef CC_PROCESSING_ENGINE_H
+#define CC_PROCESSING_ENGINE_H
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "contours.h"
+
+namespace cc::processing {
+    using ForegroundKernel = void (*)(
+        const cv::Scalar& selected_color,
+              int         tolerance_range,
+        const cv::Mat&    source_image,
+              cv::Mat&    foreground_mask,
+              cv::Mat&    foreground
+    );
+
+    // source_image is the image the foreground was determined from; output_image holds a copy of it when a kernel
+    // is called, the kernel draws its results into it
+    using ContourKernel = std::optional<ContourResult> (*)(
+        const std::vector<std::vector<cv::Point>>& contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+        const cv::Mat&                             source_image,
+              cv::Mat&                             output_image
+    );
+
+    using MaskKernel = std::optional<ContourResult> (*)(
+        const cv::Mat& foreground_mask,
+              cv::Mat& output_image
+    );
+
+    /*
+     * A complete set of processing kernels, selectable at runtime.
+     *
+     * The reference engine is the original scalar implementation; every other engine must produce the same
+     * foreground mask and tooth count, with angles and radii within a small tolerance (see tests/test_engines.cpp);
+     * engines that resample the contour get a looser one, and the angles of engines that place the edges between
+     * its points are checked against the ground truth of generated gears instead. Engines that denoise the distance
+     * signal instead of the mask blur the foreground less, only their tooth count has to match exactly.
+     *
+     * Exactly one of m_ProcessContours and m_ProcessMask is set; engines with a mask kernel find the outline of the
+     * gear themselves, findContours is skipped for those.
+     */
+    struct Engine {
+        std::string_view m_Name;
+        ForegroundKernel m_DetermineForeground;
+        ContourKernel    m_ProcessContours;
+        MaskKernel       m_ProcessMask;
+    };
+
+    [[nodiscard]] std::span<const Engine> get_engines(); // the reference engine is always the first one
+    [[nodiscard]] const Engine&           get_reference_engine();
+    [[nodiscard]] const Engine*           find_engine(std::string_view name); // nullptr if there is no such engine
+}
+
+#endif
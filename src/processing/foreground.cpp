@@ -1,6 +1,8 @@
 #include "foreground.h"
 #include "types/color_range.h"
 
+#include "util/trace.h"
+
 namespace cc::processing {
     void determine_foreground(
         const cv::Scalar& selected_color,
@@ -9,6 +11,8 @@ namespace cc::processing {
               cv::Mat&    foreground_mask,
               cv::Mat&    foreground
     ) {
+        CC_TRACE_SCOPE("determine_foreground");
+
         foreground_mask = cv::Mat::zeros(source_image.size(), CV_8UC1);
 
         auto [min_rgb, max_rgb] = determine_color_range(selected_color, tolerance_range);
@@ -31,4 +35,75 @@ namespace cc::processing {
             foreground_mask
         );
     }
+
+    namespace {
+        void determine_foreground_blurred(
+            const cv::Scalar& selected_color,
+                  int         tolerance_range,
+                  int         blur_size,
+            const cv::Mat&    source_image,
+                  cv::Mat&    foreground_mask,
+                  cv::Mat&    foreground
+        ) {
+            auto [min_rgb, max_rgb] = determine_color_range(selected_color, tolerance_range);
+
+            // inRange (re)allocates the mask only if needed and writes every pixel, so it doesn't need clearing
+            cv::inRange(
+                source_image,
+                min_rgb,
+                max_rgb,
+                foreground_mask
+            );
+
+            cv::medianBlur(foreground_mask, foreground_mask, blur_size);
+
+            // the masked copy leaves the background pixels untouched, so those do need clearing
+            foreground.create(source_image.size(), CV_8UC3);
+            foreground.setTo(cv::Scalar::all(0));
+
+            cv::copyTo(
+                source_image,
+                foreground,
+                foreground_mask
+            );
+        }
+    }
+
+    void determine_foreground_buffered(
+        const cv::Scalar& selected_color,
+              int         tolerance_range,
+        const cv::Mat&    source_image,
+              cv::Mat&    foreground_mask,
+              cv::Mat&    foreground
+    ) {
+        CC_TRACE_SCOPE("determine_foreground_buffered");
+
+        determine_foreground_blurred(
+            selected_color,
+            tolerance_range,
+            9,
+            source_image,
+            foreground_mask,
+            foreground
+        );
+    }
+
+    void determine_foreground_light(
+        const cv::Scalar& selected_color,
+              int         tolerance_range,
+        const cv::Mat&    source_image,
+              cv::Mat&    foreground_mask,
+              cv::Mat&    foreground
+    ) {
+        CC_TRACE_SCOPE("determine_foreground_light");
+
+        determine_foreground_blurred(
+            selected_color,
+            tolerance_range,
+            5,
+            source_image,
+            foreground_mask,
+            foreground
+        );
+    }
 }
\ No newline at end of file
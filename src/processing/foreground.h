@@ -4,6 +4,7 @@
 #include <opencv2/opencv.hpp>
 
 namespace cc::processing {
+    // reference implementation
     void determine_foreground(
         const cv::Scalar& selected_color,
               int         tolerance_range,
@@ -11,6 +12,28 @@ namespace cc::processing {
               cv::Mat&    foreground_mask,
               cv::Mat&    foreground
     );
+
+    // same result, without clearing the mask before inRange (which writes every pixel anyway). That saves one
+    // full-frame memset; both versions reuse the buffers when they already have the right size and type, assigning
+    // cv::Mat::zeros to a matching cv::Mat doesn't reallocate either
+    void determine_foreground_buffered(
+        const cv::Scalar& selected_color,
+              int         tolerance_range,
+        const cv::Mat&    source_image,
+              cv::Mat&    foreground_mask,
+              cv::Mat&    foreground
+    );
+
+    // determine_foreground_buffered with a 5x5 instead of a 9x9 median blur -- for contour kernels that smooth
+    // the distance signal themselves (see process_contours_smoothed). Up to 5x5 OpenCV uses a sorting network
+    // for the median, larger kernels take the (much slower) histogram based path.
+    void determine_foreground_light(
+        const cv::Scalar& selected_color,
+              int         tolerance_range,
+        const cv::Mat&    source_image,
+              cv::Mat&    foreground_mask,
+              cv::Mat&    foreground
+    );
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,324 @@
+#include "polar_signature.h"
+
+#include "util/trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace cc::processing {
+    namespace {
+        struct RayDirections {
+            RayDirections() {
+                for (size_t i = 0; i < PolarSignature::k_NumBins; ++i) {
+                    m_Cos[i] = static_cast<float>(std::cos(PolarSignature::get_angle(i)));
+                    m_Sin[i] = static_cast<float>(std::sin(PolarSignature::get_angle(i)));
+                }
+            }
+
+            std::array<float, PolarSignature::k_NumBins> m_Cos;
+            std::array<float, PolarSignature::k_NumBins> m_Sin;
+        };
+
+        const RayDirections& get_ray_directions() {
+            static const RayDirections directions;
+            return directions;
+        }
+
+        // any ray number (negative or past a full turn) to its bin
+        size_t to_bin(long long ray) {
+            constexpr auto k_NumBins = static_cast<long long>(PolarSignature::k_NumBins);
+
+            return static_cast<size_t>(((ray % k_NumBins) + k_NumBins) % k_NumBins);
+        }
+
+        float cross(float ax, float ay, float bx, float by) {
+            return ax * by - ay * bx;
+        }
+
+        size_t next(size_t ray) {
+            return (ray + 1 == PolarSignature::k_NumBins) ? 0 : ray + 1;
+        }
+
+        size_t prev(size_t ray) {
+            return (ray == 0) ? PolarSignature::k_NumBins - 1 : ray - 1;
+        }
+
+        // in 6 comparisons; the smallest of 4 values can't be the median of 5, so drop that twice and take the
+        // smallest of the rest
+        float median_of_5(float a, float b, float c, float d, float e) {
+            if (a > b) std::swap(a, b);
+            if (c > d) std::swap(c, d);
+            if (a > c) { std::swap(a, c); std::swap(b, d); }
+
+            a = e;
+
+            if (a > b) std::swap(a, b);
+            if (a > c) { std::swap(a, c); std::swap(b, d); }
+
+            return std::min(b, c);
+        }
+
+        // rays that were missed (radius 0) get the radius of the previous bin, starting after one that was hit
+        // returns false when no ray was hit at all
+        bool fill_missed_rays(std::array<float, PolarSignature::k_NumBins>& radii) {
+            const auto hit = std::ranges::find_if(radii, [](float radius) { return radius > 0.0f; });
+
+            if (hit == radii.end())
+                return false;
+
+            const auto first_hit = static_cast<size_t>(hit - radii.begin());
+
+            for (size_t i = 1; i < PolarSignature::k_NumBins; ++i) {
+                const size_t bin = (first_hit + i) % PolarSignature::k_NumBins;
+
+                if (radii[bin] <= 0.0f)
+                    radii[bin] = radii[prev(bin)];
+            }
+
+            return true;
+        }
+    }
+
+    double PolarSignature::get_angle(size_t bin) {
+        return static_cast<double>(bin) * k_BinWidth;
+    }
+
+    cv::Point2f PolarSignature::get_point(size_t bin) const {
+        const auto& rays = get_ray_directions();
+
+        return cv::Point2f(
+            m_Center.x + m_Radii[bin] * rays.m_Cos[bin],
+            m_Center.y + m_Radii[bin] * rays.m_Sin[bin]
+        );
+    }
+
+    bool resample_polar(
+        const std::vector<cv::Point>& contour,
+        const cv::Point2f&            center,
+              PolarSignature&         signature
+    ) {
+        CC_TRACE_SCOPE("resample_polar");
+
+        constexpr size_t k_NumBins  = PolarSignature::k_NumBins;
+        constexpr size_t k_MaxSteps = k_NumBins / 2; // a segment can't cover more, unless it passes through the center
+
+        const auto& rays = get_ray_directions();
+
+        signature.m_Center = center;
+        signature.m_Radii.fill(0.0f); // 0 marks a ray that didn't hit the contour (yet)
+
+        if (contour.empty())
+            return false;
+
+        auto to_center = [&](const cv::Point& pt) {
+            return cv::Point2f(
+                static_cast<float>(pt.x) - center.x,
+                static_cast<float>(pt.y) - center.y
+            );
+        };
+
+        // > 0 when the ray is counter-clockwise from the point (in increasing angles), 0 when the point is on it
+        auto ray_after = [&](size_t ray, const cv::Point2f& pt) {
+            return cross(pt.x, pt.y, rays.m_Cos[ray], rays.m_Sin[ray]);
+        };
+
+        cv::Point2f a = to_center(contour.back());
+
+        // the sector of a point is the last ray at or before it; only the first one needs an angle, after that
+        // the sector follows the contour one ray at a time
+        size_t sector = to_bin(static_cast<long long>(std::floor(std::atan2(a.y, a.x) / PolarSignature::k_BinWidth)));
+
+        for (size_t step = 0; step < k_MaxSteps && ray_after(sector, a) > 0.0f; ++step)
+            sector = prev(sector);
+
+        for (size_t step = 0; step < k_MaxSteps && ray_after(next(sector), a) <= 0.0f; ++step)
+            sector = next(sector);
+
+        double signed_area = 0.0; // twice the area, positive for counter-clockwise contours
+
+        for (size_t i = 0; i < contour.size(); ++i) {
+            const cv::Point2f b = to_center(contour[i]);
+
+            const float ex = b.x - a.x;
+            const float ey = b.y - a.y;
+
+            // the ray r * d meets a + t * e where r * cross(d, e) == cross(a, e)
+            const float numerator = cross(a.x, a.y, ex, ey);
+
+            auto intersect = [&](size_t ray) {
+                const float denominator = cross(rays.m_Cos[ray], rays.m_Sin[ray], ex, ey);
+
+                // a segment along the ray reaches out as far as its furthest end point
+                const float radius = (std::abs(denominator) > 1e-6f) ?
+                    numerator / denominator :
+                    std::max(std::hypot(a.x, a.y), std::hypot(b.x, b.y));
+
+                signature.m_Radii[ray] = std::max(signature.m_Radii[ray], radius);
+            };
+
+            const float turn = cross(a.x, a.y, b.x, b.y);
+
+            signed_area += turn;
+
+            if (turn >= 0.0f) {
+                // counter-clockwise, the rays after the sector of a up to (and including) b
+                for (size_t step = 0; step < k_MaxSteps && ray_after(next(sector), b) <= 0.0f; ++step) {
+                    sector = next(sector);
+                    intersect(sector);
+                }
+            }
+            else {
+                // clockwise, the rays from the sector of a (a may be on it) back to b
+                for (size_t step = 0; step < k_MaxSteps; ++step) {
+                    const float side = ray_after(sector, b);
+
+                    if (side < 0.0f)
+                        break;
+
+                    intersect(sector);
+
+                    if (side == 0.0f)
+                        break; // b is on this ray, so it's the sector of b
+
+                    sector = prev(sector);
+                }
+            }
+
+            if (i == 0)
+                signature.m_FirstBin = sector;
+
+            a = b;
+        }
+
+        signature.m_Direction = (signed_area < 0.0) ? -1 : 1;
+
+        return fill_missed_rays(signature.m_Radii);
+    }
+
+    bool sample_polar(
+        const cv::Mat&        foreground_mask,
+        const cv::Point2f&    center,
+              float           outer_radius,
+              PolarSignature& signature
+    ) {
+        CC_TRACE_SCOPE("sample_polar");
+
+        constexpr size_t k_NumBins        = PolarSignature::k_NumBins;
+        constexpr size_t k_NumSectors     = 16;   // parallel work items, a sector of rays each
+        constexpr int    k_NumRefinements = 3;    // bisections of the pixel step where the ray enters the foreground
+
+        const auto& rays = get_ray_directions();
+
+        signature.m_Center = center;
+
+        const auto width  = static_cast<float>(foreground_mask.cols);
+        const auto height = static_cast<float>(foreground_mask.rows);
+
+        // the nearest pixel along a ray; truncating is rounding down once the coordinates are known to be positive
+        auto is_foreground = [&](size_t ray, float radius) {
+            const float x = center.x + radius * rays.m_Cos[ray] + 0.5f;
+            const float y = center.y + radius * rays.m_Sin[ray] + 0.5f;
+
+            return
+                x >= 0.0f && x < width &&
+                y >= 0.0f && y < height &&
+                foreground_mask.ptr<uint8_t>(static_cast<int>(y))[static_cast<int>(x)] != 0;
+        };
+
+        std::array<float, k_NumBins> radii; // before the median filter, 0 marks a ray that didn't hit the foreground
+
+        cv::parallel_for_(cv::Range(0, static_cast<int>(k_NumSectors)), [&](const cv::Range& sectors) {
+            const auto first_ray = static_cast<size_t>(sectors.start) * k_NumBins / k_NumSectors;
+            const auto last_ray  = static_cast<size_t>(sectors.end)   * k_NumBins / k_NumSectors;
+
+            for (size_t ray = first_ray; ray < last_ray; ++ray) {
+                // every ray is marched from outer_radius, so foreground anywhere along it is found, whatever the
+                // neighbouring rays hit
+                float inside = outer_radius;
+
+                while (inside > 0.0f && !is_foreground(ray, inside))
+                    inside -= 1.0f;
+
+                if (inside <= 0.0f) {
+                    radii[ray] = 0.0f;
+                    continue;
+                }
+
+                // the edge is somewhere in the last step
+                float outside = inside + 1.0f;
+
+                for (int i = 0; i < k_NumRefinements; ++i) {
+                    const float middle = 0.5f * (inside + outside);
+
+                    if (is_foreground(ray, middle))
+                        inside = middle;
+                    else
+                        outside = middle;
+                }
+
+                // that's the edge of the outermost pixel, a contour runs through its center
+                radii[ray] = std::max(inside - 0.5f, std::numeric_limits<float>::min());
+            }
+        });
+
+        if (!fill_missed_rays(radii))
+            return false;
+
+        for (size_t bin = 0; bin < k_NumBins; ++bin)
+            signature.m_Radii[bin] = median_of_5(
+                radii[prev(prev(bin))],
+                radii[prev(bin)],
+                radii[bin],
+                radii[next(bin)],
+                radii[next(next(bin))]
+            );
+
+        // start at the topmost point (the leftmost one of those), and run like findContours does
+        signature.m_FirstBin  = 0;
+        signature.m_Direction = -1;
+
+        cv::Point2f top = signature.get_point(0);
+
+        for (size_t bin = 1; bin < k_NumBins; ++bin) {
+            const cv::Point2f pt = signature.get_point(bin);
+
+            if (pt.y < top.y || (pt.y == top.y && pt.x < top.x)) {
+                top                  = pt;
+                signature.m_FirstBin = bin;
+            }
+        }
+
+        return true;
+    }
+
+    cv::Point2d find_outline_centroid(const PolarSignature& signature) {
+        // the polygon through the outline points, relative to the center of the signature
+        double twice_area = 0.0;
+        double sum_x      = 0.0;
+        double sum_y      = 0.0;
+
+        cv::Point2d a = signature.get_point(PolarSignature::k_NumBins - 1) - signature.m_Center;
+
+        for (size_t bin = 0; bin < PolarSignature::k_NumBins; ++bin) {
+            const cv::Point2d b = signature.get_point(bin) - signature.m_Center;
+            const double      c = a.x * b.y - a.y * b.x;
+
+            twice_area += c;
+            sum_x      += (a.x + b.x) * c;
+            sum_y      += (a.y + b.y) * c;
+
+            a = b;
+        }
+
+        if (twice_area <= 0.0)
+            return signature.m_Center;
+
+        return cv::Point2d(
+            signature.m_Center.x + sum_x / (3.0 * twice_area),
+            signature.m_Center.y + sum_y / (3.0 * twice_area)
+        );
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef CC_PROCESSING_POLAR_SIGNATURE_H
+#define CC_PROCESSING_POLAR_SIGNATURE_H
+
+#include <array>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+namespace cc::processing {
+    /*
+     * The outline of a gear as its distance from the center at fixed angles -- bin i holds the radius along the ray
+     * at angle i * k_BinWidth. Unlike the contour itself, the size doesn't depend on the camera resolution or on how
+     * findContours spaced the points, so everything downstream runs in constant time and memory.
+     */
+    struct PolarSignature {
+        static constexpr size_t k_NumBins  = 4096;
+        static constexpr double k_BinWidth = 2.0 * std::numbers::pi / k_NumBins; // radians
+
+        std::array<float, k_NumBins> m_Radii;
+        cv::Point2f                  m_Center;
+
+        // the bin of the first contour point and the direction the contour runs in (+1 for increasing angles), so the
+        // signature can be walked in the same order as the contour it came from
+        size_t m_FirstBin  = 0;
+        int    m_Direction = 1;
+
+        [[nodiscard]] static double get_angle(size_t bin); // [0, 2pi)
+
+        [[nodiscard]] cv::Point2f get_point(size_t bin) const; // where the ray of the bin meets the outline
+    };
+
+    // intersects every ray with the contour, where a ray crosses the contour more than once the outermost crossing is
+    // used; rays that miss the contour (the center is outside, or on a gap) get the radius of the previous bin
+    // returns false when no ray hits the contour at all (e.g. an empty contour)
+    bool resample_polar(
+        const std::vector<cv::Point>& contour,
+        const cv::Point2f&            center,
+              PolarSignature&         signature
+    );
+
+    // builds the signature straight from a foreground mask, without tracing a contour first; every ray is marched
+    // inward from outer_radius up to the first foreground pixel, so holes in the gear don't matter (as long as the
+    // outline is closed) and neither do foreground pixels past outer_radius. Clutter between the gear and
+    // outer_radius is part of the outline, on every ray that crosses it. The radii are median filtered over 5
+    // bins to get rid of the single-pixel steps a threshold on the mask would otherwise count as teeth.
+    // The signature starts at the topmost point and runs in decreasing angles, like the outer contours of findContours
+    // returns false when no ray hits the foreground
+    bool sample_polar(
+        const cv::Mat&        foreground_mask,
+        const cv::Point2f&    center,
+              float           outer_radius,
+              PolarSignature& signature
+    );
+
+    // the centroid of the area enclosed by the outline (ignoring any holes, like the moments of an outer contour)
+    [[nodiscard]] cv::Point2d find_outline_centroid(const PolarSignature& signature);
+}
+
+#endif
@@ -0,0 +1,381 @@
+#include "radial_analysis.h"
+
+#include "util/logger.h"
+#include "util/trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace cc::processing {
+    namespace {
+        // same (float) precision as count_teeth, wrapped to [0, 2pi]
+        double angle_of(
+            const cv::Point&   pt,
+            const cv::Point2f& centroid_f
+        ) {
+            double angle = std::atan2f(
+                pt.y - centroid_f.y,
+                pt.x - centroid_f.x
+            );
+
+            if (angle < 0)
+                angle += 2 * std::numbers::pi;
+
+            return angle;
+        }
+
+        // exact for any realistic image size, so comparing against a squared threshold is the same as
+        // comparing the distance against the threshold
+        double squared_radius(
+            const cv::Point&   pt,
+            const cv::Point2i& centroid_i
+        ) {
+            const auto dx = static_cast<int64_t>(pt.x) - centroid_i.x;
+            const auto dy = static_cast<int64_t>(pt.y) - centroid_i.y;
+
+            return static_cast<double>(dx * dx + dy * dy);
+        }
+
+        struct RadiusRange {
+            double m_Min =  std::numeric_limits<double>::max();
+            double m_Max = -std::numeric_limits<double>::max();
+
+            void add(double value) {
+                m_Min = std::min(m_Min, value);
+                m_Max = std::max(m_Max, value);
+            }
+
+            void add(const RadiusRange& other) {
+                m_Min = std::min(m_Min, other.m_Min);
+                m_Max = std::max(m_Max, other.m_Max);
+            }
+        };
+
+        void complete_tooth(
+            ToothMeasurement& measurement,
+            size_t            high_low_idx,
+            double            ending_angle,
+            double            min_distance,
+            double            max_distance
+        ) {
+            measurement.m_HighLowTransitionIdx = high_low_idx;
+            measurement.m_EndingAngle          = ending_angle;
+            measurement.m_MinDistance          = min_distance;
+            measurement.m_MaxDistance          = max_distance;
+
+            LOG_DEBUG(
+                "Tooth {}: angle {:.3f} - {:.3f}, distance {:.1f} - {:.1f}",
+                measurement.m_ToothIdx,
+                measurement.m_StartingAngle,
+                measurement.m_EndingAngle,
+                measurement.m_MinDistance,
+                measurement.m_MaxDistance
+            );
+        }
+
+        /*
+         * Edge detection on a circular radial signal, shared by the contour and the polar signature:
+         * -- value_at(i) is anything that orders like the distance (e.g. the squared distance), threshold is in the
+         *    same unit; to_distance converts it back
+         * -- angle_at(i) is the angle of sample i in [0, 2pi]
+         * -- rising edges of the mask start a tooth, falling edges complete it
+         */
+        template <typename t_ValueFn, typename t_AngleFn, typename t_DistanceFn>
+        std::optional<std::vector<ToothMeasurement>> detect_teeth(
+            size_t       num_samples,
+            double       threshold,
+            t_ValueFn    value_at,
+            t_AngleFn    angle_at,
+            t_DistanceFn to_distance
+        ) {
+            std::vector<ToothMeasurement> teeth;
+
+            auto complete = [&](size_t high_low_idx, const RadiusRange& range) {
+                complete_tooth(
+                    teeth.back(),
+                    high_low_idx,
+                    angle_at(high_low_idx),
+                    to_distance(range.m_Min),
+                    to_distance(range.m_Max)
+                );
+            };
+
+            bool        is_tooth_open = false;
+            RadiusRange tooth_range;
+
+            // the samples up to the first falling edge belong to the tooth that wraps around the end of the signal
+            bool                  is_before_first_edge = true;
+            RadiusRange           wrapped_range;
+            std::optional<size_t> wrapped_high_low_idx;
+
+            double current_value = value_at(0);
+            bool   current_mask  = current_value < threshold;
+
+            for (size_t i = 0; i < num_samples; ++i) {
+                const double next_value = value_at((i + 1 == num_samples) ? 0 : i + 1);
+                const bool   next_mask  = next_value < threshold;
+
+                if (is_tooth_open)
+                    tooth_range.add(current_value);
+                else if (is_before_first_edge)
+                    wrapped_range.add(current_value);
+
+                // at the low->high transition index the distance should still be low, so the tooth starts at the next index
+                if (!current_mask && next_mask) {
+                    ToothMeasurement measurement;
+
+                    measurement.m_LowHighTransitionIdx = i;
+                    measurement.m_ToothIdx             = teeth.size() + 1;
+                    measurement.m_StartingAngle        = angle_at(i);
+
+                    teeth.push_back(measurement);
+
+                    is_tooth_open        = true;
+                    is_before_first_edge = false;
+                    tooth_range          = {};
+                }
+
+                // at the high->low transition index the distance should still be high
+                if (current_mask && !next_mask) {
+                    if (is_tooth_open)
+                        complete(i, tooth_range);
+                    else if (is_before_first_edge)
+                        wrapped_high_low_idx = i;
+
+                    is_tooth_open        = false;
+                    is_before_first_edge = false;
+                }
+
+                current_value = next_value;
+                current_mask  = next_mask;
+            }
+
+            if (teeth.empty()) {
+                LOG_DEBUG("No tooth transitions found in the radial signal");
+                return std::nullopt;
+            }
+
+            // the last tooth is still open when it wraps around; edges alternate, so its end was found before the first tooth
+            if (is_tooth_open && wrapped_high_low_idx) {
+                tooth_range.add(wrapped_range);
+                complete(*wrapped_high_low_idx, tooth_range);
+            }
+
+            return teeth;
+        }
+    }
+
+    std::optional<std::vector<ToothMeasurement>> measure_teeth_fused(
+        const std::vector<cv::Point>& contour,
+        const cv::Point2i&            centroid_i,
+        const cv::Point2f&            centroid_f,
+              RadialDebug*            debug
+    ) {
+        CC_TRACE_SCOPE("measure_teeth_fused");
+
+        const size_t num_points = contour.size();
+
+        if (num_points == 0)
+            return std::nullopt;
+
+        // first pass -- the smallest and largest distance to the center, use half that as a threshold
+        RadiusRange contour_range;
+
+        for (const auto& pt : contour)
+            contour_range.add(squared_radius(pt, centroid_i));
+
+        const double distance_threshold = (std::sqrt(contour_range.m_Min) + std::sqrt(contour_range.m_Max)) / 2.0;
+        const double squared_threshold  = distance_threshold * distance_threshold;
+
+        LOG_DEBUG(
+            "Largest contour: {} points, centroid ({}, {}), distance {:.1f} - {:.1f}, threshold {:.1f}",
+            num_points,
+            centroid_i.x,
+            centroid_i.y,
+            std::sqrt(contour_range.m_Min),
+            std::sqrt(contour_range.m_Max),
+            distance_threshold
+        );
+
+        if (debug) {
+            debug->m_Distances.clear();
+            debug->m_ToothMask.clear();
+
+            for (const auto& pt : contour) {
+                debug->m_Distances.push_back(std::hypot(pt.x - centroid_i.x, pt.y - centroid_i.y));
+                debug->m_ToothMask.push_back((squared_radius(pt, centroid_i) < squared_threshold) ? 1 : 0);
+            }
+        }
+
+        // second pass -- classify every point and detect the edges
+        return detect_teeth(
+            num_points,
+            squared_threshold,
+            [&](size_t i) { return squared_radius(contour[i], centroid_i); },
+            [&](size_t i) { return angle_of(contour[i], centroid_f); },
+            [](double r2) { return std::sqrt(r2); }
+        );
+    }
+
+    std::optional<std::vector<ToothMeasurement>> measure_teeth_polar(const PolarSignature& signature) {
+        CC_TRACE_SCOPE("measure_teeth_polar");
+
+        const auto [min_radius, max_radius] = std::ranges::minmax(signature.m_Radii);
+        const double distance_threshold     = (static_cast<double>(min_radius) + static_cast<double>(max_radius)) / 2.0;
+
+        LOG_DEBUG(
+            "Polar signature: {} bins, distance {:.1f} - {:.1f}, threshold {:.1f}",
+            PolarSignature::k_NumBins,
+            min_radius,
+            max_radius,
+            distance_threshold
+        );
+
+        // walk the bins in the same order as the contour, so the teeth come out in the same order
+        auto to_bin = [&](size_t i) {
+            const auto offset = (signature.m_Direction < 0) ? (PolarSignature::k_NumBins - i) : i;
+            return (signature.m_FirstBin + offset) % PolarSignature::k_NumBins;
+        };
+
+        auto teeth = detect_teeth(
+            PolarSignature::k_NumBins,
+            distance_threshold,
+            [&](size_t i) { return static_cast<double>(signature.m_Radii[to_bin(i)]); },
+            [&](size_t i) { return PolarSignature::get_angle(to_bin(i)); },
+            [](double radius) { return radius; }
+        );
+
+        // report bins rather than positions in the walk
+        if (teeth)
+            for (auto& tooth : *teeth) {
+                tooth.m_LowHighTransitionIdx = to_bin(tooth.m_LowHighTransitionIdx);
+                tooth.m_HighLowTransitionIdx = to_bin(tooth.m_HighLowTransitionIdx);
+            }
+
+        return teeth;
+    }
+
+    std::optional<ContourResult> process_contours_fused(
+        const std::vector<std::vector<cv::Point>>& all_contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    ) {
+        CC_TRACE_SCOPE("process_contours_fused");
+
+        const auto contour = select_largest_contour(all_contours, hierarchy, output_image);
+
+        auto teeth = measure_teeth_fused(
+            contour.m_Points,
+            contour.m_CentroidI,
+            contour.m_CentroidF
+        );
+
+        if (!teeth)
+            return std::nullopt;
+
+        return ContourResult {
+            .m_Teeth            = std::move(*teeth),
+            .m_Centroid         = contour.m_CentroidI,
+            .m_NumContourPoints = contour.m_Points.size()
+        };
+    }
+
+    std::optional<ContourResult> process_contours_polar(
+        const std::vector<std::vector<cv::Point>>& all_contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    ) {
+        CC_TRACE_SCOPE("process_contours_polar");
+
+        const auto contour = select_largest_contour(all_contours, hierarchy, output_image);
+
+        PolarSignature signature; // fixed size, lives on the stack
+
+        // around the same (integer) center as the distances of the reference implementation
+        if (!resample_polar(contour.m_Points, contour.m_CentroidI, signature))
+            return std::nullopt;
+
+        auto teeth = measure_teeth_polar(signature);
+
+        if (!teeth)
+            return std::nullopt;
+
+        return ContourResult {
+            .m_Teeth            = std::move(*teeth),
+            .m_Centroid         = contour.m_CentroidI,
+            .m_NumContourPoints = contour.m_Points.size()
+        };
+    }
+
+    std::optional<ContourResult> process_mask_polar(
+        const cv::Mat& foreground_mask,
+              cv::Mat& output_image
+    ) {
+        CC_TRACE_SCOPE("process_mask_polar");
+
+        // https://docs.opencv.org/4.x/d3/dc0/group__imgproc__shape.html#ga556a180f43cab22649c23ada36a8a139
+        auto moment = cv::moments(foreground_mask, true);
+
+        if (moment.m00 <= 0.0)
+            return std::nullopt;
+
+        const cv::Point2f estimate(
+            static_cast<float>(moment.m10 / moment.m00),
+            static_cast<float>(moment.m01 / moment.m00)
+        );
+
+        // the radius of gyration of a disc is 0.7 times its radius, twice that is well past the tips of any gear
+        const auto outer_radius = static_cast<float>(2.0 * std::sqrt((moment.mu20 + moment.mu02) / moment.m00));
+
+        PolarSignature signature; // fixed size, lives on the stack
+
+        if (!sample_polar(foreground_mask, estimate, outer_radius, signature))
+            return std::nullopt;
+
+        // holes in the gear (and specks elsewhere) pull the centroid of the mask aside; the outline isn't affected,
+        // so sample once more around its centroid -- truncated, like the one of the reference implementation
+        const cv::Point2d centroid_d = find_outline_centroid(signature);
+
+        const cv::Point2i centroid_i(
+            static_cast<int>(centroid_d.x),
+            static_cast<int>(centroid_d.y)
+        );
+
+        if (!sample_polar(foreground_mask, centroid_i, outer_radius, signature))
+            return std::nullopt;
+
+        std::vector<cv::Point> outline;
+        outline.reserve(PolarSignature::k_NumBins);
+
+        for (size_t bin = 0; bin < PolarSignature::k_NumBins; ++bin) {
+            const cv::Point2f pt = signature.get_point(bin);
+
+            outline.emplace_back(
+                static_cast<int>(std::lround(pt.x)),
+                static_cast<int>(std::lround(pt.y))
+            );
+        }
+
+        cv::polylines(
+            output_image,
+            outline,
+            true, // closed
+            cv::Scalar(0, 0, 255),
+            1,
+            cv::LINE_8
+        );
+
+        auto teeth = measure_teeth_polar(signature);
+
+        if (!teeth)
+            return std::nullopt;
+
+        return ContourResult {
+            .m_Teeth            = std::move(*teeth),
+            .m_Centroid         = centroid_i,
+            .m_NumContourPoints = PolarSignature::k_NumBins
+        };
+    }
+}
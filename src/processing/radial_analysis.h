@@ -0,0 +1,68 @@
+#ifndef CC_PROCESSING_RADIAL_ANALYSIS_H
+#define CC_PROCESSING_RADIAL_ANALYSIS_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "contours.h"
+#include "polar_signature.h"
+
+#include "types/tooth_measurement.h"
+
+namespace cc::processing {
+    // the intermediate signals of the reference implementation, only produced on request
+    struct RadialDebug {
+        std::vector<double>  m_Distances; // to the (integer) centroid, per contour point
+        std::vector<uint8_t> m_ToothMask; // 1 where the distance is below the threshold
+    };
+
+    /*
+     * Fused version of the distances -> tooth mask -> find_tooth_start -> count_teeth sequence in process_contours,
+     * with the same results (up to rounding) in two streaming passes over the contour and no intermediate vectors:
+     * -- the first pass finds the range of the squared radii, which sets the threshold
+     * -- the second pass classifies every point, detects the edges and tracks the min/max radius of the open tooth
+     *
+     * The tooth that wraps around the end of the contour is completed with the points before the first edge.
+     * nullopt when the contour never crosses the threshold.
+     */
+    std::optional<std::vector<ToothMeasurement>> measure_teeth_fused(
+        const std::vector<cv::Point>& contour,
+        const cv::Point2i&            centroid_i,
+        const cv::Point2f&            centroid_f,
+              RadialDebug*            debug = nullptr
+    );
+
+    /*
+     * The same edge detection on a polar signature -- the cost no longer depends on the length of the contour.
+     * The bins are walked in the direction of the original contour starting at its first point, so the teeth are
+     * reported in the same order as by the contour based versions; the transition indices are bins instead of
+     * contour indices. nullopt when the signature never crosses the threshold.
+     */
+    std::optional<std::vector<ToothMeasurement>> measure_teeth_polar(const PolarSignature& signature);
+
+    // process_contours with measure_teeth_fused
+    std::optional<ContourResult> process_contours_fused(
+        const std::vector<std::vector<cv::Point>>& contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    );
+
+    // process_contours with the largest contour resampled to a polar signature
+    std::optional<ContourResult> process_contours_polar(
+        const std::vector<std::vector<cv::Point>>& contours,
+        const std::vector<cv::Vec4i>&              hierarchy,
+              cv::Mat&                             output_image
+    );
+
+    // the same measurement straight from the foreground mask, without findContours (see sample_polar); the gear is
+    // found around the centroid of the whole mask, so it should be the only sizeable thing in it
+    std::optional<ContourResult> process_mask_polar(
+        const cv::Mat& foreground_mask,
+              cv::Mat& output_image
+    );
+}
+
+#endif
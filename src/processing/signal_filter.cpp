@@ -0,0 +1,68 @@
+#include "signal_filter.h"
+
+#include <algorithm>
+
+namespace cc::processing {
+    void median_filter(
+        std::span<const double> signal,
+        size_t                  window_size,
+        std::vector<double>&    result
+    ) {
+        const size_t n = signal.size();
+
+        result.resize(n);
+
+        if (n == 0)
+            return;
+
+        const size_t half = window_size / 2;
+
+        std::vector<double> window(2 * half + 1);
+
+        for (size_t i = 0; i < n; ++i) {
+            const size_t first = (i + n - half % n) % n;
+
+            for (size_t j = 0; j < window.size(); ++j)
+                window[j] = signal[(first + j) % n];
+
+            std::ranges::nth_element(window, window.begin() + half);
+
+            result[i] = window[half];
+        }
+    }
+
+    void threshold_hysteresis(
+        std::span<const double> signal,
+        double                  low,
+        double                  high,
+        std::vector<uint8_t>&   mask
+    ) {
+        mask.resize(signal.size());
+
+        if (signal.empty())
+            return;
+
+        // the state at the end of the signal, which is where the start continues from
+        auto last_outside = std::ranges::find_if(
+            signal.rbegin(),
+            signal.rend(),
+            [=](double value) { return value < low || value > high; }
+        );
+
+        uint8_t state;
+
+        if (last_outside != signal.rend())
+            state = (*last_outside < low) ? 1 : 0;
+        else
+            state = (signal.front() < 0.5 * (low + high)) ? 1 : 0;
+
+        for (size_t i = 0; i < signal.size(); ++i) {
+            if (signal[i] < low)
+                state = 1;
+            else if (signal[i] > high)
+                state = 0;
+
+            mask[i] = state;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef CC_PROCESSING_SIGNAL_FILTER_H
+#define CC_PROCESSING_SIGNAL_FILTER_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace cc::processing {
+    // 1D filters for the distance signal along a (closed) contour, so every signal wraps around
+
+    // median over window_size samples centered on each sample (window_size should be odd)
+    // result is resized to the size of the signal, and may not alias it
+    void median_filter(
+        std::span<const double> signal,
+        size_t                  window_size,
+        std::vector<double>&    result
+    );
+
+    // 1 where the signal drops below low, 0 where it rises above high; in between a sample keeps the state of the one
+    // before it, so noise within the band can't toggle the mask. The signal wraps around, so the first samples continue
+    // from the state at the end. A signal that never leaves the band gets a constant mask, from the middle of the band
+    void threshold_hysteresis(
+        std::span<const double> signal,
+        double                  low,
+        double                  high,
+        std::vector<uint8_t>&   mask
+    );
+}
+
+#endif
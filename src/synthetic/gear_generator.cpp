@@ -0,0 +1,368 @@
+#include "gear_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <numbers>
+#include <random>
+
+namespace {
+    using cc::synthetic::GearSpec;
+
+    // tooth profile, as a fraction of the angular pitch measured from the tooth center
+    constexpr double k_TipHalfWidth  = 0.15;
+    constexpr double k_RootHalfWidth = 0.25;
+    constexpr double k_FlankCenter   = (k_TipHalfWidth + k_RootHalfWidth) / 2.0;
+
+    constexpr double k_FitRatio      = 0.4;  // tip diameter relative to the smallest image dimension
+    constexpr double k_BrokenHeight  = 0.5;  // remaining tooth height of a broken tooth
+    constexpr int    k_SubpixelShift = 4;    // fractional bits used when rasterizing the outline
+
+    enum class e_ToothState: uint8_t {
+        intact,
+        missing,
+        broken
+    };
+
+    // derived from a (validated) GearSpec
+    struct GearGeometry {
+        cv::Point2d m_Center;
+        double      m_Module;
+        double      m_TipRadius;
+        double      m_RootRadius;
+        double      m_Pitch;     // radians per tooth
+        double      m_AxisRatio; // vertical scale due to eccentricity
+
+        std::vector<e_ToothState> m_ToothStates;
+    };
+
+    GearGeometry make_geometry(const GearSpec& spec) {
+        GearGeometry result;
+
+        const double num_teeth = static_cast<double>(spec.m_NumTeeth);
+        const double min_size  = std::min(spec.m_Resolution.m_Width, spec.m_Resolution.m_Height);
+
+        result.m_Module = (spec.m_Module > 0.0) ?
+            spec.m_Module :
+            k_FitRatio * min_size / (num_teeth / 2.0 + 1.0);
+
+        result.m_Center = cv::Point2d(
+            spec.m_Resolution.m_Width  / 2.0,
+            spec.m_Resolution.m_Height / 2.0
+        ) + spec.m_CenterOffset;
+
+        result.m_TipRadius  = result.m_Module * (num_teeth / 2.0 + 1.0);  // addendum
+        result.m_RootRadius = result.m_Module * (num_teeth / 2.0 - 1.25); // dedendum
+        result.m_Pitch      = 2.0 * std::numbers::pi / num_teeth;
+        result.m_AxisRatio  = std::sqrt(1.0 - spec.m_Eccentricity * spec.m_Eccentricity);
+
+        result.m_ToothStates.assign(spec.m_NumTeeth, e_ToothState::intact);
+
+        for (int idx : spec.m_BrokenTeeth)
+            result.m_ToothStates[idx] = e_ToothState::broken;
+
+        for (int idx : spec.m_MissingTeeth)
+            result.m_ToothStates[idx] = e_ToothState::missing; // missing takes precedence
+
+        return result;
+    }
+
+    // distance from the center at a given angle, in the (circular) frame of the gear
+    double gear_radius(
+        const GearSpec&     spec,
+        const GearGeometry& geometry,
+        double              angle
+    ) {
+        double teeth   = (angle - spec.m_Rotation) / geometry.m_Pitch;
+        double nearest = std::round(teeth);
+        double offset  = std::abs(teeth - nearest); // [0, 0.5] of the pitch from the nearest tooth center
+
+        int num_teeth = spec.m_NumTeeth;
+        int idx       = ((static_cast<int>(nearest) % num_teeth) + num_teeth) % num_teeth;
+
+        double tip_radius = geometry.m_TipRadius;
+
+        switch (geometry.m_ToothStates[idx]) {
+            case e_ToothState::missing: return geometry.m_RootRadius;
+            case e_ToothState::broken:
+                tip_radius = geometry.m_RootRadius + k_BrokenHeight * (geometry.m_TipRadius - geometry.m_RootRadius);
+                break;
+
+            default:
+                break;
+        }
+
+        if (offset <= k_TipHalfWidth)
+            return tip_radius;
+
+        if (offset >= k_RootHalfWidth)
+            return geometry.m_RootRadius;
+
+        // linear flank
+        double t = (offset - k_TipHalfWidth) / (k_RootHalfWidth - k_TipHalfWidth);
+        return tip_radius + t * (geometry.m_RootRadius - tip_radius);
+    }
+
+    cv::Point2d to_image(
+        const GearGeometry& geometry,
+        double              radius,
+        double              angle
+    ) {
+        return {
+            geometry.m_Center.x + radius * std::cos(angle),
+            geometry.m_Center.y + radius * std::sin(angle) * geometry.m_AxisRatio
+        };
+    }
+
+    // angle of an image point as seen from the gear center, wrapped to [0, 2pi)
+    double image_angle(const GearGeometry& geometry, const cv::Point2d& pt) {
+        double angle = std::atan2(pt.y - geometry.m_Center.y, pt.x - geometry.m_Center.x);
+
+        if (angle < 0)
+            angle += 2.0 * std::numbers::pi;
+
+        return angle;
+    }
+
+    std::vector<cv::Point2d> make_outline(
+        const GearSpec&     spec,
+        const GearGeometry& geometry,
+        size_t              num_points
+    ) {
+        std::vector<cv::Point2d> result;
+        result.reserve(num_points);
+
+        for (size_t i = 0; i < num_points; ++i) {
+            double angle = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(num_points);
+            result.push_back(to_image(geometry, gear_radius(spec, geometry, angle), angle));
+        }
+
+        return result;
+    }
+
+    // a color that is clearly distinguishable from the gear, so that clutter doesn't become foreground
+    cv::Scalar make_clutter_color(const cv::Scalar& gear_color, std::mt19937& generator) {
+        std::uniform_int_distribution<int> channel(0, 255);
+
+        while (true) {
+            cv::Scalar color(channel(generator), channel(generator), channel(generator));
+
+            double max_difference = 0.0;
+            for (int i = 0; i < 3; ++i)
+                max_difference = std::max(max_difference, std::abs(color[i] - gear_color[i]));
+
+            if (max_difference > 64.0)
+                return color;
+        }
+    }
+
+    void draw_clutter(const GearSpec& spec, cv::Mat& image) {
+        std::mt19937 generator(spec.m_Seed);
+
+        std::uniform_int_distribution<int> x_distribution(0, spec.m_Resolution.m_Width  - 1);
+        std::uniform_int_distribution<int> y_distribution(0, spec.m_Resolution.m_Height - 1);
+        std::uniform_int_distribution<int> shape_distribution(0, 2);
+
+        const int max_size = std::max(2, std::min(spec.m_Resolution.m_Width, spec.m_Resolution.m_Height) / 8);
+        std::uniform_int_distribution<int> size_distribution(1, max_size);
+
+        for (int i = 0; i < spec.m_NumClutter; ++i) {
+            cv::Point  origin(x_distribution(generator), y_distribution(generator));
+            cv::Scalar color = make_clutter_color(spec.m_GearColor, generator);
+            int        size  = size_distribution(generator);
+
+            switch (shape_distribution(generator)) {
+                case 0:
+                    cv::rectangle(image, origin, origin + cv::Point(size, size_distribution(generator)), color, cv::FILLED);
+                    break;
+
+                case 1:
+                    cv::circle(image, origin, size / 2, color, cv::FILLED, cv::LINE_AA);
+                    break;
+
+                default:
+                    cv::line(image, origin, cv::Point(x_distribution(generator), y_distribution(generator)), color, 1 + size / 16, cv::LINE_AA);
+                    break;
+            }
+        }
+    }
+
+    void add_noise(const GearSpec& spec, cv::Mat& image) {
+        cv::Mat noise(image.size(), CV_16SC3);
+        cv::RNG rng(spec.m_Seed);
+
+        rng.fill(noise, cv::RNG::NORMAL, 0.0, spec.m_NoiseSigma);
+
+        cv::Mat widened;
+        image.convertTo(widened, CV_16SC3);
+        widened += noise;
+        widened.convertTo(image, CV_8UC3); // saturates
+    }
+}
+
+namespace cc::synthetic {
+    size_t GearGroundTruth::get_num_teeth() const {
+        return m_Teeth.size();
+    }
+
+    GeneratorError::GeneratorError(const std::string& message):
+        std::invalid_argument(message)
+    {
+    }
+
+    void validate(const GearSpec& spec) {
+        const auto& [width, height] = spec.m_Resolution;
+
+        if (width <= 0 || height <= 0 || width > k_MaxResolution.m_Width || height > k_MaxResolution.m_Height)
+            throw GeneratorError(std::format("Resolution {} is outside of [1 x 1] .. {}", spec.m_Resolution, k_MaxResolution));
+
+        if (spec.m_NumTeeth < k_MinNumTeeth || spec.m_NumTeeth > k_MaxNumTeeth)
+            throw GeneratorError(std::format("Number of teeth {} is outside of [{}, {}]", spec.m_NumTeeth, k_MinNumTeeth, k_MaxNumTeeth));
+
+        if (spec.m_Module < 0.0)
+            throw GeneratorError(std::format("Module {} is negative", spec.m_Module));
+
+        if (spec.m_Eccentricity < 0.0 || spec.m_Eccentricity >= 1.0)
+            throw GeneratorError(std::format("Eccentricity {} is outside of [0, 1)", spec.m_Eccentricity));
+
+        if (spec.m_BoreRatio < 0.0 || spec.m_BoreRatio >= 1.0)
+            throw GeneratorError(std::format("Bore ratio {} is outside of [0, 1)", spec.m_BoreRatio));
+
+        if (spec.m_NoiseSigma < 0.0 || spec.m_BlurRadius < 0 || spec.m_NumClutter < 0)
+            throw GeneratorError("Noise, blur and clutter cannot be negative");
+
+        auto is_valid_tooth = [&](int idx) {
+            return idx >= 0 && idx < spec.m_NumTeeth;
+        };
+
+        if (!std::ranges::all_of(spec.m_MissingTeeth, is_valid_tooth) ||
+            !std::ranges::all_of(spec.m_BrokenTeeth,  is_valid_tooth)
+        )
+            throw GeneratorError(std::format("Tooth indices must be in [0, {})", spec.m_NumTeeth));
+    }
+
+    GearGroundTruth make_ground_truth(const GearSpec& spec) {
+        validate(spec);
+
+        auto geometry = make_geometry(spec);
+
+        GearGroundTruth result {
+            .m_Center     = geometry.m_Center,
+            .m_Module     = geometry.m_Module,
+            .m_TipRadius  = geometry.m_TipRadius,
+            .m_RootRadius = geometry.m_RootRadius,
+            .m_Teeth      = {}
+        };
+
+        for (int i = 0; i < spec.m_NumTeeth; ++i) {
+            if (geometry.m_ToothStates[i] == e_ToothState::missing)
+                continue;
+
+            double tooth_center = spec.m_Rotation + i * geometry.m_Pitch;
+            double half_height  = (gear_radius(spec, geometry, tooth_center) + geometry.m_RootRadius) / 2.0;
+
+            auto start = to_image(geometry, half_height, tooth_center - k_FlankCenter * geometry.m_Pitch);
+            auto end   = to_image(geometry, half_height, tooth_center + k_FlankCenter * geometry.m_Pitch);
+
+            result.m_Teeth.push_back(GroundTruthTooth {
+                .m_ToothIdx      = i,
+                .m_StartingAngle = image_angle(geometry, start),
+                .m_EndingAngle   = image_angle(geometry, end),
+                .m_IsBroken      = (geometry.m_ToothStates[i] == e_ToothState::broken)
+            });
+        }
+
+        return result;
+    }
+
+    std::vector<cv::Point2d> make_gear_outline(const GearSpec& spec, size_t num_points) {
+        validate(spec);
+
+        return make_outline(spec, make_geometry(spec), num_points);
+    }
+
+    std::vector<cv::Point> make_gear_contour(const GearSpec& spec, size_t num_points) {
+        auto outline = make_gear_outline(spec, num_points);
+
+        std::vector<cv::Point> result;
+        result.reserve(outline.size());
+
+        for (const auto& pt : outline)
+            result.emplace_back(
+                static_cast<int>(std::lround(pt.x)),
+                static_cast<int>(std::lround(pt.y))
+            );
+
+        return result;
+    }
+
+    SyntheticGear generate_gear(const GearSpec& spec) {
+        SyntheticGear result {
+            .m_Image = {},
+            .m_Truth = make_ground_truth(spec) // validates
+        };
+
+        auto geometry = make_geometry(spec);
+
+        auto& image = result.m_Image;
+        image.create(spec.m_Resolution.m_Height, spec.m_Resolution.m_Width, CV_8UC3);
+        image.setTo(spec.m_BackgroundColor);
+
+        if (spec.m_NumClutter > 0)
+            draw_clutter(spec, image);
+
+        // sample the outline at roughly 4 points per pixel along the tip circle, so the corners stay sharp
+        auto num_points = static_cast<size_t>(std::max(4096.0, 8.0 * std::numbers::pi * geometry.m_TipRadius));
+        auto outline    = make_outline(spec, geometry, num_points);
+
+        std::vector<cv::Point> polygon;
+        polygon.reserve(outline.size());
+
+        constexpr double k_Scale = 1 << k_SubpixelShift;
+
+        for (const auto& pt : outline)
+            polygon.emplace_back(
+                static_cast<int>(std::lround(pt.x * k_Scale)),
+                static_cast<int>(std::lround(pt.y * k_Scale))
+            );
+
+        cv::fillPoly(
+            image,
+            std::vector<std::vector<cv::Point>>{ std::move(polygon) },
+            spec.m_GearColor,
+            cv::LINE_AA,
+            k_SubpixelShift
+        );
+
+        if (spec.m_BoreRatio > 0.0) {
+            double bore_radius = spec.m_BoreRatio * geometry.m_RootRadius;
+
+            cv::ellipse(
+                image,
+                cv::Point(
+                    static_cast<int>(std::lround(geometry.m_Center.x * k_Scale)),
+                    static_cast<int>(std::lround(geometry.m_Center.y * k_Scale))
+                ),
+                cv::Size(
+                    static_cast<int>(std::lround(bore_radius * k_Scale)),
+                    static_cast<int>(std::lround(bore_radius * geometry.m_AxisRatio * k_Scale))
+                ),
+                0.0,
+                0.0,
+                360.0,
+                spec.m_BackgroundColor,
+                cv::FILLED,
+                cv::LINE_AA,
+                k_SubpixelShift
+            );
+        }
+
+        if (spec.m_BlurRadius > 0)
+            cv::GaussianBlur(image, image, cv::Size(2 * spec.m_BlurRadius + 1, 2 * spec.m_BlurRadius + 1), 0.0);
+
+        if (spec.m_NoiseSigma > 0.0)
+            add_noise(spec, image);
+
+        return result;
+    }
+}
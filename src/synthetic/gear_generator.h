@@ -0,0 +1,87 @@
+#ifndef CC_SYNTHETIC_GEAR_GENERATOR_H
+#define CC_SYNTHETIC_GEAR_GENERATOR_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "types/resolution.h"
+
+namespace cc::synthetic {
+    inline constexpr int        k_MinNumTeeth   = 8;
+    inline constexpr int        k_MaxNumTeeth   = 500;
+    inline constexpr Resolution k_MaxResolution = { 7680, 4320 }; // 8K UHD
+
+    /*
+     * Parameters of a synthetic gear image
+     *
+     * The tooth profile is a symmetric trapezoid rather than an involute; addendum and dedendum follow
+     * the usual proportions (1.0 and 1.25 times the module). All randomness (noise, clutter) derives from
+     * m_Seed, so the same specification always produces the same image.
+     */
+    struct GearSpec {
+        Resolution  m_Resolution      = { 1280, 720 };
+        int         m_NumTeeth        = 24;              // [k_MinNumTeeth, k_MaxNumTeeth]
+        double      m_Module          = 0.0;             // pitch diameter per tooth in pixels; 0 fits the gear to the image
+        cv::Point2d m_CenterOffset    = { 0.0, 0.0 };    // from the image center, in pixels
+        double      m_Rotation        = 0.0;             // radians, of the first tooth center
+        double      m_Eccentricity    = 0.0;             // [0, 1); squashes the gear vertically into an ellipse
+        double      m_BoreRatio       = 0.3;             // radius of the center hole relative to the root radius
+
+        std::vector<int> m_MissingTeeth;                 // indices of teeth that are removed entirely
+        std::vector<int> m_BrokenTeeth;                  // indices of teeth that are broken off halfway
+
+        cv::Scalar  m_GearColor       = { 40, 160, 220 };
+        cv::Scalar  m_BackgroundColor = { 96, 96, 96 };
+        double      m_NoiseSigma      = 0.0;             // standard deviation of additive gaussian noise
+        int         m_BlurRadius      = 0;               // gaussian blur with a (2r + 1) kernel
+        int         m_NumClutter      = 0;               // random shapes in the background
+
+        uint32_t    m_Seed            = 1;
+    };
+
+    struct GroundTruthTooth {
+        int    m_ToothIdx;      // position on the gear, including missing teeth
+        double m_StartingAngle; // radians in [0, 2pi), as seen from the center in image coordinates
+        double m_EndingAngle;   // (at half tooth height, which is where the pipeline thresholds)
+        bool   m_IsBroken;
+    };
+
+    struct GearGroundTruth {
+        cv::Point2d                   m_Center;
+        double                        m_Module;
+        double                        m_TipRadius;  // before eccentricity
+        double                        m_RootRadius; // before eccentricity
+        std::vector<GroundTruthTooth> m_Teeth;      // in angular order, missing teeth excluded
+
+        [[nodiscard]] size_t get_num_teeth() const;
+    };
+
+    struct SyntheticGear {
+        cv::Mat         m_Image; // CV_8UC3
+        GearGroundTruth m_Truth;
+    };
+
+    class GeneratorError:
+        public std::invalid_argument
+    {
+    public:
+        explicit GeneratorError(const std::string& message);
+    };
+
+    // throws GeneratorError when the specification is out of range
+    void validate(const GearSpec& spec);
+
+    [[nodiscard]] GearGroundTruth make_ground_truth(const GearSpec& spec);
+
+    // outer boundary of the gear in image coordinates, sampled at num_points equally spaced angles
+    [[nodiscard]] std::vector<cv::Point2d> make_gear_outline(const GearSpec& spec, size_t num_points);
+    [[nodiscard]] std::vector<cv::Point>   make_gear_contour(const GearSpec& spec, size_t num_points); // rounded
+
+    [[nodiscard]] SyntheticGear generate_gear(const GearSpec& spec);
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "tooth_anomaly.h"
+#include <format>
 #include <ostream>
 
 namespace cc {
@@ -14,6 +15,15 @@ namespace cc {
         return os;
     }
 
+    std::ostream& operator << (
+        std::ostream&            os,
+        const ToothAnomalyScore& tas
+    ) {
+        os << std::format("ToothAnomalyScore: arc {:.2f} gap {:.2f}", tas.m_Arc, tas.m_Gap);
+
+        return os;
+    }
+
     std::vector<uint8_t> create_anomaly_mask(size_t num_elements) {
         return std::vector<uint8_t>(num_elements, ToothAnomaly::none);
     }
@@ -14,6 +14,14 @@ namespace cc {
         arc  = 0x1 << 2
     };
 
+    // robust z-scores -- distance from the median in (MAD-estimated) standard deviations
+    struct ToothAnomalyScore {
+        double m_Arc = 0.0; // the arc of the tooth itself
+        double m_Gap = 0.0; // the arc between this tooth and the next
+
+        friend std::ostream& operator << (std::ostream& os, const ToothAnomalyScore& tas);
+    };
+
     std::vector<uint8_t> create_anomaly_mask(size_t num_elements);
 
     std::ostream& operator << (std::ostream& os, const ToothAnomaly& ta);
@@ -0,0 +1,170 @@
+#include "allocation_tracker.h"
+
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+namespace {
+    // must not need dynamic initialization; operator new may run before main and during thread exit
+    constinit thread_local cc::util::AllocationStats t_Stats;
+}
+
+namespace cc::util {
+    AllocationStats& AllocationStats::operator += (const AllocationStats& other) {
+        m_NumAllocations   += other.m_NumAllocations;
+        m_NumDeallocations += other.m_NumDeallocations;
+        m_NumBytes         += other.m_NumBytes;
+
+        return *this;
+    }
+
+    AllocationStats operator - (const AllocationStats& a, const AllocationStats& b) {
+        return {
+            .m_NumAllocations   = a.m_NumAllocations   - b.m_NumAllocations,
+            .m_NumDeallocations = a.m_NumDeallocations - b.m_NumDeallocations,
+            .m_NumBytes         = a.m_NumBytes         - b.m_NumBytes
+        };
+    }
+
+    std::ostream& operator << (std::ostream& os, const AllocationStats& stats) {
+        os
+            << stats.m_NumAllocations   << " allocations ("
+            << stats.m_NumBytes         << " bytes), "
+            << stats.m_NumDeallocations << " deallocations";
+
+        return os;
+    }
+
+    AllocationStats get_thread_allocation_stats() {
+        return t_Stats;
+    }
+
+    AllocationProbe::AllocationProbe():
+        m_Start(t_Stats)
+    {
+    }
+
+    AllocationStats AllocationProbe::get() const {
+        return t_Stats - m_Start;
+    }
+
+    void AllocationProbe::reset() {
+        m_Start = t_Stats;
+    }
+}
+
+#ifdef CC_ENABLE_ALLOCATION_TRACKING
+    // Replacement of the global allocation functions, the throwing and the nothrow variants.
+    // This lives in the same translation unit as the probe, so linking against the probe pulls it in.
+    namespace {
+        void* tracked_allocate(std::size_t size) {
+            ++t_Stats.m_NumAllocations;
+            t_Stats.m_NumBytes += size;
+
+            if (void* ptr = std::malloc(size ? size : 1))
+                return ptr;
+
+            throw std::bad_alloc();
+        }
+
+        void* tracked_allocate_aligned(std::size_t size, std::align_val_t alignment) {
+            ++t_Stats.m_NumAllocations;
+            t_Stats.m_NumBytes += size;
+
+            auto align = static_cast<std::size_t>(alignment);
+
+#ifdef _WIN32
+            void* ptr = _aligned_malloc(size ? size : 1, align);
+#else
+            // aligned_alloc requires the size to be a multiple of the alignment
+            void* ptr = std::aligned_alloc(align, ((size ? size : 1) + align - 1) / align * align);
+#endif
+
+            if (ptr)
+                return ptr;
+
+            throw std::bad_alloc();
+        }
+
+        void tracked_deallocate(void* ptr) noexcept {
+            if (!ptr)
+                return;
+
+            ++t_Stats.m_NumDeallocations;
+            std::free(ptr);
+        }
+
+        void tracked_deallocate_aligned(void* ptr) noexcept {
+            if (!ptr)
+                return;
+
+            ++t_Stats.m_NumDeallocations;
+
+#ifdef _WIN32
+            _aligned_free(ptr);
+#else
+            std::free(ptr);
+#endif
+        }
+    }
+
+    void* operator new  (std::size_t size) { return tracked_allocate(size); }
+    void* operator new[](std::size_t size) { return tracked_allocate(size); }
+
+    void* operator new  (std::size_t size, std::align_val_t alignment) { return tracked_allocate_aligned(size, alignment); }
+    void* operator new[](std::size_t size, std::align_val_t alignment) { return tracked_allocate_aligned(size, alignment); }
+
+    // the default nothrow versions would forward to the ones above, but sanitizers intercept them separately, so
+    // memory from a nothrow new (e.g. the temporary buffer of std::stable_sort) would be freed by the wrong allocator
+    void* operator new  (std::size_t size, const std::nothrow_t&) noexcept {
+        try {
+            return tracked_allocate(size);
+        }
+        catch (std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+
+    void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+        try {
+            return tracked_allocate(size);
+        }
+        catch (std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+
+    void* operator new  (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+        try {
+            return tracked_allocate_aligned(size, alignment);
+        }
+        catch (std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+
+    void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+        try {
+            return tracked_allocate_aligned(size, alignment);
+        }
+        catch (std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+
+    void operator delete  (void* ptr, const std::nothrow_t&) noexcept { tracked_deallocate(ptr); }
+    void operator delete[](void* ptr, const std::nothrow_t&) noexcept { tracked_deallocate(ptr); }
+
+    void operator delete  (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_deallocate_aligned(ptr); }
+    void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_deallocate_aligned(ptr); }
+
+    void operator delete  (void* ptr) noexcept              { tracked_deallocate(ptr); }
+    void operator delete[](void* ptr) noexcept              { tracked_deallocate(ptr); }
+    void operator delete  (void* ptr, std::size_t) noexcept { tracked_deallocate(ptr); }
+    void operator delete[](void* ptr, std::size_t) noexcept { tracked_deallocate(ptr); }
+
+    void operator delete  (void* ptr, std::align_val_t) noexcept              { tracked_deallocate_aligned(ptr); }
+    void operator delete[](void* ptr, std::align_val_t) noexcept              { tracked_deallocate_aligned(ptr); }
+    void operator delete  (void* ptr, std::size_t, std::align_val_t) noexcept { tracked_deallocate_aligned(ptr); }
+    void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { tracked_deallocate_aligned(ptr); }
+#endif
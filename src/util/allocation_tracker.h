@@ -0,0 +1,51 @@
+#ifndef CC_UTIL_ALLOCATION_TRACKER_H
+#define CC_UTIL_ALLOCATION_TRACKER_H
+
+#include <cstdint>
+#include <iosfwd>
+
+namespace cc::util {
+    /*
+     * Heap allocation counters, kept per thread by a replacement of the global operator new/delete
+     *
+     * The replacement is opt-in (CC_ENABLE_ALLOCATION_TRACKING); without it all counters remain zero.
+     * Allocations made by C code (malloc) or by libraries with their own allocator (e.g. the OpenCV
+     * Mat allocator) are not seen.
+     */
+    struct AllocationStats {
+        uint64_t m_NumAllocations   = 0;
+        uint64_t m_NumDeallocations = 0;
+        uint64_t m_NumBytes         = 0; // as requested
+
+        AllocationStats& operator += (const AllocationStats& other);
+
+        friend AllocationStats operator -  (const AllocationStats& a, const AllocationStats& b);
+        friend bool            operator == (const AllocationStats& a, const AllocationStats& b) = default;
+        friend std::ostream&   operator << (std::ostream& os, const AllocationStats& stats);
+    };
+
+    constexpr bool is_allocation_tracking_enabled() {
+#ifdef CC_ENABLE_ALLOCATION_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // totals of the calling thread
+    [[nodiscard]] AllocationStats get_thread_allocation_stats();
+
+    // allocations made by the current thread since construction (or the last reset)
+    class AllocationProbe {
+    public:
+        AllocationProbe();
+
+        [[nodiscard]] AllocationStats get() const;
+        void reset();
+
+    private:
+        AllocationStats m_Start;
+    };
+}
+
+#endif
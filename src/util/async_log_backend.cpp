@@ -0,0 +1,232 @@
+#include "async_log_backend.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    std::atomic<uint64_t> g_NextBackendId = 1;
+}
+
+namespace cc::util {
+    AsyncLogBackend::ThreadBuffer::ThreadBuffer(size_t capacity, uint32_t thread_idx):
+        m_Records  (capacity),
+        m_ThreadIdx(thread_idx)
+    {
+    }
+
+    AsyncLogBackend::AsyncLogBackend():
+        AsyncLogBackend(Config{})
+    {
+    }
+
+    AsyncLogBackend::AsyncLogBackend(Config cfg):
+        m_Id    (g_NextBackendId.fetch_add(1, std::memory_order_relaxed)),
+        m_Config(cfg),
+        m_Thread([this] { run(); })
+    {
+    }
+
+    AsyncLogBackend::~AsyncLogBackend() {
+        {
+            std::unique_lock guard(m_Mutex);
+            m_Finishing = true;
+        }
+
+        m_Condition.notify_all();
+
+        if (m_Thread.joinable())
+            m_Thread.join();
+    }
+
+    void AsyncLogBackend::add_sink(std::unique_ptr<LogSink> sink) {
+        std::unique_lock guard(m_SinksMutex);
+        m_Sinks.push_back(std::move(sink));
+    }
+
+    void AsyncLogBackend::flush() {
+        std::unique_lock guard(m_Mutex);
+
+        if (m_Finishing)
+            return;
+
+        uint64_t target = ++m_FlushRequested;
+        m_Condition.notify_all();
+
+        m_Condition.wait(guard, [&] { return m_FlushCompleted >= target; });
+    }
+
+    uint64_t AsyncLogBackend::get_num_dropped() const {
+        return m_NumDropped.load(std::memory_order_relaxed);
+    }
+
+    uint64_t AsyncLogBackend::get_num_suppressed() const {
+        return m_NumSuppressed.load(std::memory_order_relaxed);
+    }
+
+    AsyncLogBackend::ThreadBuffer* AsyncLogBackend::get_thread_buffer() {
+        // a thread typically only ever logs to a single backend, so cache just one
+        struct Cache {
+            uint64_t                      m_BackendId = 0;
+            std::shared_ptr<ThreadBuffer> m_Buffer;
+        };
+
+        thread_local Cache cache;
+
+        if (cache.m_BackendId != m_Id) {
+            cache.m_Buffer = std::make_shared<ThreadBuffer>(
+                m_Config.m_RingCapacity,
+                m_NextThreadIdx.fetch_add(1, std::memory_order_relaxed)
+            );
+            cache.m_BackendId = m_Id;
+
+            std::unique_lock guard(m_BuffersMutex);
+            m_Buffers.push_back(cache.m_Buffer);
+        }
+
+        return cache.m_Buffer.get();
+    }
+
+    void AsyncLogBackend::run() {
+        std::unique_lock guard(m_Mutex);
+
+        while (true) {
+            m_Condition.wait_for(guard, m_Config.m_PollInterval, [this] {
+                return m_Finishing || (m_FlushRequested != m_FlushCompleted);
+            });
+
+            bool     finishing    = m_Finishing;
+            uint64_t flush_target = m_FlushRequested;
+            bool     flushing     = finishing || (flush_target != m_FlushCompleted);
+
+            guard.unlock();
+
+            drain();
+
+            // don't hold on to a repeat count indefinitely when nothing else is logged
+            if (
+                flushing ||
+                (m_HasPrevious && LogRecord::Clock::now() - m_Previous.m_Time >= m_Config.m_RepeatInterval)
+            )
+                emit_repeat_summary();
+
+            flush_sinks();
+
+            guard.lock();
+
+            m_FlushCompleted = flush_target;
+            m_Condition.notify_all();
+
+            if (finishing)
+                return;
+        }
+    }
+
+    void AsyncLogBackend::drain() {
+        {
+            std::unique_lock guard(m_BuffersMutex);
+
+            // buffers of threads that have exited (or switched backends) can be released once empty
+            std::erase_if(m_Buffers, [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                return (buffer.use_count() == 1) && buffer->m_Records.is_empty();
+            });
+
+            m_DrainList.assign(m_Buffers.begin(), m_Buffers.end());
+        }
+
+        uint64_t num_dropped = 0;
+
+        for (const auto& buffer : m_DrainList) {
+            // bounded, so a single busy thread cannot starve the others
+            for (size_t i = 0; i < buffer->m_Records.get_capacity(); ++i) {
+                const LogRecord* record = buffer->m_Records.begin_read();
+
+                if (!record)
+                    break;
+
+                m_Batch.push_back(*record);
+                buffer->m_Records.end_read();
+            }
+
+            num_dropped += buffer->m_NumDropped.exchange(0, std::memory_order_relaxed);
+        }
+
+        m_DrainList.clear();
+
+        // records of a single thread are already ordered, this interleaves the threads
+        std::stable_sort(m_Batch.begin(), m_Batch.end(), [](const LogRecord& a, const LogRecord& b) {
+            return a.m_Time < b.m_Time;
+        });
+
+        for (const auto& record : m_Batch)
+            emit(record);
+
+        m_Batch.clear();
+
+        if (num_dropped > 0) {
+            m_NumDropped.fetch_add(num_dropped, std::memory_order_relaxed);
+
+            emit(make_record(
+                LogLevel::WARNING,
+                std::format("Dropped {} log messages (log buffer full)", num_dropped)
+            ));
+        }
+    }
+
+    void AsyncLogBackend::emit(const LogRecord& record) {
+        bool is_repeat =
+            m_HasPrevious &&
+            (record.m_Level       == m_Previous.m_Level) &&
+            (record.get_message() == m_Previous.get_message());
+
+        if (is_repeat && (record.m_Time - m_Previous.m_Time < m_Config.m_RepeatInterval)) {
+            ++m_NumRepeats;
+            m_NumSuppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        emit_repeat_summary();
+        write_to_sinks(record);
+
+        m_Previous    = record;
+        m_HasPrevious = true;
+    }
+
+    void AsyncLogBackend::emit_repeat_summary() {
+        if (m_NumRepeats == 0)
+            return;
+
+        write_to_sinks(make_record(
+            m_Previous.m_Level,
+            std::format("Previous message repeated {} times", m_NumRepeats)
+        ));
+
+        m_NumRepeats = 0;
+    }
+
+    void AsyncLogBackend::write_to_sinks(const LogRecord& record) {
+        std::unique_lock guard(m_SinksMutex);
+
+        for (auto& sink : m_Sinks)
+            sink->write(record);
+    }
+
+    void AsyncLogBackend::flush_sinks() {
+        std::unique_lock guard(m_SinksMutex);
+
+        for (auto& sink : m_Sinks)
+            sink->flush();
+    }
+
+    LogRecord AsyncLogBackend::make_record(LogLevel level, std::string_view message) {
+        LogRecord result;
+
+        result.m_Time      = LogRecord::Clock::now();
+        result.m_Level     = level;
+        result.m_Length    = static_cast<uint32_t>(std::min(message.size(), LogRecord::k_MaxMessageLength));
+        result.m_Truncated = (message.size() > LogRecord::k_MaxMessageLength);
+
+        std::copy_n(message.data(), result.m_Length, result.m_Message);
+
+        return result;
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef CC_UTIL_ASYNC_LOG_BACKEND_H
+#define CC_UTIL_ASYNC_LOG_BACKEND_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "log_record.h"
+#include "log_sink.h"
+#include "spsc_ring_buffer.h"
+
+namespace cc::util {
+    /*
+     * Every logging thread formats directly into a slot of its own lock-free ring buffer;
+     * a single background thread drains all buffers (in timestamp order) into the sinks.
+     *
+     * The logging thread never blocks or allocates after its first message - when its
+     * buffer is full the record is dropped and counted instead, and the sink thread
+     * reports the number of dropped messages.
+     *
+     * Identical consecutive messages are collapsed, at most one per repeat interval is
+     * written, followed by a 'repeated N times' summary.
+     */
+    class AsyncLogBackend {
+    public:
+        struct Config {
+            size_t                    m_RingCapacity   = 512;                          // records per thread
+            std::chrono::milliseconds m_PollInterval   = std::chrono::milliseconds(10);
+            std::chrono::milliseconds m_RepeatInterval = std::chrono::seconds(1);
+        };
+
+        AsyncLogBackend();
+        explicit AsyncLogBackend(Config cfg);
+        ~AsyncLogBackend(); // writes all pending records before returning
+
+        AsyncLogBackend             (const AsyncLogBackend&) = delete;
+        AsyncLogBackend& operator = (const AsyncLogBackend&) = delete;
+        AsyncLogBackend             (AsyncLogBackend&&) noexcept = delete;
+        AsyncLogBackend& operator = (AsyncLogBackend&&) noexcept = delete;
+
+        void add_sink(std::unique_ptr<LogSink> sink);
+
+        // returns false if the record was dropped
+        template <typename... Args>
+        bool push(LogLevel level, FormatWithLocation<Args...> format, Args&&... args);
+
+        // blocks until everything pushed before this call has been written and flushed
+        void flush();
+
+        [[nodiscard]] uint64_t get_num_dropped()    const;
+        [[nodiscard]] uint64_t get_num_suppressed() const;
+
+    private:
+        struct ThreadBuffer {
+            ThreadBuffer(size_t capacity, uint32_t thread_idx);
+
+            SpscRingBuffer<LogRecord> m_Records;
+            uint32_t                  m_ThreadIdx;
+            std::atomic<uint64_t>     m_NumDropped = 0;
+        };
+
+        ThreadBuffer* get_thread_buffer(); // registers the calling thread on first use
+
+        void run();
+        void drain();
+        void emit(const LogRecord& record);
+        void emit_repeat_summary();
+        void write_to_sinks(const LogRecord& record);
+        void flush_sinks();
+
+        static LogRecord make_record(LogLevel level, std::string_view message);
+
+        uint64_t m_Id; // distinguishes backends in the per-thread buffer cache
+        Config   m_Config;
+
+        std::atomic<uint32_t> m_NextThreadIdx  = 0;
+        std::atomic<uint64_t> m_NumDropped     = 0;
+        std::atomic<uint64_t> m_NumSuppressed  = 0;
+
+        std::mutex                                 m_BuffersMutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> m_Buffers;
+
+        std::mutex                            m_SinksMutex;
+        std::vector<std::unique_ptr<LogSink>> m_Sinks;
+
+        std::mutex              m_Mutex;
+        std::condition_variable m_Condition;
+        bool                    m_Finishing      = false;
+        uint64_t                m_FlushRequested = 0;
+        uint64_t                m_FlushCompleted = 0;
+
+        // only accessed by the sink thread
+        std::vector<std::shared_ptr<ThreadBuffer>> m_DrainList;
+        std::vector<LogRecord>                     m_Batch;
+        LogRecord                                  m_Previous {};
+        bool                                       m_HasPrevious = false;
+        uint64_t                                   m_NumRepeats  = 0;
+
+        std::thread m_Thread; // should be last
+    };
+}
+
+#include "async_log_backend.inl"
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef CC_UTIL_ASYNC_LOG_BACKEND_INL
+#define CC_UTIL_ASYNC_LOG_BACKEND_INL
+
+#include "async_log_backend.h"
+
+namespace cc::util {
+    template <typename... Args>
+    bool AsyncLogBackend::push(LogLevel level, FormatWithLocation<Args...> format, Args&&... args) {
+        ThreadBuffer* buffer = get_thread_buffer();
+        LogRecord*    record = buffer->m_Records.begin_write();
+
+        if (!record) {
+            buffer->m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        auto result = std::format_to_n(
+            record->m_Message,
+            LogRecord::k_MaxMessageLength,
+            format.m_Format,
+            std::forward<Args>(args)...
+        );
+
+        record->m_Time      = LogRecord::Clock::now();
+        record->m_Level     = level;
+        record->m_ThreadIdx = buffer->m_ThreadIdx;
+        record->m_File      = format.m_Location.file_name();
+        record->m_Line      = format.m_Location.line();
+        record->m_Length    = static_cast<uint32_t>(result.out - record->m_Message);
+        record->m_Truncated = (static_cast<size_t>(result.size) > LogRecord::k_MaxMessageLength);
+
+        buffer->m_Records.end_write();
+
+        return true;
+    }
+}
+
+#endif
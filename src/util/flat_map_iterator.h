@@ -0,0 +1,83 @@
+#ifndef UTIL_FLAT_MAP_ITERATOR_H
+#define UTIL_FLAT_MAP_ITERATOR_H
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace cc {
+    //
+    // random access iterator for maps that store keys and values separately (SortedFlatMap, SmallFlatMap)
+    // -- dereferences to std::pair<const key_type&, mapped_type&>, like std::flat_map
+    // -- the map provides get_key(idx) and get_value(idx), and befriends this class
+    //
+    template <typename t_Map, bool t_IsConst>
+    class FlatMapIterator {
+    public:
+        using map_type          = std::conditional_t<t_IsConst, const t_Map, t_Map>;
+        using key_type          = typename t_Map::key_type;
+        using mapped_type       = typename t_Map::mapped_type;
+        using value_type        = std::pair<key_type, mapped_type>;
+        using reference         = std::pair<const key_type&, std::conditional_t<t_IsConst, const mapped_type&, mapped_type&>>;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        struct pointer {
+            reference m_Reference;
+
+            reference* operator -> () { return &m_Reference; }
+        };
+
+        FlatMapIterator() = default;
+
+        FlatMapIterator(map_type* map, size_t idx):
+            m_Map(map),
+            m_Idx(idx)
+        {
+        }
+
+        template <bool t_OtherIsConst>
+            requires (t_IsConst && !t_OtherIsConst)
+        FlatMapIterator(const FlatMapIterator<t_Map, t_OtherIsConst>& it): // iterator -> const_iterator
+            m_Map(it.m_Map),
+            m_Idx(it.m_Idx)
+        {
+        }
+
+        reference operator *  ()                       const { return { m_Map->get_key(m_Idx), m_Map->get_value(m_Idx) }; }
+        pointer   operator -> ()                       const { return { **this }; }
+        reference operator [] (difference_type offset) const { return *(*this + offset); }
+
+        FlatMapIterator& operator ++ ()    { ++m_Idx; return *this; }
+        FlatMapIterator& operator -- ()    { --m_Idx; return *this; }
+        FlatMapIterator  operator ++ (int) { auto result = *this; ++m_Idx; return result; }
+        FlatMapIterator  operator -- (int) { auto result = *this; --m_Idx; return result; }
+
+        FlatMapIterator& operator += (difference_type offset) { m_Idx += offset; return *this; }
+        FlatMapIterator& operator -= (difference_type offset) { m_Idx -= offset; return *this; }
+
+        friend FlatMapIterator operator + (FlatMapIterator it, difference_type offset) { return it += offset; }
+        friend FlatMapIterator operator + (difference_type offset, FlatMapIterator it) { return it += offset; }
+        friend FlatMapIterator operator - (FlatMapIterator it, difference_type offset) { return it -= offset; }
+
+        friend difference_type operator - (const FlatMapIterator& a, const FlatMapIterator& b) {
+            return static_cast<difference_type>(a.m_Idx) - static_cast<difference_type>(b.m_Idx);
+        }
+
+        friend bool                 operator ==  (const FlatMapIterator& a, const FlatMapIterator& b) { return a.m_Idx == b.m_Idx; }
+        friend std::strong_ordering operator <=> (const FlatMapIterator& a, const FlatMapIterator& b) { return a.m_Idx <=> b.m_Idx; }
+
+        [[nodiscard]] size_t get_index() const { return m_Idx; }
+
+    private:
+        template <typename, bool>
+        friend class FlatMapIterator;
+
+        map_type* m_Map = nullptr;
+        size_t    m_Idx = 0;
+    };
+}
+
+#endif
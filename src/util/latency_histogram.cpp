@@ -0,0 +1,174 @@
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+namespace cc::util {
+    LatencyHistogram::LatencyHistogram() {
+        reset();
+    }
+
+    void LatencyHistogram::record(Duration d) {
+        uint64_t value = static_cast<uint64_t>(std::max<Duration::rep>(d.count(), 0));
+
+        m_Buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        m_Count.fetch_add(1,     std::memory_order_relaxed);
+        m_Sum  .fetch_add(value, std::memory_order_relaxed);
+
+        // min/max are rarely updated after warmup, so the CAS loops are usually skipped entirely
+        uint64_t current = m_Min.load(std::memory_order_relaxed);
+        while (value < current && !m_Min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            ;
+
+        current = m_Max.load(std::memory_order_relaxed);
+        while (value > current && !m_Max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            ;
+    }
+
+    void LatencyHistogram::reset() {
+        for (auto& bucket : m_Buckets)
+            bucket.store(0, std::memory_order_relaxed);
+
+        m_Count.store(0, std::memory_order_relaxed);
+        m_Sum  .store(0, std::memory_order_relaxed);
+        m_Min  .store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        m_Max  .store(0, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+        Snapshot result;
+
+        for (size_t i = 0; i < k_NumBuckets; ++i)
+            result.m_Buckets[i] = m_Buckets[i].load(std::memory_order_relaxed);
+
+        result.m_Count = m_Count.load(std::memory_order_relaxed);
+        result.m_Sum   = m_Sum  .load(std::memory_order_relaxed);
+        result.m_Min   = m_Min  .load(std::memory_order_relaxed);
+        result.m_Max   = m_Max  .load(std::memory_order_relaxed);
+
+        if (result.m_Count == 0)
+            result.m_Min = 0;
+
+        return result;
+    }
+
+    size_t LatencyHistogram::bucket_index(uint64_t value) {
+        // small values map linearly
+        if (value < k_NumSubBuckets)
+            return static_cast<size_t>(value);
+
+        // otherwise, use the top k_SubBucketBits below the most significant bit as the sub-bucket
+        int msb   = std::bit_width(value) - 1;
+        int shift = msb - k_SubBucketBits;
+
+        size_t magnitude  = static_cast<size_t>(shift + 1);
+        size_t sub_bucket = static_cast<size_t>(value >> shift) - k_NumSubBuckets;
+
+        return magnitude * k_NumSubBuckets + sub_bucket;
+    }
+
+    uint64_t LatencyHistogram::bucket_lower_bound(size_t index) {
+        size_t magnitude  = index / k_NumSubBuckets;
+        size_t sub_bucket = index % k_NumSubBuckets;
+
+        if (magnitude == 0)
+            return sub_bucket;
+
+        return (k_NumSubBuckets + sub_bucket) << (magnitude - 1);
+    }
+
+    uint64_t LatencyHistogram::bucket_upper_bound(size_t index) {
+        size_t magnitude = index / k_NumSubBuckets;
+
+        if (magnitude == 0)
+            return bucket_lower_bound(index);
+
+        return bucket_lower_bound(index) + ((uint64_t(1) << (magnitude - 1)) - 1);
+    }
+
+    LatencyHistogram::Duration LatencyHistogram::Snapshot::percentile(double p) const {
+        if (m_Count == 0)
+            return Duration::zero();
+
+        if (p <= 0.0)
+            return min();
+
+        if (p >= 100.0)
+            return max();
+
+        auto rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(m_Count)));
+        rank = std::max<uint64_t>(rank, 1);
+
+        uint64_t cumulative = 0;
+
+        for (size_t i = 0; i < k_NumBuckets; ++i) {
+            cumulative += m_Buckets[i];
+
+            if (cumulative >= rank) {
+                // report the middle of the bucket, but never outside of the observed range
+                uint64_t lower = bucket_lower_bound(i);
+                uint64_t upper = bucket_upper_bound(i);
+                uint64_t mid   = lower + (upper - lower) / 2;
+
+                return Duration(static_cast<Duration::rep>(std::clamp(mid, m_Min, m_Max)));
+            }
+        }
+
+        return max();
+    }
+
+    LatencyHistogram::Duration LatencyHistogram::Snapshot::mean() const {
+        if (m_Count == 0)
+            return Duration::zero();
+
+        return Duration(static_cast<Duration::rep>(m_Sum / m_Count));
+    }
+
+    LatencyHistogram::Duration LatencyHistogram::Snapshot::min() const {
+        return Duration(static_cast<Duration::rep>(m_Min));
+    }
+
+    LatencyHistogram::Duration LatencyHistogram::Snapshot::max() const {
+        return Duration(static_cast<Duration::rep>(m_Max));
+    }
+
+    void LatencyHistogram::Snapshot::merge(const Snapshot& other) {
+        if (other.m_Count == 0)
+            return;
+
+        m_Min = (m_Count == 0) ? other.m_Min : std::min(m_Min, other.m_Min);
+        m_Max = std::max(m_Max, other.m_Max);
+
+        m_Count += other.m_Count;
+        m_Sum   += other.m_Sum;
+
+        for (size_t i = 0; i < k_NumBuckets; ++i)
+            m_Buckets[i] += other.m_Buckets[i];
+    }
+
+    ScopedLatency::ScopedLatency(LatencyHistogram& histogram):
+        m_Histogram(histogram),
+        m_Start    (Clock::now())
+    {
+    }
+
+    ScopedLatency::~ScopedLatency() {
+        m_Histogram.record(Clock::now() - m_Start);
+    }
+
+    std::ostream& operator << (std::ostream& os, const LatencyHistogram::Snapshot& s) {
+        using std::chrono::duration_cast;
+        using micros = std::chrono::duration<double, std::micro>;
+
+        os
+            << "n="    << s.m_Count
+            << " p50=" << duration_cast<micros>(s.percentile(50.0)).count() << "us"
+            << " p99=" << duration_cast<micros>(s.percentile(99.0)).count() << "us"
+            << " max=" << duration_cast<micros>(s.max())                    .count() << "us";
+
+        return os;
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef CC_UTIL_LATENCY_HISTOGRAM_H
+#define CC_UTIL_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+namespace cc::util {
+    /*
+     * Fixed-memory, log-linear histogram of durations with nanosecond resolution (HDR-style)
+     *
+     * Values are grouped per power of two, and every power of two is split into 2^k_SubBucketBits
+     * linear sub-buckets. Reported percentiles are therefore within 1/2^k_SubBucketBits (12.5%) of
+     * the recorded value, over the entire range of a 64-bit nanosecond count.
+     *
+     * Recording is a single relaxed atomic increment (plus min/max/sum bookkeeping), so it's safe
+     * to record from multiple threads while another thread takes snapshots.
+     */
+    class LatencyHistogram {
+    public:
+        using Duration = std::chrono::nanoseconds;
+
+        static constexpr int    k_SubBucketBits  = 3;
+        static constexpr size_t k_NumSubBuckets  = size_t(1) << k_SubBucketBits;
+        static constexpr size_t k_NumBuckets     = (64 - k_SubBucketBits + 1) * k_NumSubBuckets;
+
+        struct Snapshot {
+            uint64_t m_Count = 0;
+            uint64_t m_Sum   = 0; // nanoseconds
+            uint64_t m_Min   = 0;
+            uint64_t m_Max   = 0;
+
+            std::array<uint64_t, k_NumBuckets> m_Buckets {};
+
+            [[nodiscard]] Duration percentile(double p) const; // p in [0, 100]
+            [[nodiscard]] Duration mean() const;
+            [[nodiscard]] Duration min() const;
+            [[nodiscard]] Duration max() const;
+
+            void merge(const Snapshot& other);
+
+            friend std::ostream& operator << (std::ostream& os, const Snapshot& s); // count, p50, p99 and max
+        };
+
+        LatencyHistogram();
+
+        void record(Duration d);
+        void reset(); // not synchronized with concurrent record() calls
+
+        [[nodiscard]] Snapshot snapshot() const;
+
+        [[nodiscard]] static size_t   bucket_index(uint64_t value);
+        [[nodiscard]] static uint64_t bucket_lower_bound(size_t index);
+        [[nodiscard]] static uint64_t bucket_upper_bound(size_t index); // inclusive
+
+    private:
+        std::array<std::atomic<uint64_t>, k_NumBuckets> m_Buckets;
+
+        std::atomic<uint64_t> m_Count;
+        std::atomic<uint64_t> m_Sum;
+        std::atomic<uint64_t> m_Min;
+        std::atomic<uint64_t> m_Max;
+    };
+
+    // records the time between construction and destruction
+    class ScopedLatency {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit ScopedLatency(LatencyHistogram& histogram);
+        ~ScopedLatency();
+
+        ScopedLatency             (const ScopedLatency&) = delete;
+        ScopedLatency& operator = (const ScopedLatency&) = delete;
+        ScopedLatency             (ScopedLatency&&) noexcept = delete;
+        ScopedLatency& operator = (ScopedLatency&&) noexcept = delete;
+
+    private:
+        LatencyHistogram& m_Histogram;
+        Clock::time_point m_Start;
+    };
+}
+
+#endif
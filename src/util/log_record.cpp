@@ -0,0 +1,14 @@
+#include "log_record.h"
+
+namespace cc::util {
+    const char* to_string(LogLevel level) {
+        switch (level) {
+            case LogLevel::DEBUG:   return "DEBUG";
+            case LogLevel::INFO:    return "INFO";
+            case LogLevel::WARNING: return "WARN";
+            case LogLevel::ERR:     return "ERROR";
+            default:
+                                    return "UNKNOWN";
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef CC_UTIL_LOG_RECORD_H
+#define CC_UTIL_LOG_RECORD_H
+
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <source_location>
+#include <string_view>
+#include <type_traits>
+
+namespace cc::util {
+    enum class LogLevel : int {
+        DEBUG   = 0,
+        INFO    = 1,
+        WARNING = 2,
+        ERR     = 3
+    };
+
+    const char* to_string(LogLevel level);
+
+    // format string that implicitly captures the location it was created at (the logging call site)
+    template <typename... Args>
+    struct BasicFormatWithLocation {
+        template <typename T>
+        requires std::is_convertible_v<const T&, std::string_view>
+        consteval BasicFormatWithLocation(
+            const T&             fmt,
+            std::source_location location = std::source_location::current()
+        ):
+            m_Format  (fmt),
+            m_Location(location)
+        {
+        }
+
+        std::format_string<Args...> m_Format;
+        std::source_location        m_Location;
+    };
+
+    template <typename... Args>
+    using FormatWithLocation = BasicFormatWithLocation<std::type_identity_t<Args>...>;
+
+    // pre-formatted, fixed size log entry; messages that don't fit are truncated
+    struct LogRecord {
+        using Clock = std::chrono::system_clock;
+
+        static constexpr size_t k_MaxMessageLength = 224;
+
+        Clock::time_point m_Time;
+        LogLevel          m_Level     = LogLevel::INFO;
+        uint32_t          m_ThreadIdx = 0;
+        const char*       m_File      = nullptr; // static storage (from std::source_location)
+        uint32_t          m_Line      = 0;
+        uint32_t          m_Length    = 0;
+        bool              m_Truncated = false;
+
+        char m_Message[k_MaxMessageLength];
+
+        [[nodiscard]] std::string_view get_message() const { return { m_Message, m_Length }; }
+    };
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include "log_sink.h"
+
+#include <format>
+#include <iterator>
+#include <string_view>
+
+namespace {
+    // only the filename part of the path (source_location typically provides a full path)
+    std::string_view get_filename(const char* path) {
+        std::string_view result(path);
+
+        if (auto pos = result.find_last_of("/\\"); pos != std::string_view::npos)
+            result.remove_prefix(pos + 1);
+
+        return result;
+    }
+
+    void write_message(const cc::util::LogRecord& record, FILE* f) {
+        std::fwrite(record.m_Message, 1, record.m_Length, f);
+
+        if (record.m_Truncated)
+            std::fputs("...", f);
+
+        std::fputc('\n', f);
+    }
+}
+
+namespace cc::util {
+    void StdoutSink::write(const LogRecord& record) {
+        std::fprintf(stdout, "[%s] ", to_string(record.m_Level));
+        write_message(record, stdout);
+    }
+
+    void StdoutSink::flush() {
+        std::fflush(stdout);
+    }
+
+    FileSink::FileSink(const std::filesystem::path& p):
+        m_File(open_FILE(p, "ab"))
+    {
+    }
+
+    void FileSink::write(const LogRecord& record) {
+        char prefix[128];
+
+        auto result = std::format_to_n(
+            prefix,
+            std::size(prefix),
+            "{:%F %T} [{}] ({}) ",
+            std::chrono::floor<std::chrono::milliseconds>(record.m_Time),
+            to_string(record.m_Level),
+            record.m_ThreadIdx
+        );
+
+        if (record.m_File)
+            result = std::format_to_n(
+                result.out,
+                std::size(prefix) - static_cast<size_t>(result.out - prefix),
+                "{}:{}: ",
+                get_filename(record.m_File),
+                record.m_Line
+            );
+
+        std::fwrite(prefix, 1, static_cast<size_t>(result.out - prefix), m_File.get());
+        write_message(record, m_File.get());
+    }
+
+    void FileSink::flush() {
+        std::fflush(m_File.get());
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef CC_UTIL_LOG_SINK_H
+#define CC_UTIL_LOG_SINK_H
+
+#include <filesystem>
+
+#include "log_record.h"
+#include "unique.h"
+
+namespace cc::util {
+    // sinks are only ever called from the log backend thread
+    class LogSink {
+    public:
+        virtual ~LogSink() = default;
+
+        virtual void write(const LogRecord& record) = 0;
+        virtual void flush() {}
+    };
+
+    // "[LEVEL] message", same as the synchronous logger
+    class StdoutSink:
+        public LogSink
+    {
+    public:
+        void write(const LogRecord& record) override;
+        void flush() override;
+    };
+
+    // "YYYY-MM-DD HH:MM:SS.mmm [LEVEL] (thread) file:line: message", appended to the file
+    class FileSink:
+        public LogSink
+    {
+    public:
+        explicit FileSink(const std::filesystem::path& p);
+
+        void write(const LogRecord& record) override;
+        void flush() override;
+
+    private:
+        UniqueFile m_File;
+    };
+}
+
+#endif
@@ -1,79 +1,130 @@
 #ifndef CC_UTIL_LOGGER_H
 #define CC_UTIL_LOGGER_H
 
+#include <atomic>
 #include <string>
 #include <format>
 #include <iomanip>
 #include <iostream>
 
+#include "log_record.h"
+#include "async_log_backend.h"
+
+// compile-time minimum log level; calls below this level are removed entirely
+// (including argument evaluation). By default release builds drop debug logging.
+// Note that variables only used for a removed log call will trigger unused warnings.
+#define CC_LOG_LEVEL_DEBUG   0
+#define CC_LOG_LEVEL_INFO    1
+#define CC_LOG_LEVEL_WARNING 2
+#define CC_LOG_LEVEL_ERROR   3
+#define CC_LOG_LEVEL_OFF     4
+
+#ifndef CC_LOG_MIN_LEVEL
+    #ifdef NDEBUG
+        #define CC_LOG_MIN_LEVEL CC_LOG_LEVEL_INFO
+    #else
+        #define CC_LOG_MIN_LEVEL CC_LOG_LEVEL_DEBUG
+    #endif
+#endif
+
 namespace cc::util {
     // limited logging functionality
-    // (should be updated to source_location and use log sinks)
-
-    enum class LogLevel : int {
-        DEBUG   = 0,
-        INFO    = 1,
-        WARNING = 2,
-        ERR     = 3
-    };
+    //
+    // Without a backend, messages are written synchronously to stdout. With a backend
+    // attached, messages are formatted on the calling thread and handed off to the
+    // backend sink thread. The backend must outlive every thread that may still log.
+    //
+    // The call site is captured as part of the format string (see FormatWithLocation).
 
     class Logger {
     public:
         static Logger& instance() { static Logger x; return x; }
 
-        void     set_level(LogLevel level) { m_level = level; }
-        LogLevel get_level() const         { return m_level; }
+        static constexpr bool is_compiled_in(LogLevel level) { return static_cast<int>(level) >= CC_LOG_MIN_LEVEL; }
+
+        void     set_level(LogLevel level)        { m_level = level; }
+        LogLevel get_level() const                { return m_level; }
+        bool     is_enabled(LogLevel level) const { return is_compiled_in(level) && (level >= m_level); }
+
+        void             set_backend(AsyncLogBackend* backend) { m_Backend.store(backend, std::memory_order_release); }
+        AsyncLogBackend* get_backend() const                   { return m_Backend.load(std::memory_order_acquire); }
 
         template <typename... Args>
-        void log(LogLevel level, std::format_string<Args...> format, Args&&... args) {
+        void log(LogLevel level, FormatWithLocation<Args...> format, Args&&... args) {
             if (level >= m_level) {
-                auto message = std::format(format, std::forward<Args>(args)...);
-                std::cout << "[" << level_to_string(level) << "] " << message << std::endl;
+                if (auto* backend = get_backend()) {
+                    backend->push(level, format, std::forward<Args>(args)...);
+                    return;
+                }
+
+                auto message = std::format(format.m_Format, std::forward<Args>(args)...);
+                std::cout << "[" << to_string(level) << "] " << message << std::endl;
             }
         }
 
         template <typename... Args>
-        void debug(std::format_string<Args...> format, Args&&... args) {
-            log(LogLevel::DEBUG, format, std::forward<Args>(args)...);
+        void debug(FormatWithLocation<Args...> format, Args&&... args) {
+            if constexpr (is_compiled_in(LogLevel::DEBUG))
+                log(LogLevel::DEBUG, format, std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        void info(std::format_string<Args...> format, Args&&... args) {
-            log(LogLevel::INFO, format, std::forward<Args>(args)...);
+        void info(FormatWithLocation<Args...> format, Args&&... args) {
+            if constexpr (is_compiled_in(LogLevel::INFO))
+                log(LogLevel::INFO, format, std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        void warning(std::format_string<Args...> format, Args&&... args) {
-            log(LogLevel::WARNING, format, std::forward<Args>(args)...);
+        void warning(FormatWithLocation<Args...> format, Args&&... args) {
+            if constexpr (is_compiled_in(LogLevel::WARNING))
+                log(LogLevel::WARNING, format, std::forward<Args>(args)...);
         }
 
         template <typename... Args>
-        void error(std::format_string<Args...> format, Args&&... args) {
-            log(LogLevel::ERR, format, std::forward<Args>(args)...);
+        void error(FormatWithLocation<Args...> format, Args&&... args) {
+            if constexpr (is_compiled_in(LogLevel::ERR))
+                log(LogLevel::ERR, format, std::forward<Args>(args)...);
         }
 
     private:
         Logger() = default;
 
-        LogLevel m_level = LogLevel::INFO;
-
-        static const char* level_to_string(LogLevel level) {
-            switch (level) {
-                case LogLevel::DEBUG:   return "DEBUG";
-                case LogLevel::INFO:    return "INFO";
-                case LogLevel::WARNING: return "WARN";
-                case LogLevel::ERR:     return "ERROR";
-                default:
-                                        return "UNKNOWN";
-            }
-        }
+        LogLevel                      m_level   = LogLevel::INFO;
+        std::atomic<AsyncLogBackend*> m_Backend = nullptr;
     };
 }
 
 // Convenience macros
-#define LOG_DEBUG(...)   cc::util::Logger::instance().debug(__VA_ARGS__)
-#define LOG_INFO(...)    cc::util::Logger::instance().info(__VA_ARGS__)
-#define LOG_WARNING(...) cc::util::Logger::instance().warning(__VA_ARGS__)
-#define LOG_ERROR(...)   cc::util::Logger::instance().error(__VA_ARGS__)
+// -- arguments are only evaluated when the level is enabled (both at compile time and at runtime)
+#define CC_LOG_IMPL(level, method, ...)                     \
+    do {                                                    \
+        auto& cc_logger = cc::util::Logger::instance();     \
+        if (cc_logger.is_enabled(level))                    \
+            cc_logger.method(__VA_ARGS__);                  \
+    } while (false)
+
+#if CC_LOG_MIN_LEVEL <= CC_LOG_LEVEL_DEBUG
+    #define LOG_DEBUG(...) CC_LOG_IMPL(cc::util::LogLevel::DEBUG, debug, __VA_ARGS__)
+#else
+    #define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if CC_LOG_MIN_LEVEL <= CC_LOG_LEVEL_INFO
+    #define LOG_INFO(...) CC_LOG_IMPL(cc::util::LogLevel::INFO, info, __VA_ARGS__)
+#else
+    #define LOG_INFO(...) ((void)0)
+#endif
+
+#if CC_LOG_MIN_LEVEL <= CC_LOG_LEVEL_WARNING
+    #define LOG_WARNING(...) CC_LOG_IMPL(cc::util::LogLevel::WARNING, warning, __VA_ARGS__)
+#else
+    #define LOG_WARNING(...) ((void)0)
+#endif
+
+#if CC_LOG_MIN_LEVEL <= CC_LOG_LEVEL_ERROR
+    #define LOG_ERROR(...) CC_LOG_IMPL(cc::util::LogLevel::ERR, error, __VA_ARGS__)
+#else
+    #define LOG_ERROR(...) ((void)0)
+#endif
 
 #endif
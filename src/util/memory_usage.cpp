@@ -0,0 +1,35 @@
+#include "memory_usage.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__linux__) || defined(__APPLE__)
+    #include <sys/resource.h>
+#endif
+
+namespace cc::util {
+    size_t get_peak_rss() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters = {};
+
+        if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+
+        return 0;
+#elif defined(__linux__) || defined(__APPLE__)
+        rusage usage = {};
+
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+    #if defined(__APPLE__)
+        return static_cast<size_t>(usage.ru_maxrss);        // bytes
+    #else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024; // kilobytes
+    #endif
+#else
+        return 0;
+#endif
+    }
+}
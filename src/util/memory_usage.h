@@ -0,0 +1,11 @@
+#ifndef CC_UTIL_MEMORY_USAGE_H
+#define CC_UTIL_MEMORY_USAGE_H
+
+#include <cstddef>
+
+namespace cc::util {
+    // peak resident set size (working set on Windows) of this process in bytes, 0 when unknown
+    [[nodiscard]] size_t get_peak_rss();
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include "perf_counters.h"
+
+#include <ostream>
+
+#if defined(CC_ENABLE_PERF_COUNTERS) && defined(__linux__)
+    #define CC_HAS_PERF_EVENT 1
+
+    #include <cerrno>
+    #include <cstring>
+
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    #include "util/logger.h"
+#endif
+
+namespace {
+#ifdef CC_HAS_PERF_EVENT
+    int open_counter(uint64_t config, int group_fd) {
+        perf_event_attr attr = {};
+
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.size           = sizeof(attr);
+        attr.config         = config;
+        attr.disabled       = (group_fd == -1) ? 1 : 0; // the group leader starts (and enables) the group
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    uint64_t read_counter(int fd) {
+        uint64_t value = 0;
+
+        if (fd < 0 || ::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value)))
+            return 0;
+
+        return value;
+    }
+#endif
+}
+
+namespace cc::util {
+    double PerfSample::get_ipc() const {
+        if (m_Cycles == 0)
+            return 0.0;
+
+        return static_cast<double>(m_Instructions) / static_cast<double>(m_Cycles);
+    }
+
+    PerfSample& PerfSample::operator += (const PerfSample& other) {
+        m_Cycles       += other.m_Cycles;
+        m_Instructions += other.m_Instructions;
+        m_CacheMisses  += other.m_CacheMisses;
+        m_BranchMisses += other.m_BranchMisses;
+
+        return *this;
+    }
+
+    PerfSample operator - (const PerfSample& a, const PerfSample& b) {
+        return {
+            .m_Cycles       = a.m_Cycles       - b.m_Cycles,
+            .m_Instructions = a.m_Instructions - b.m_Instructions,
+            .m_CacheMisses  = a.m_CacheMisses  - b.m_CacheMisses,
+            .m_BranchMisses = a.m_BranchMisses - b.m_BranchMisses
+        };
+    }
+
+    std::ostream& operator << (std::ostream& os, const PerfSample& sample) {
+        os
+            << sample.m_Cycles       << " cycles, "
+            << sample.m_Instructions << " instructions, "
+            << sample.m_CacheMisses  << " cache misses, "
+            << sample.m_BranchMisses << " branch misses";
+
+        return os;
+    }
+
+    PerfCounters::PerfCounters() {
+        m_Descriptors.fill(-1);
+
+#ifdef CC_HAS_PERF_EVENT
+        int leader = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+
+        if (leader < 0) {
+            LOG_INFO("Hardware performance counters are unavailable ({})", std::strerror(errno));
+            return;
+        }
+
+        m_Descriptors[e_Cycles]       = leader;
+        m_Descriptors[e_Instructions] = open_counter(PERF_COUNT_HW_INSTRUCTIONS,  leader);
+        m_Descriptors[e_CacheMisses]  = open_counter(PERF_COUNT_HW_CACHE_MISSES,  leader);
+        m_Descriptors[e_BranchMisses] = open_counter(PERF_COUNT_HW_BRANCH_MISSES, leader);
+
+        ioctl(leader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    PerfCounters::~PerfCounters() {
+#ifdef CC_HAS_PERF_EVENT
+        // close the group members before the leader
+        for (auto it = m_Descriptors.rbegin(); it != m_Descriptors.rend(); ++it)
+            if (*it >= 0)
+                close(*it);
+#endif
+    }
+
+    bool PerfCounters::is_available() const {
+        return m_Descriptors[e_Cycles] >= 0;
+    }
+
+    PerfSample PerfCounters::sample() const {
+#ifdef CC_HAS_PERF_EVENT
+        if (is_available())
+            return {
+                .m_Cycles       = read_counter(m_Descriptors[e_Cycles]),
+                .m_Instructions = read_counter(m_Descriptors[e_Instructions]),
+                .m_CacheMisses  = read_counter(m_Descriptors[e_CacheMisses]),
+                .m_BranchMisses = read_counter(m_Descriptors[e_BranchMisses])
+            };
+#endif
+
+        return {};
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef CC_UTIL_PERF_COUNTERS_H
+#define CC_UTIL_PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+namespace cc::util {
+    struct PerfSample {
+        uint64_t m_Cycles       = 0;
+        uint64_t m_Instructions = 0;
+        uint64_t m_CacheMisses  = 0;
+        uint64_t m_BranchMisses = 0;
+
+        [[nodiscard]] double get_ipc() const; // instructions per cycle, 0 without cycles
+
+        PerfSample& operator += (const PerfSample& other);
+
+        friend PerfSample    operator -  (const PerfSample& a, const PerfSample& b);
+        friend bool          operator == (const PerfSample& a, const PerfSample& b) = default;
+        friend std::ostream& operator << (std::ostream& os, const PerfSample& sample);
+    };
+
+    /*
+     * Hardware performance counters of the calling thread, via Linux perf_event_open
+     *
+     * Opening the counters is opt-in (CC_ENABLE_PERF_COUNTERS) and may still fail at runtime -- in VMs
+     * without a virtual PMU, with a restrictive kernel.perf_event_paranoid or on other platforms. In that
+     * case is_available() is false and all samples are zero. Individual counters that are not supported
+     * (e.g. cache misses on some hypervisors) read as zero while the others keep working.
+     *
+     * The counters only measure user space activity of the thread that created this object, so
+     * samples should be taken on that thread as well.
+     */
+    class PerfCounters {
+    public:
+        PerfCounters();
+        ~PerfCounters();
+
+        PerfCounters             (const PerfCounters&) = delete;
+        PerfCounters& operator = (const PerfCounters&) = delete;
+        PerfCounters             (PerfCounters&&) noexcept = delete;
+        PerfCounters& operator = (PerfCounters&&) noexcept = delete;
+
+        [[nodiscard]] bool       is_available() const;
+        [[nodiscard]] PerfSample sample() const; // running totals since construction
+
+    private:
+        enum e_Counter {
+            e_Cycles,
+            e_Instructions,
+            e_CacheMisses,
+            e_BranchMisses,
+
+            e_NumCounters
+        };
+
+        std::array<int, e_NumCounters> m_Descriptors;
+    };
+
+    constexpr bool is_perf_counters_enabled() {
+#ifdef CC_ENABLE_PERF_COUNTERS
+        return true;
+#else
+        return false;
+#endif
+    }
+}
+
+#endif
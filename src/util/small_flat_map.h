@@ -0,0 +1,127 @@
+#ifndef UTIL_SMALL_FLAT_MAP_H
+#define UTIL_SMALL_FLAT_MAP_H
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "flat_map_iterator.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CC_SMALL_FLAT_MAP_SSE2 1
+#endif
+
+namespace cc {
+    // keys that compare equal exactly when their bytes are equal (integers, enums, pointers) and fit a SIMD lane
+    template <typename T>
+    concept SmallFlatMapKey =
+        std::is_trivially_copyable_v<T> &&
+        std::has_unique_object_representations_v<T> &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+    //
+    // fixed-capacity flat map for the tiny tables (camera ids, anomaly kinds, settings profiles)
+    // -- everything is stored inline, so it never allocates
+    // -- lookups compare all keys in a 16-byte block at once (SSE2 where available)
+    // -- keys are unordered; remove moves the last entry into the hole, so iteration order is not stable
+    // -- values don't need to be default constructible or copyable
+    //
+    template <
+        SmallFlatMapKey t_Key,
+        typename        t_Value,
+        size_t          t_Capacity = 16
+    >
+    class SmallFlatMap {
+    public:
+        using key_type       = t_Key;
+        using mapped_type    = t_Value;
+        using value_type     = std::pair<t_Key, t_Value>;
+        using size_type      = size_t;
+        using iterator       = FlatMapIterator<SmallFlatMap, false>;
+        using const_iterator = FlatMapIterator<SmallFlatMap, true>;
+
+        static constexpr size_t k_Capacity = t_Capacity;
+
+        SmallFlatMap() = default;
+        ~SmallFlatMap();
+
+        SmallFlatMap(const SmallFlatMap& other) requires std::is_copy_constructible_v<t_Value>;
+        SmallFlatMap(SmallFlatMap&& other) noexcept(std::is_nothrow_move_constructible_v<t_Value>);
+
+        SmallFlatMap& operator = (const SmallFlatMap& other) requires std::is_copy_constructible_v<t_Value>;
+        SmallFlatMap& operator = (SmallFlatMap&& other) noexcept(std::is_nothrow_move_constructible_v<t_Value>);
+
+        // all of these throw std::length_error when a new key doesn't fit anymore
+        void insert(const t_Key& key, t_Value&& value); // will overwrite if key is already present
+
+        // constructs the value in place, leaves an existing entry untouched
+        template <typename... t_Args>
+        std::pair<iterator, bool> try_emplace(const t_Key& key, t_Args&&... args);
+
+        // constructs the value in place, replaces an existing entry
+        // (by move assignment, for values that may throw when move constructed)
+        template <typename... t_Args>
+        t_Value& emplace(const t_Key& key, t_Args&&... args);
+
+        void remove(const t_Key& key); // will ignore keys that are not found
+
+        [[nodiscard]]       iterator find(const t_Key& key);
+        [[nodiscard]] const_iterator find(const t_Key& key) const;
+
+        [[nodiscard]] bool contains(const t_Key& key) const;
+
+        [[nodiscard]] size_t get_num_entries() const;
+        [[nodiscard]] size_t size()            const;
+        [[nodiscard]] bool   empty()           const;
+        [[nodiscard]] bool   is_full()         const;
+
+              t_Value& operator[](const t_Key& key);       // will throw when key is not found
+        const t_Value& operator[](const t_Key& key) const; // will throw when key is not found
+
+        void clear();
+
+        [[nodiscard]]       iterator begin();
+        [[nodiscard]]       iterator end();
+        [[nodiscard]] const_iterator begin()  const;
+        [[nodiscard]] const_iterator end()    const;
+        [[nodiscard]] const_iterator cbegin() const;
+        [[nodiscard]] const_iterator cend()   const;
+
+    private:
+        static constexpr size_t k_BlockSize = 16; // bytes compared at once
+        static constexpr size_t k_NotFound  = static_cast<size_t>(-1);
+
+        // the key array is padded to whole blocks, so the scan never reads past it
+        static constexpr size_t k_NumKeySlots = ((t_Capacity * sizeof(t_Key) + k_BlockSize - 1) / k_BlockSize) * k_BlockSize / sizeof(t_Key);
+
+        [[nodiscard]] size_t find_idx(const t_Key& key) const; // k_NotFound if the key is not present
+
+        template <typename... t_Args>
+        void append(const t_Key& key, t_Args&&... args);
+
+        template <typename, bool>
+        friend class FlatMapIterator;
+
+        [[nodiscard]] const t_Key&   get_key  (size_t idx) const;
+        [[nodiscard]]       t_Value& get_value(size_t idx);
+        [[nodiscard]] const t_Value& get_value(size_t idx) const;
+
+        // values are constructed and destroyed explicitly, only the first m_NumEntries are alive
+        union ValueSlot {
+             ValueSlot() {}
+            ~ValueSlot() {}
+
+            t_Value m_Value;
+        };
+
+        alignas(k_BlockSize) std::array<t_Key, k_NumKeySlots> m_Keys = {};
+
+        std::array<ValueSlot, t_Capacity> m_Values;
+        size_t                            m_NumEntries = 0;
+    };
+}
+
+#include "small_flat_map.inl"
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef UTIL_SMALL_FLAT_MAP_INL
+#define UTIL_SMALL_FLAT_MAP_INL
+
+#include "small_flat_map.h"
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#ifdef CC_SMALL_FLAT_MAP_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace cc {
+    template <SmallFlatMapKey K, typename V, size_t N>
+    SmallFlatMap<K, V, N>::~SmallFlatMap() {
+        clear();
+    }
+
+    // delegating to the default constructor means the object is complete, so the destructor cleans up if a copy throws
+    template <SmallFlatMapKey K, typename V, size_t N>
+    SmallFlatMap<K, V, N>::SmallFlatMap(const SmallFlatMap& other) requires std::is_copy_constructible_v<V>:
+        SmallFlatMap()
+    {
+        *this = other;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    SmallFlatMap<K, V, N>::SmallFlatMap(SmallFlatMap&& other) noexcept(std::is_nothrow_move_constructible_v<V>):
+        SmallFlatMap()
+    {
+        *this = std::move(other);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    SmallFlatMap<K, V, N>& SmallFlatMap<K, V, N>::operator = (const SmallFlatMap& other) requires std::is_copy_constructible_v<V> {
+        if (this == &other)
+            return *this;
+
+        clear();
+
+        m_Keys = other.m_Keys;
+
+        for (; m_NumEntries < other.m_NumEntries; ++m_NumEntries)
+            std::construct_at(&m_Values[m_NumEntries].m_Value, other.get_value(m_NumEntries));
+
+        return *this;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    SmallFlatMap<K, V, N>& SmallFlatMap<K, V, N>::operator = (SmallFlatMap&& other) noexcept(std::is_nothrow_move_constructible_v<V>) {
+        if (this == &other)
+            return *this;
+
+        clear();
+
+        m_Keys = other.m_Keys;
+
+        for (; m_NumEntries < other.m_NumEntries; ++m_NumEntries)
+            std::construct_at(&m_Values[m_NumEntries].m_Value, std::move(other.get_value(m_NumEntries)));
+
+        other.clear();
+
+        return *this;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    void SmallFlatMap<K, V, N>::insert(const K& key, V&& value) {
+        if (size_t idx = find_idx(key); idx != k_NotFound)
+            get_value(idx) = std::forward<V>(value); // overwrite the current entry
+        else
+            append(key, std::forward<V>(value));
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    template <typename... t_Args>
+    std::pair<typename SmallFlatMap<K, V, N>::iterator, bool> SmallFlatMap<K, V, N>::try_emplace(const K& key, t_Args&&... args) {
+        if (size_t idx = find_idx(key); idx != k_NotFound)
+            return { iterator(this, idx), false };
+
+        append(key, std::forward<t_Args>(args)...);
+
+        return { iterator(this, m_NumEntries - 1), true };
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    template <typename... t_Args>
+    V& SmallFlatMap<K, V, N>::emplace(const K& key, t_Args&&... args) {
+        if (size_t idx = find_idx(key); idx != k_NotFound) {
+            // construct before destroying the current value, the arguments may refer to it
+            V value(std::forward<t_Args>(args)...);
+
+            if constexpr (std::is_nothrow_move_constructible_v<V>) {
+                std::destroy_at  (&m_Values[idx].m_Value);
+                std::construct_at(&m_Values[idx].m_Value, std::move(value));
+            }
+            else
+                // a move that throws after the destroy would leave a counted slot without a value in it;
+                // assigning keeps the current value alive
+                get_value(idx) = std::move(value);
+
+            return get_value(idx);
+        }
+
+        append(key, std::forward<t_Args>(args)...);
+
+        return get_value(m_NumEntries - 1);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    void SmallFlatMap<K, V, N>::remove(const K& key) {
+        size_t idx = find_idx(key);
+
+        if (idx == k_NotFound)
+            return; // silently ignore key not found
+
+        const size_t last_idx = m_NumEntries - 1;
+
+        // fill the hole with the last entry
+        if (idx != last_idx) {
+            if constexpr (std::is_nothrow_move_constructible_v<V>) {
+                std::destroy_at  (&m_Values[idx].m_Value);
+                std::construct_at(&m_Values[idx].m_Value, std::move(get_value(last_idx)));
+            }
+            else
+                // a move that throws after the destroy would leave a counted slot without a value in it;
+                // assigning keeps the removed value alive until the move succeeded
+                get_value(idx) = std::move(get_value(last_idx));
+
+            m_Keys[idx] = m_Keys[last_idx];
+        }
+
+        std::destroy_at(&m_Values[last_idx].m_Value);
+
+        --m_NumEntries;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    typename SmallFlatMap<K, V, N>::iterator SmallFlatMap<K, V, N>::find(const K& key) {
+        size_t idx = find_idx(key);
+
+        if (idx == k_NotFound)
+            return end();
+
+        return iterator(this, idx);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    typename SmallFlatMap<K, V, N>::const_iterator SmallFlatMap<K, V, N>::find(const K& key) const {
+        size_t idx = find_idx(key);
+
+        if (idx == k_NotFound)
+            return end();
+
+        return const_iterator(this, idx);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    bool SmallFlatMap<K, V, N>::contains(const K& key) const {
+        return find_idx(key) != k_NotFound;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    size_t SmallFlatMap<K, V, N>::get_num_entries() const {
+        return m_NumEntries;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    size_t SmallFlatMap<K, V, N>::size() const {
+        return m_NumEntries;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    bool SmallFlatMap<K, V, N>::empty() const {
+        return m_NumEntries == 0;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    bool SmallFlatMap<K, V, N>::is_full() const {
+        return m_NumEntries == N;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    V& SmallFlatMap<K, V, N>::operator[](const K& key) {
+        size_t idx = find_idx(key);
+
+        if (idx == k_NotFound)
+            throw std::runtime_error("Key not found");
+
+        return get_value(idx);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    const V& SmallFlatMap<K, V, N>::operator[](const K& key) const {
+        size_t idx = find_idx(key);
+
+        if (idx == k_NotFound)
+            throw std::runtime_error("Key not found");
+
+        return get_value(idx);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    void SmallFlatMap<K, V, N>::clear() {
+        for (size_t i = 0; i < m_NumEntries; ++i)
+            std::destroy_at(&m_Values[i].m_Value);
+
+        m_NumEntries = 0;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    typename SmallFlatMap<K, V, N>::iterator SmallFlatMap<K, V, N>::begin() {
+        return iterator(this, 0);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    typename SmallFlatMap<K, V, N>::iterator SmallFlatMap<K, V, N>::end() {
+        return iterator(this, m_NumEntries);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    typename SmallFlatMap<K, V, N>::const_iterator SmallFlatMap<K, V, N>::begin() const {
+        return const_iterator(this, 0);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    typename SmallFlatMap<K, V, N>::const_iterator SmallFlatMap<K, V, N>::end() const {
+        return const_iterator(this, m_NumEntries);
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    typename SmallFlatMap<K, V, N>::const_iterator SmallFlatMap<K, V, N>::cbegin() const {
+        return begin();
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    typename SmallFlatMap<K, V, N>::const_iterator SmallFlatMap<K, V, N>::cend() const {
+        return end();
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    size_t SmallFlatMap<K, V, N>::find_idx(const K& key) const {
+        // compare the bit patterns, the key type doesn't need an operator ==
+        using Bits =
+            std::conditional_t<sizeof(K) == 1, uint8_t,
+            std::conditional_t<sizeof(K) == 2, uint16_t,
+            std::conditional_t<sizeof(K) == 4, uint32_t,
+                                               uint64_t>>>;
+
+        const Bits needle_bits = std::bit_cast<Bits>(key);
+
+#ifdef CC_SMALL_FLAT_MAP_SSE2
+        __m128i needle;
+
+        if constexpr (sizeof(K) == 1) needle = _mm_set1_epi8   (static_cast<char>     (needle_bits));
+        if constexpr (sizeof(K) == 2) needle = _mm_set1_epi16  (static_cast<short>    (needle_bits));
+        if constexpr (sizeof(K) == 4) needle = _mm_set1_epi32  (static_cast<int>      (needle_bits));
+        if constexpr (sizeof(K) == 8) needle = _mm_set1_epi64x (static_cast<long long>(needle_bits));
+
+        const size_t num_bytes = m_NumEntries * sizeof(K);
+        const auto*  bytes     = reinterpret_cast<const std::byte*>(m_Keys.data());
+
+        for (size_t offset = 0; offset < num_bytes; offset += k_BlockSize) {
+            __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes + offset));
+            __m128i equal;
+
+            if constexpr (sizeof(K) == 1) equal = _mm_cmpeq_epi8 (block, needle);
+            if constexpr (sizeof(K) == 2) equal = _mm_cmpeq_epi16(block, needle);
+            if constexpr (sizeof(K) == 4) equal = _mm_cmpeq_epi32(block, needle);
+
+            if constexpr (sizeof(K) == 8) {
+                // SSE2 has no 64-bit compare; both 32-bit halves have to match
+                __m128i halves = _mm_cmpeq_epi32(block, needle);
+                equal = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+
+            // one bit per byte
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+
+            // ignore the slots past the last entry
+            if (size_t remaining = num_bytes - offset; remaining < k_BlockSize)
+                mask &= (1u << remaining) - 1;
+
+            if (mask != 0)
+                return (offset + static_cast<size_t>(std::countr_zero(mask))) / sizeof(K);
+        }
+#else
+        for (size_t i = 0; i < m_NumEntries; ++i)
+            if (std::bit_cast<Bits>(m_Keys[i]) == needle_bits)
+                return i;
+#endif
+
+        return k_NotFound;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    template <typename... t_Args>
+    void SmallFlatMap<K, V, N>::append(const K& key, t_Args&&... args) {
+        if (m_NumEntries == N)
+            throw std::length_error("SmallFlatMap is full");
+
+        std::construct_at(&m_Values[m_NumEntries].m_Value, std::forward<t_Args>(args)...);
+
+        m_Keys[m_NumEntries] = key;
+        ++m_NumEntries;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    const K& SmallFlatMap<K, V, N>::get_key(size_t idx) const {
+        return m_Keys[idx];
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    V& SmallFlatMap<K, V, N>::get_value(size_t idx) {
+        return m_Values[idx].m_Value;
+    }
+
+    template <SmallFlatMapKey K, typename V, size_t N>
+    const V& SmallFlatMap<K, V, N>::get_value(size_t idx) const {
+        return m_Values[idx].m_Value;
+    }
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef UTIL_SORTED_FLAT_MAP_H
+#define UTIL_SORTED_FLAT_MAP_H
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flat_map_iterator.h"
+
+namespace cc {
+    //
+    // flat map that keeps its keys sorted, so lookups are a binary search instead of a linear scan
+    // -- same interface as FlatMap, plus iteration in key order, heterogeneous find and bulk insertion
+    // -- keys and values are kept in separate vectors (like std::flat_map), iterators dereference to
+    //    std::pair<const t_Key&, t_Value&>
+    // -- insert and remove are still O(n) because of the shifting, use insert_range for bulk construction
+    //
+    template <
+        typename t_Key,
+        typename t_Value,
+        typename t_Compare = std::less<>
+    >
+    class SortedFlatMap {
+    private:
+        // lookups with other key types (e.g. std::string_view for std::string keys) need a transparent comparator
+        template <typename K>
+        static constexpr bool k_IsLookupKey =
+            std::is_same_v<K, t_Key> ||
+            requires { typename t_Compare::is_transparent; };
+
+    public:
+        using key_type       = t_Key;
+        using mapped_type    = t_Value;
+        using value_type     = std::pair<t_Key, t_Value>;
+        using key_compare    = t_Compare;
+        using size_type      = size_t;
+        using iterator       = FlatMapIterator<SortedFlatMap, false>;
+        using const_iterator = FlatMapIterator<SortedFlatMap, true>;
+
+        void reserve(size_t num_entries);
+
+        void insert(const t_Key& key, t_Value&& value); // will overwrite if key is already present
+        void remove(const t_Key& key);                  // will ignore keys that are not found
+
+        // sorts and deduplicates once, instead of once per entry
+        // entries later in the range overwrite earlier ones (and the ones already in the map)
+        // leaves the map unchanged when a copy or comparison throws
+        template <typename t_Range>
+        void insert_range(t_Range&& key_value_pairs);
+
+        template <typename K = t_Key>
+        [[nodiscard]] iterator find(const K& key);
+
+        template <typename K = t_Key>
+        [[nodiscard]] const_iterator find(const K& key) const;
+
+        template <typename K = t_Key>
+        [[nodiscard]] bool contains(const K& key) const;
+
+        [[nodiscard]] size_t get_num_entries() const;
+        [[nodiscard]] size_t size()            const;
+        [[nodiscard]] bool   empty()           const;
+
+              t_Value& operator[](const t_Key& key);       // will throw when key is not found
+        const t_Value& operator[](const t_Key& key) const; // will throw when key is not found
+
+        void clear();
+
+        [[nodiscard]]       iterator begin();
+        [[nodiscard]]       iterator end();
+        [[nodiscard]] const_iterator begin()  const;
+        [[nodiscard]] const_iterator end()    const;
+        [[nodiscard]] const_iterator cbegin() const;
+        [[nodiscard]] const_iterator cend()   const;
+
+        [[nodiscard]] const std::vector<t_Key>&   keys()   const;
+        [[nodiscard]] const std::vector<t_Value>& values() const;
+
+    private:
+        // index of the first key that is not less than the given key
+        template <typename K>
+        [[nodiscard]] size_t lower_bound_idx(const K& key) const;
+
+        template <typename K>
+        [[nodiscard]] bool is_match(size_t idx, const K& key) const;
+
+        template <typename, bool>
+        friend class FlatMapIterator;
+
+        [[nodiscard]] const t_Key&   get_key  (size_t idx) const;
+        [[nodiscard]]       t_Value& get_value(size_t idx);
+        [[nodiscard]] const t_Value& get_value(size_t idx) const;
+
+        std::vector<t_Key>   m_Keys; // sorted
+        std::vector<t_Value> m_Values;
+
+        t_Compare m_Compare;
+    };
+}
+
+#include "sorted_flat_map.inl"
+
+#endif
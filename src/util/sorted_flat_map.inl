@@ -0,0 +1,283 @@
+#ifndef UTIL_SORTED_FLAT_MAP_INL
+#define UTIL_SORTED_FLAT_MAP_INL
+
+#include "sorted_flat_map.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace cc {
+    template <typename K, typename V, typename C>
+    void SortedFlatMap<K, V, C>::reserve(size_t num_entries) {
+        m_Keys.reserve(num_entries);
+        m_Values.reserve(num_entries);
+    }
+
+    template <typename K, typename V, typename C>
+    void SortedFlatMap<K, V, C>::insert(const K& key, V&& value) {
+        size_t idx = lower_bound_idx(key);
+
+        if (is_match(idx, key)) {
+            // overwrite the current entry
+            m_Values[idx] = std::forward<V>(value);
+        }
+        else {
+            // create a new entry, at the position that keeps the keys sorted
+            m_Keys  .insert(std::next(std::begin(m_Keys),   idx), key);
+            m_Values.insert(std::next(std::begin(m_Values), idx), std::forward<V>(value));
+        }
+    }
+
+    template <typename K, typename V, typename C>
+    void SortedFlatMap<K, V, C>::remove(const K& key) {
+        size_t idx = lower_bound_idx(key);
+
+        if (!is_match(idx, key))
+            return; // silently ignore key not found
+
+        m_Keys  .erase(std::next(std::begin(m_Keys),   idx));
+        m_Values.erase(std::next(std::begin(m_Values), idx));
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename t_Range>
+    void SortedFlatMap<K, V, C>::insert_range(t_Range&& key_value_pairs) {
+        // the new entries are collected and sorted on the side, then merged with the existing ones into new vectors;
+        // the map only changes once nothing can throw anymore, so a throwing copy or comparison leaves it as it was
+        std::vector<K> new_keys;
+        std::vector<V> new_values;
+
+        for (auto&& [key, value] : key_value_pairs) {
+            if constexpr (std::is_lvalue_reference_v<t_Range>) {
+                new_keys  .push_back(key);
+                new_values.push_back(value);
+            }
+            else {
+                new_keys  .push_back(std::move(key));
+                new_values.push_back(std::move(value));
+            }
+        }
+
+        if (new_keys.empty())
+            return;
+
+        // sort an index permutation; stable, so of a series of equal keys the last one inserted is the last one in the series
+        std::vector<size_t> order(new_keys.size());
+        std::iota(std::begin(order), std::end(order), size_t(0));
+
+        std::ranges::stable_sort(order, [&](size_t a, size_t b) {
+            return m_Compare(new_keys[a], new_keys[b]);
+        });
+
+        // where every entry of the result comes from -- indices below num_existing are existing entries, the others
+        // are num_existing + the index of a new entry
+        const size_t num_existing = m_Keys.size();
+
+        std::vector<size_t> sources;
+        sources.reserve(num_existing + order.size());
+
+        size_t existing_idx = 0;
+
+        for (size_t i = 0; i < order.size(); ++i) {
+            size_t idx = order[i];
+
+            // skip entries that are followed by an equal key
+            if (i + 1 < order.size() && !m_Compare(new_keys[idx], new_keys[order[i + 1]]))
+                continue;
+
+            while (existing_idx < num_existing && m_Compare(m_Keys[existing_idx], new_keys[idx]))
+                sources.push_back(existing_idx++);
+
+            // and existing entries with an equal key are overwritten
+            if (existing_idx < num_existing && !m_Compare(new_keys[idx], m_Keys[existing_idx]))
+                ++existing_idx;
+
+            sources.push_back(num_existing + idx);
+        }
+
+        while (existing_idx < num_existing)
+            sources.push_back(existing_idx++);
+
+        std::vector<K> merged_keys;
+        std::vector<V> merged_values;
+
+        merged_keys  .reserve(std::max(m_Keys.capacity(),   sources.size()));
+        merged_values.reserve(std::max(m_Values.capacity(), sources.size()));
+
+        // like std::vector does when it grows, the existing entries are copied when moving them could throw, so they
+        // are still intact if this fails (move-only types are moved regardless)
+        constexpr bool k_MoveExisting =
+            (std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>) ||
+            !(std::is_copy_constructible_v<K> && std::is_copy_constructible_v<V>);
+
+        for (size_t source : sources) {
+            if (source >= num_existing) {
+                merged_keys  .push_back(std::move(new_keys  [source - num_existing]));
+                merged_values.push_back(std::move(new_values[source - num_existing]));
+            }
+            else if constexpr (k_MoveExisting) {
+                merged_keys  .push_back(std::move(m_Keys  [source]));
+                merged_values.push_back(std::move(m_Values[source]));
+            }
+            else {
+                merged_keys  .push_back(m_Keys  [source]);
+                merged_values.push_back(m_Values[source]);
+            }
+        }
+
+        m_Keys   = std::move(merged_keys);
+        m_Values = std::move(merged_values);
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename t_LookupKey>
+    typename SortedFlatMap<K, V, C>::iterator SortedFlatMap<K, V, C>::find(const t_LookupKey& key) {
+        size_t idx = lower_bound_idx(key);
+
+        if (!is_match(idx, key))
+            return end();
+
+        return iterator(this, idx);
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename t_LookupKey>
+    typename SortedFlatMap<K, V, C>::const_iterator SortedFlatMap<K, V, C>::find(const t_LookupKey& key) const {
+        size_t idx = lower_bound_idx(key);
+
+        if (!is_match(idx, key))
+            return end();
+
+        return const_iterator(this, idx);
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename t_LookupKey>
+    bool SortedFlatMap<K, V, C>::contains(const t_LookupKey& key) const {
+        return is_match(lower_bound_idx(key), key);
+    }
+
+    template <typename K, typename V, typename C>
+    size_t SortedFlatMap<K, V, C>::get_num_entries() const {
+        return m_Keys.size();
+    }
+
+    template <typename K, typename V, typename C>
+    size_t SortedFlatMap<K, V, C>::size() const {
+        return m_Keys.size();
+    }
+
+    template <typename K, typename V, typename C>
+    bool SortedFlatMap<K, V, C>::empty() const {
+        return m_Keys.empty();
+    }
+
+    template <typename K, typename V, typename C>
+    V& SortedFlatMap<K, V, C>::operator[](const K& key) {
+        size_t idx = lower_bound_idx(key);
+
+        if (!is_match(idx, key))
+            throw std::runtime_error("Key not found");
+
+        return m_Values[idx];
+    }
+
+    template <typename K, typename V, typename C>
+    const V& SortedFlatMap<K, V, C>::operator[](const K& key) const {
+        size_t idx = lower_bound_idx(key);
+
+        if (!is_match(idx, key))
+            throw std::runtime_error("Key not found");
+
+        return m_Values[idx];
+    }
+
+    template <typename K, typename V, typename C>
+    void SortedFlatMap<K, V, C>::clear() {
+        m_Keys.clear();
+        m_Values.clear();
+    }
+
+    template <typename K, typename V, typename C>
+    typename SortedFlatMap<K, V, C>::iterator SortedFlatMap<K, V, C>::begin() {
+        return iterator(this, 0);
+    }
+
+    template <typename K, typename V, typename C>
+    typename SortedFlatMap<K, V, C>::iterator SortedFlatMap<K, V, C>::end() {
+        return iterator(this, m_Keys.size());
+    }
+
+    template <typename K, typename V, typename C>
+    typename SortedFlatMap<K, V, C>::const_iterator SortedFlatMap<K, V, C>::begin() const {
+        return const_iterator(this, 0);
+    }
+
+    template <typename K, typename V, typename C>
+    typename SortedFlatMap<K, V, C>::const_iterator SortedFlatMap<K, V, C>::end() const {
+        return const_iterator(this, m_Keys.size());
+    }
+
+    template <typename K, typename V, typename C>
+    typename SortedFlatMap<K, V, C>::const_iterator SortedFlatMap<K, V, C>::cbegin() const {
+        return begin();
+    }
+
+    template <typename K, typename V, typename C>
+    typename SortedFlatMap<K, V, C>::const_iterator SortedFlatMap<K, V, C>::cend() const {
+        return end();
+    }
+
+    template <typename K, typename V, typename C>
+    const std::vector<K>& SortedFlatMap<K, V, C>::keys() const {
+        return m_Keys;
+    }
+
+    template <typename K, typename V, typename C>
+    const std::vector<V>& SortedFlatMap<K, V, C>::values() const {
+        return m_Values;
+    }
+
+    template <typename K, typename V, typename C>
+    const K& SortedFlatMap<K, V, C>::get_key(size_t idx) const {
+        return m_Keys[idx];
+    }
+
+    template <typename K, typename V, typename C>
+    V& SortedFlatMap<K, V, C>::get_value(size_t idx) {
+        return m_Values[idx];
+    }
+
+    template <typename K, typename V, typename C>
+    const V& SortedFlatMap<K, V, C>::get_value(size_t idx) const {
+        return m_Values[idx];
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename t_LookupKey>
+    size_t SortedFlatMap<K, V, C>::lower_bound_idx(const t_LookupKey& key) const {
+        static_assert(k_IsLookupKey<t_LookupKey>, "Lookups with a different key type require a transparent comparator");
+
+        auto it = std::lower_bound(
+            std::begin(m_Keys),
+            std::end(m_Keys),
+            key,
+            m_Compare
+        );
+
+        return static_cast<size_t>(std::distance(std::begin(m_Keys), it));
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename t_LookupKey>
+    bool SortedFlatMap<K, V, C>::is_match(size_t idx, const t_LookupKey& key) const {
+        // lower_bound guarantees !(m_Keys[idx] < key), so equivalence only needs the other direction
+        return
+            idx < m_Keys.size() &&
+            !m_Compare(key, m_Keys[idx]);
+    }
+}
+
+#endif
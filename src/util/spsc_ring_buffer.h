@@ -0,0 +1,42 @@
+#ifndef CC_UTIL_SPSC_RING_BUFFER_H
+#define CC_UTIL_SPSC_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace cc::util {
+    //
+    // fixed capacity, lock-free single-producer/single-consumer queue
+    // slots are written and read in-place, so no copies are needed to hand a record over
+    //
+    template <typename T>
+    class SpscRingBuffer {
+    public:
+        explicit SpscRingBuffer(size_t min_capacity); // rounded up to a power of two
+
+        // producer side; begin_write returns nullptr when the buffer is full
+        [[nodiscard]] T* begin_write();
+                      void end_write();   // publishes the slot obtained from begin_write
+
+        // consumer side; begin_read returns nullptr when the buffer is empty
+        [[nodiscard]] T* begin_read();
+                      void end_read();    // releases the slot obtained from begin_read
+
+        [[nodiscard]] size_t get_capacity() const;
+        [[nodiscard]] bool   is_empty() const;
+
+    private:
+        static constexpr size_t k_CacheLine = 64;
+
+        std::unique_ptr<T[]> m_Slots;
+        size_t               m_Mask;
+
+        alignas(k_CacheLine) std::atomic<size_t> m_WriteIdx = 0;
+        alignas(k_CacheLine) std::atomic<size_t> m_ReadIdx  = 0;
+    };
+}
+
+#include "spsc_ring_buffer.inl"
+
+#endif
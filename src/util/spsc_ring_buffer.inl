@@ -0,0 +1,68 @@
+#ifndef CC_UTIL_SPSC_RING_BUFFER_INL
+#define CC_UTIL_SPSC_RING_BUFFER_INL
+
+#include "spsc_ring_buffer.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace cc::util {
+    template <typename T>
+    SpscRingBuffer<T>::SpscRingBuffer(size_t min_capacity):
+        m_Slots(std::make_unique<T[]>(std::bit_ceil(std::max<size_t>(min_capacity, 2)))),
+        m_Mask (std::bit_ceil(std::max<size_t>(min_capacity, 2)) - 1)
+    {
+    }
+
+    template <typename T>
+    T* SpscRingBuffer<T>::begin_write() {
+        size_t write = m_WriteIdx.load(std::memory_order_relaxed);
+        size_t read  = m_ReadIdx .load(std::memory_order_acquire);
+
+        if (write - read > m_Mask)
+            return nullptr; // full
+
+        return &m_Slots[write & m_Mask];
+    }
+
+    template <typename T>
+    void SpscRingBuffer<T>::end_write() {
+        m_WriteIdx.store(
+            m_WriteIdx.load(std::memory_order_relaxed) + 1,
+            std::memory_order_release
+        );
+    }
+
+    template <typename T>
+    T* SpscRingBuffer<T>::begin_read() {
+        size_t read  = m_ReadIdx .load(std::memory_order_relaxed);
+        size_t write = m_WriteIdx.load(std::memory_order_acquire);
+
+        if (read == write)
+            return nullptr; // empty
+
+        return &m_Slots[read & m_Mask];
+    }
+
+    template <typename T>
+    void SpscRingBuffer<T>::end_read() {
+        m_ReadIdx.store(
+            m_ReadIdx.load(std::memory_order_relaxed) + 1,
+            std::memory_order_release
+        );
+    }
+
+    template <typename T>
+    size_t SpscRingBuffer<T>::get_capacity() const {
+        return m_Mask + 1;
+    }
+
+    template <typename T>
+    bool SpscRingBuffer<T>::is_empty() const {
+        return
+            m_ReadIdx .load(std::memory_order_acquire) ==
+            m_WriteIdx.load(std::memory_order_acquire);
+    }
+}
+
+#endif
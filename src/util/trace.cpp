@@ -0,0 +1,208 @@
+#include "trace.h"
+
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+    std::atomic<uint64_t> g_NextTracerId = 1;
+
+    void write_json_string(std::ostream& os, std::string_view str) {
+        os << '"';
+
+        for (char c : str) {
+            switch (c) {
+                case '"':  os << "\\\""; break;
+                case '\\': os << "\\\\"; break;
+                case '\n': os << "\\n";  break;
+                case '\t': os << "\\t";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        os << ' ';
+                    else
+                        os << c;
+            }
+        }
+
+        os << '"';
+    }
+}
+
+namespace cc::util {
+    Tracer::ThreadBuffer::ThreadBuffer(size_t capacity, uint32_t thread_idx):
+        m_Events   (std::make_unique<Event[]>(capacity)),
+        m_Capacity (capacity),
+        m_ThreadIdx(thread_idx)
+    {
+    }
+
+    Tracer::Tracer(size_t events_per_thread):
+        m_Id             (g_NextTracerId.fetch_add(1, std::memory_order_relaxed)),
+        m_EventsPerThread(events_per_thread)
+    {
+    }
+
+    void Tracer::start() {
+        std::unique_lock guard(m_Mutex);
+
+        m_CaptureStart = Clock::now();
+
+        // threads reset their own buffer when they notice the new generation
+        m_Generation.fetch_add(1, std::memory_order_release);
+        m_Capturing.store(true, std::memory_order_relaxed);
+    }
+
+    void Tracer::stop() {
+        m_Capturing.store(false, std::memory_order_relaxed);
+    }
+
+    void Tracer::record(const char* name, TimePoint begin, TimePoint end) {
+        // scopes that end after stop() are not part of the capture either
+        if (!is_capturing())
+            return;
+
+        ThreadBuffer* buffer     = get_thread_buffer();
+        uint64_t      generation = m_Generation.load(std::memory_order_acquire);
+        size_t        size       = 0;
+
+        if (buffer->m_Generation.load(std::memory_order_relaxed) != generation) {
+            buffer->m_Size      .store(0,          std::memory_order_relaxed);
+            buffer->m_NumDropped.store(0,          std::memory_order_relaxed);
+            buffer->m_Generation.store(generation, std::memory_order_release);
+        }
+        else
+            size = buffer->m_Size.load(std::memory_order_relaxed);
+
+        if (size >= buffer->m_Capacity) {
+            buffer->m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer->m_Events[size] = { name, begin, end };
+        buffer->m_Size.store(size + 1, std::memory_order_release);
+    }
+
+    void Tracer::set_thread_name(const char* name) {
+        get_thread_buffer()->m_ThreadName.store(name, std::memory_order_relaxed);
+    }
+
+    void Tracer::write_chrome_trace(std::ostream& os) const {
+        using micros = std::chrono::duration<double, std::micro>;
+
+        std::unique_lock guard(m_Mutex);
+
+        uint64_t generation = m_Generation.load(std::memory_order_relaxed);
+        bool     first      = true;
+
+        auto separator = [&] {
+            if (!first)
+                os << ",\n";
+
+            first = false;
+        };
+
+        auto flags     = os.flags();
+        auto precision = os.precision();
+
+        os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" << std::fixed << std::setprecision(3);
+
+        for (const auto& buffer : m_Buffers) {
+            if (const char* thread_name = buffer->m_ThreadName.load(std::memory_order_relaxed)) {
+                separator();
+
+                os << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->m_ThreadIdx << R"(,"args":{"name":)";
+                write_json_string(os, thread_name);
+                os << "}}";
+            }
+
+            if (buffer->m_Generation.load(std::memory_order_acquire) != generation)
+                continue;
+
+            size_t size = buffer->m_Size.load(std::memory_order_acquire);
+
+            for (size_t i = 0; i < size; ++i) {
+                const Event& evt = buffer->m_Events[i];
+
+                // scopes that were opened during a previous capture
+                if (evt.m_Begin < m_CaptureStart)
+                    continue;
+
+                separator();
+
+                os << R"({"name":)";
+                write_json_string(os, evt.m_Name);
+                os
+                    << R"(,"cat":"cc","ph":"X","pid":1,"tid":)" << buffer->m_ThreadIdx
+                    << R"(,"ts":)"  << micros(evt.m_Begin - m_CaptureStart).count()
+                    << R"(,"dur":)" << micros(evt.m_End   - evt.m_Begin)   .count()
+                    << "}";
+            }
+        }
+
+        os << "\n]}\n";
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    void Tracer::save_chrome_trace(const std::filesystem::path& p) const {
+        std::ofstream out(p);
+
+        if (!out)
+            throw std::runtime_error("Failed to open file: " + p.string());
+
+        write_chrome_trace(out);
+    }
+
+    size_t Tracer::get_num_events() const {
+        std::unique_lock guard(m_Mutex);
+
+        uint64_t generation = m_Generation.load(std::memory_order_relaxed);
+        size_t   result     = 0;
+
+        for (const auto& buffer : m_Buffers)
+            if (buffer->m_Generation.load(std::memory_order_acquire) == generation)
+                result += buffer->m_Size.load(std::memory_order_acquire);
+
+        return result;
+    }
+
+    size_t Tracer::get_num_dropped() const {
+        std::unique_lock guard(m_Mutex);
+
+        uint64_t generation = m_Generation.load(std::memory_order_relaxed);
+        size_t   result     = 0;
+
+        for (const auto& buffer : m_Buffers)
+            if (buffer->m_Generation.load(std::memory_order_acquire) == generation)
+                result += buffer->m_NumDropped.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    Tracer::ThreadBuffer* Tracer::get_thread_buffer() {
+        // a thread typically only ever records into a single tracer, so cache just one
+        struct Cache {
+            uint64_t      m_TracerId = 0;
+            ThreadBuffer* m_Buffer   = nullptr;
+        };
+
+        thread_local Cache cache;
+
+        if (cache.m_TracerId != m_Id) {
+            std::unique_lock guard(m_Mutex);
+
+            m_Buffers.push_back(std::make_unique<ThreadBuffer>(
+                m_EventsPerThread,
+                static_cast<uint32_t>(m_Buffers.size())
+            ));
+
+            cache.m_TracerId = m_Id;
+            cache.m_Buffer   = m_Buffers.back().get();
+        }
+
+        return cache.m_Buffer;
+    }
+}
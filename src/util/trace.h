@@ -0,0 +1,130 @@
+#ifndef CC_UTIL_TRACE_H
+#define CC_UTIL_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cc::util {
+    /*
+     * Scoped timing events, collected in per-thread buffers and exported as Chrome trace-event JSON
+     * (open with https://ui.perfetto.dev or chrome://tracing)
+     *
+     * Events are only recorded between start() and stop(); outside of a capture a trace scope costs
+     * a single relaxed atomic load. During a capture every thread appends to its own fixed size
+     * buffer without synchronization; events that don't fit are dropped (and counted).
+     *
+     * Event and thread names must have static storage duration (string literals).
+     */
+    class Tracer {
+    public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        static constexpr size_t k_DefaultEventsPerThread = size_t(1) << 16;
+
+        static Tracer& instance() { static Tracer x; return x; }
+
+        explicit Tracer(size_t events_per_thread = k_DefaultEventsPerThread);
+
+        Tracer             (const Tracer&) = delete;
+        Tracer& operator = (const Tracer&) = delete;
+        Tracer             (Tracer&&) noexcept = delete;
+        Tracer& operator = (Tracer&&) noexcept = delete;
+
+        void start(); // discards the events of a previous capture
+        void stop();
+
+        [[nodiscard]] bool is_capturing() const { return m_Capturing.load(std::memory_order_relaxed); }
+
+        void record(const char* name, TimePoint begin, TimePoint end); // ignored outside of a capture
+        void set_thread_name(const char* name); // applies to the calling thread
+
+        // only valid after stop()
+        void write_chrome_trace(std::ostream& os) const;
+        void save_chrome_trace(const std::filesystem::path& p) const;
+
+        [[nodiscard]] size_t get_num_events()  const;
+        [[nodiscard]] size_t get_num_dropped() const;
+
+    private:
+        struct Event {
+            const char* m_Name;
+            TimePoint   m_Begin;
+            TimePoint   m_End;
+        };
+
+        struct ThreadBuffer {
+            ThreadBuffer(size_t capacity, uint32_t thread_idx);
+
+            std::unique_ptr<Event[]>  m_Events;
+            size_t                    m_Capacity;
+            uint32_t                  m_ThreadIdx;
+            std::atomic<const char*>  m_ThreadName = nullptr;
+
+            std::atomic<uint64_t>     m_Generation = 0; // capture that m_Size refers to
+            std::atomic<size_t>       m_Size       = 0;
+            std::atomic<size_t>       m_NumDropped = 0;
+        };
+
+        ThreadBuffer* get_thread_buffer(); // registers the calling thread on first use
+
+        uint64_t m_Id; // distinguishes tracers in the per-thread buffer cache
+        size_t   m_EventsPerThread;
+
+        std::atomic<bool>     m_Capturing  = false;
+        std::atomic<uint64_t> m_Generation = 0;
+        TimePoint             m_CaptureStart;
+
+        mutable std::mutex                         m_Mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;
+    };
+
+    // records an event from construction to destruction, if a capture was active at construction
+    class TraceScope {
+    public:
+        explicit TraceScope(const char* name);
+        ~TraceScope();
+
+        TraceScope             (const TraceScope&) = delete;
+        TraceScope& operator = (const TraceScope&) = delete;
+        TraceScope             (TraceScope&&) noexcept = delete;
+        TraceScope& operator = (TraceScope&&) noexcept = delete;
+
+    private:
+        const char*       m_Name = nullptr;
+        Tracer::TimePoint m_Begin;
+    };
+
+    // inline, these are on the hot path
+    inline TraceScope::TraceScope(const char* name) {
+        if (Tracer::instance().is_capturing()) {
+            m_Name  = name;
+            m_Begin = Tracer::Clock::now();
+        }
+    }
+
+    inline TraceScope::~TraceScope() {
+        if (m_Name)
+            Tracer::instance().record(m_Name, m_Begin, Tracer::Clock::now());
+    }
+}
+
+// instrumentation macros; these compile to nothing unless CC_ENABLE_TRACING is defined
+#define CC_TRACE_CONCAT_IMPL(a, b) a##b
+#define CC_TRACE_CONCAT(a, b)      CC_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef CC_ENABLE_TRACING
+    #define CC_TRACE_SCOPE(name)       cc::util::TraceScope CC_TRACE_CONCAT(cc_trace_scope_, __LINE__)(name)
+    #define CC_TRACE_THREAD_NAME(name) cc::util::Tracer::instance().set_thread_name(name)
+#else
+    #define CC_TRACE_SCOPE(name)       ((void)0)
+    #define CC_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef CC_TESTS_ALLOCATION_BUDGET_H
+#define CC_TESTS_ALLOCATION_BUDGET_H
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <utility>
+
+#include "util/allocation_tracker.h"
+
+namespace cc::test {
+    // heap allocations made by the calling thread while invoking fn
+    template <typename Fn>
+    cc::util::AllocationStats count_allocations(Fn&& fn) {
+        cc::util::AllocationProbe probe;
+        std::forward<Fn>(fn)();
+        return probe.get();
+    }
+}
+
+// Evaluates the expression and requires that it made at most max_allocations heap allocations
+// (the expression is always evaluated; the budget is only checked with CC_ENABLE_ALLOCATION_TRACKING)
+#define REQUIRE_ALLOCATIONS_AT_MOST(max_allocations, ...)                                 \
+    do {                                                                                  \
+        auto cc_allocations = cc::test::count_allocations([&] { (void)(__VA_ARGS__); });  \
+        INFO("allocation budget: " << cc_allocations);                                    \
+                                                                                          \
+        if constexpr (cc::util::is_allocation_tracking_enabled())                         \
+            REQUIRE(cc_allocations.m_NumAllocations <= (max_allocations));                \
+    } while (false)
+
+#endif
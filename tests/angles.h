@@ -0,0 +1,14 @@
+#ifndef CC_TESTS_ANGLES_H
+#define CC_TESTS_ANGLES_H
+
+#include <cmath>
+#include <numbers>
+
+namespace cc::test {
+    // the difference between two angles in radians, in [0, pi] -- angles on either side of 0 / 2pi are close
+    inline double angle_difference(double a, double b) {
+        return std::abs(std::remainder(a - b, 2.0 * std::numbers::pi));
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "util/allocation_tracker.h"
+#include "allocation_budget.h"
+
+using cc::util::AllocationProbe;
+using cc::util::AllocationStats;
+using cc::util::is_allocation_tracking_enabled;
+
+TEST_CASE("allocation stats arithmetic", "[allocation]") {
+    AllocationStats a { .m_NumAllocations = 5, .m_NumDeallocations = 3, .m_NumBytes = 100 };
+    AllocationStats b { .m_NumAllocations = 2, .m_NumDeallocations = 1, .m_NumBytes =  40 };
+
+    auto difference = a - b;
+
+    REQUIRE(difference == AllocationStats{ .m_NumAllocations = 3, .m_NumDeallocations = 2, .m_NumBytes = 60 });
+
+    difference += b;
+    REQUIRE(difference == a);
+}
+
+TEST_CASE("allocation probe counts allocations of the current thread", "[allocation]") {
+    AllocationProbe probe;
+
+    {
+        auto values = std::make_unique<std::vector<int>>(256);
+        REQUIRE(values->size() == 256);
+    }
+
+    auto stats = probe.get();
+
+    if constexpr (is_allocation_tracking_enabled()) {
+        REQUIRE(stats.m_NumAllocations   == 2); // the vector object and its storage
+        REQUIRE(stats.m_NumDeallocations == 2);
+        REQUIRE(stats.m_NumBytes         >= 256 * sizeof(int));
+    }
+    else
+        REQUIRE(stats == AllocationStats{});
+
+    // allocations by other threads are not attributed to this one
+    probe.reset();
+
+    std::thread worker([] {
+        std::vector<int> values(1024);
+    });
+
+    auto after_spawn = probe.get(); // spawning the thread itself may allocate
+    worker.join();
+
+    REQUIRE(probe.get().m_NumBytes < after_spawn.m_NumBytes + 1024 * sizeof(int));
+}
+
+TEST_CASE("allocation budget", "[allocation]") {
+    REQUIRE_ALLOCATIONS_AT_MOST(0, 1 + 2);
+    REQUIRE_ALLOCATIONS_AT_MOST(1, std::vector<int>(16));
+
+    auto stats = cc::test::count_allocations([] {
+        std::vector<int> values;
+
+        for (int i = 0; i < 100; ++i)
+            values.push_back(i);
+    });
+
+    if constexpr (is_allocation_tracking_enabled())
+        REQUIRE(stats.m_NumAllocations > 1); // growth reallocates
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "processing/anomaly_baseline.h"
+#include "processing/anomalies.h"
+#include "types/tooth_measurement.h"
+
+#include "allocation_budget.h"
+
+using namespace cc;
+using namespace cc::processing;
+
+using Catch::Approx;
+
+namespace {
+    // num_teeth teeth of the given arc, evenly spaced, with some measurement noise
+    std::vector<ToothMeasurement> make_gear(
+        int      num_teeth,
+        double   tooth_arc,
+        double   noise,
+        unsigned seed
+    ) {
+        std::default_random_engine       generator(seed);
+        std::normal_distribution<double> distribution(0.0, noise);
+
+        std::vector<ToothMeasurement> teeth(num_teeth);
+
+        const double pitch = 2.0 * std::numbers::pi / num_teeth;
+
+        for (int i = 0; i < num_teeth; ++i) {
+            teeth[i].m_StartingAngle = i * pitch             + distribution(generator);
+            teeth[i].m_EndingAngle   = i * pitch + tooth_arc + distribution(generator);
+        }
+
+        return teeth;
+    }
+
+    constexpr int    k_NumTeeth = 24;
+    constexpr double k_ToothArc = std::numbers::pi / k_NumTeeth; // half of the pitch
+    constexpr double k_Noise    = 0.002;
+}
+
+TEST_CASE("AnomalyBaseline - needs a few gears", "[anomalies][baseline]") {
+    AnomalyBaseline baseline;
+
+    REQUIRE(!baseline.is_ready());
+    REQUIRE(baseline.get_num_teeth() == 0);
+
+    for (unsigned i = 0; i < AnomalyBaseline::k_MinGears; ++i) {
+        REQUIRE(!baseline.is_ready());
+        REQUIRE(baseline.add(make_gear(k_NumTeeth, k_ToothArc, k_Noise, i)));
+    }
+
+    REQUIRE(baseline.is_ready());
+    REQUIRE(baseline.get_num_gears() == AnomalyBaseline::k_MinGears);
+    REQUIRE(baseline.get_num_teeth() == k_NumTeeth);
+
+    REQUIRE(baseline.get_arc_statistics().get_count() == AnomalyBaseline::k_MinGears * k_NumTeeth);
+    REQUIRE(baseline.get_arc_statistics().get_mean()  == Approx(k_ToothArc).epsilon(0.01));
+    REQUIRE(baseline.get_gap_statistics().get_mean()  == Approx(k_ToothArc).epsilon(0.01));
+
+    // another part type is not mixed in
+    REQUIRE(!baseline.add(make_gear(k_NumTeeth + 1, k_ToothArc, k_Noise, 100)));
+    REQUIRE(!baseline.add({}));
+    REQUIRE(baseline.get_num_gears() == AnomalyBaseline::k_MinGears);
+
+    baseline.reset();
+
+    REQUIRE(!baseline.is_ready());
+    REQUIRE(baseline.get_num_teeth() == 0);
+    REQUIRE(baseline.get_arc_statistics().get_count() == 0);
+    REQUIRE(baseline.add(make_gear(k_NumTeeth + 1, k_ToothArc, k_Noise, 100)));
+}
+
+TEST_CASE("AnomalyBaseline - the tooth count needs agreeing gears", "[anomalies][baseline]") {
+    AnomalyBaseline baseline;
+
+    // a miscounted first gear doesn't fix the count
+    REQUIRE(baseline.add(make_gear(k_NumTeeth - 1, k_ToothArc, k_Noise, 0)));
+    REQUIRE(baseline.get_num_teeth() == 0);
+
+    // and is dropped once the following gears disagree with it
+    for (unsigned i = 1; i < AnomalyBaseline::k_MinAgreeingGears; ++i) {
+        REQUIRE(baseline.add(make_gear(k_NumTeeth, k_ToothArc, k_Noise, i)));
+        REQUIRE(baseline.get_num_teeth() == 0);
+    }
+
+    REQUIRE(baseline.get_num_gears() == AnomalyBaseline::k_MinAgreeingGears - 1);
+
+    REQUIRE(baseline.add(make_gear(k_NumTeeth, k_ToothArc, k_Noise, 100)));
+    REQUIRE(baseline.get_num_teeth() == k_NumTeeth);
+    REQUIRE(baseline.get_num_gears() == AnomalyBaseline::k_MinAgreeingGears);
+    REQUIRE(baseline.get_arc_statistics().get_count() == AnomalyBaseline::k_MinAgreeingGears * k_NumTeeth);
+
+    // fixed from now on
+    REQUIRE(!baseline.add(make_gear(k_NumTeeth - 1, k_ToothArc, k_Noise, 200)));
+    REQUIRE(baseline.get_num_teeth() == k_NumTeeth);
+}
+
+TEST_CASE("AnomalyBaseline - doesn't score other tooth counts", "[anomalies][baseline]") {
+    AnomalyBaseline baseline;
+
+    REQUIRE(baseline.score(make_gear(k_NumTeeth, k_ToothArc, k_Noise, 0)).empty());
+
+    for (unsigned i = 0; i < AnomalyBaseline::k_MinGears; ++i)
+        baseline.add(make_gear(k_NumTeeth, k_ToothArc, k_Noise, i));
+
+    REQUIRE(baseline.is_ready());
+    REQUIRE(baseline.score(make_gear(k_NumTeeth,     k_ToothArc, k_Noise, 100)).size() == k_NumTeeth);
+    REQUIRE(baseline.score(make_gear(k_NumTeeth + 1, k_ToothArc, k_Noise, 100)).empty());
+    REQUIRE(baseline.score(make_gear(k_NumTeeth - 1, k_ToothArc, k_Noise, 100)).empty());
+}
+
+TEST_CASE("AnomalyBaseline - only keeps the window", "[anomalies][baseline]") {
+    AnomalyBaseline baseline(4);
+
+    for (unsigned i = 0; i < 4; ++i)
+        baseline.add(make_gear(k_NumTeeth, k_ToothArc, 0.0, i));
+
+    // the wider gears push out the older ones
+    for (unsigned i = 0; i < 4; ++i)
+        baseline.add(make_gear(k_NumTeeth, 1.1 * k_ToothArc, 0.0, i));
+
+    REQUIRE(baseline.get_num_gears() == 4);
+    REQUIRE(baseline.get_arc_statistics().get_count() == 4 * k_NumTeeth);
+    REQUIRE(baseline.get_arc_statistics().get_mean()  == Approx(1.1 * k_ToothArc));
+}
+
+TEST_CASE("AnomalyBaseline - catches defects shared by all teeth", "[anomalies][baseline]") {
+    AnomalyBaseline baseline;
+
+    for (unsigned i = 0; i < 32; ++i)
+        baseline.add(make_gear(k_NumTeeth, k_ToothArc, k_Noise, i));
+
+    // every tooth is 20% too wide -- regular on its own, but not compared to the earlier gears
+    auto worn = make_gear(k_NumTeeth, 1.2 * k_ToothArc, k_Noise, 1000);
+
+    AnomalyScorer                  scorer;
+    std::vector<ToothAnomalyScore> scores;
+    std::vector<uint8_t>           scorer_mask;
+
+    scorer.score(worn, scores, scorer_mask);
+    REQUIRE(std::ranges::all_of(scorer_mask, [](uint8_t m) { return m == 0; }));
+
+    auto mask = create_anomaly_mask(baseline.score(worn), AnomalyScorer::k_StrongAnomaly);
+
+    for (auto m : mask)
+        REQUIRE((m & cc::arc) != 0);
+
+    // while a good gear scores low everywhere
+    for (const auto& score : baseline.score(make_gear(k_NumTeeth, k_ToothArc, k_Noise, 2000))) {
+        REQUIRE(score.m_Arc < AnomalyScorer::k_StrongAnomaly);
+        REQUIRE(score.m_Gap < AnomalyScorer::k_StrongAnomaly);
+    }
+}
+
+TEST_CASE("AnomalyBaseline - allocation budget", "[anomalies][baseline][allocation]") {
+    AnomalyBaseline baseline;
+
+    auto teeth = make_gear(k_NumTeeth, k_ToothArc, k_Noise, 0);
+    baseline.add(teeth);
+    baseline.score(teeth); // sizes the scores
+
+    REQUIRE_ALLOCATIONS_AT_MOST(0, [&] {
+        baseline.add(teeth);
+        return baseline.score(teeth).size();
+    }());
+}
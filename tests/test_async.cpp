@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include "async/just.h"
 #include "async/then.h"
@@ -6,6 +7,44 @@
 #include "async/run_loop_context.h"
 #include "async/thread_context.h"
 #include "async/cout_receiver.h"
+#include "async/timer_context.h"
+#include "async/timeout.h"
+#include "async/any_sender.h"
+#include "async/split.h"
+#include "async/ensure_started.h"
+#include "async/scheduler_stats.h"
+
+#include <memory>
+#include <array>
+#include <atomic>
+#include <sstream>
+
+namespace {
+    // counts how often a value is copied while it travels through a chain of senders
+    struct CopyCounter {
+        static inline int s_NumCopies = 0;
+
+        int m_Value = 0;
+
+        CopyCounter() = default;
+        explicit CopyCounter(int value): m_Value(value) {}
+
+        CopyCounter(const CopyCounter& cc): m_Value(cc.m_Value) { ++s_NumCopies; }
+        CopyCounter& operator = (const CopyCounter& cc) { m_Value = cc.m_Value; ++s_NumCopies; return *this; }
+
+        CopyCounter(CopyCounter&&) noexcept = default;
+        CopyCounter& operator = (CopyCounter&&) noexcept = default;
+    };
+
+    // stores the value without any synchronization, to measure the cost of the sender chain itself
+    struct StoreReceiver {
+        int* m_Result;
+
+        void set_value(int value)            { *m_Result = value; }
+        void set_error(std::exception_ptr)   {}
+        void set_stopped()                   {}
+    };
+}
 
 TEST_CASE("Just", "[async]") {
     using namespace cc::async;
@@ -81,4 +120,471 @@ TEST_CASE("ThreadContext", "[async]") {
     ctx.join();   // wait for the thread to complete
 
     REQUIRE(final_result.value() == 4);
-}
\ No newline at end of file
+}
+
+TEST_CASE("TimerContext", "[async]") {
+    using namespace cc::async;
+    using namespace std::chrono_literals;
+
+    TimerContext ctx;
+
+    auto scheduler = ctx.get_scheduler();
+    auto start     = scheduler.now();
+
+    auto work = then(scheduler.schedule_after(20ms), [start](auto) {
+        return TimerContext::Clock::now() - start;
+    });
+
+    auto elapsed = sync_wait(work).value();
+
+    ctx.finish();
+    ctx.join();
+
+    REQUIRE(elapsed >= 20ms);
+}
+
+TEST_CASE("TimerContext - deadline order", "[async]") {
+    using namespace cc::async;
+    using namespace std::chrono_literals;
+
+    TimerContext ctx;
+
+    auto scheduler = ctx.get_scheduler();
+    auto now       = scheduler.now();
+
+    std::mutex       mutex;
+    std::vector<int> order;
+
+    auto record = [&](int x) {
+        return [&, x](auto) {
+            std::unique_lock guard(mutex);
+            order.push_back(x);
+            return x;
+        };
+    };
+
+    // scheduled out of order, should complete in deadline order
+    auto op3 = then(scheduler.schedule_at(now + 30ms), record(3)).connect(CoutReceiver{});
+    auto op1 = then(scheduler.schedule_at(now + 10ms), record(1)).connect(CoutReceiver{});
+    auto op2 = then(scheduler.schedule_at(now + 20ms), record(2)).connect(CoutReceiver{});
+
+    op3.start();
+    op1.start();
+    op2.start();
+
+    sync_wait(scheduler.schedule_at(now + 40ms));
+
+    ctx.finish();
+    ctx.join();
+
+    REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+}
+
+TEST_CASE("TimerContext - finish stops pending timers", "[async]") {
+    using namespace cc::async;
+    using namespace std::chrono_literals;
+
+    TimerContext ctx;
+
+    auto work = then(ctx.get_scheduler().schedule_after(1h), [](auto) { return 1; });
+
+    ctx.finish();
+
+    auto result = sync_wait(work); // completes with set_stopped, so no value
+    ctx.join();
+
+    REQUIRE(!result.has_value());
+}
+
+TEST_CASE("Timeout", "[async]") {
+    using namespace cc::async;
+    using namespace std::chrono_literals;
+
+    TimerContext timers;
+
+    SECTION("completes in time") {
+        auto work = timeout(just(5), timers.get_scheduler(), 1s);
+
+        REQUIRE(sync_wait(work).value() == 5);
+    }
+
+    SECTION("expires") {
+        TimerContext slow;
+
+        auto work = timeout(
+            then(slow.get_scheduler().schedule_after(200ms), [](auto) { return 6; }),
+            timers.get_scheduler(),
+            10ms
+        );
+
+        REQUIRE_THROWS_AS(sync_wait(work), TimeoutError);
+    }
+
+    timers.finish();
+    timers.join();
+}
+
+TEST_CASE("Zero copy propagation", "[async]") {
+    using namespace cc::async;
+
+    CopyCounter::s_NumCopies = 0;
+
+    auto result = sync_wait(
+        then(
+            then(
+                just(CopyCounter(10)),
+                [](CopyCounter x) { x.m_Value += 1; return x; }
+            ),
+            [](CopyCounter&& x) { x.m_Value *= 2; return std::move(x); }
+        )
+    );
+
+    REQUIRE(result.value().m_Value == 22);
+    REQUIRE(CopyCounter::s_NumCopies == 0);
+}
+
+TEST_CASE("Reusable lvalue sender copies", "[async]") {
+    using namespace cc::async;
+
+    auto work = then(just(CopyCounter(1)), [](CopyCounter x) { return x.m_Value; });
+
+    CopyCounter::s_NumCopies = 0;
+
+    // connecting an lvalue sender must leave it intact, so the value is copied exactly once per connect
+    REQUIRE(sync_wait(work).value() == 1);
+    REQUIRE(sync_wait(work).value() == 1);
+    REQUIRE(CopyCounter::s_NumCopies == 2);
+}
+
+TEST_CASE("Move-only values", "[async]") {
+    using namespace cc::async;
+
+    auto work = then(
+        just(std::make_unique<int>(41)),
+        [](std::unique_ptr<int> ptr) {
+            ++*ptr;
+            return ptr;
+        }
+    );
+
+    auto result = sync_wait(std::move(work));
+
+    REQUIRE(result.has_value());
+    REQUIRE(**result == 42);
+}
+
+TEST_CASE("Move-only values across threads", "[async]") {
+    using namespace cc::async;
+
+    ThreadContext ctx;
+
+    auto work = then(
+        ctx.get_scheduler().schedule(),
+        [ptr = std::make_unique<int>(7)](auto) mutable { return std::move(ptr); }
+    );
+
+    auto result = sync_wait(std::move(work));
+
+    ctx.finish();
+    ctx.join();
+
+    REQUIRE(**result == 7);
+}
+
+TEST_CASE("AnySender", "[async]") {
+    using namespace cc::async;
+
+    AnySender<int> work = then(just(20), [](int x) { return x + 1; });
+
+    REQUIRE(work.is_inline());
+    REQUIRE(sync_wait(work).value()            == 21);
+    REQUIRE(sync_wait(std::move(work)).value() == 21);
+}
+
+TEST_CASE("AnySender - runtime selection", "[async]") {
+    using namespace cc::async;
+
+    std::vector<any_sender_of<int>> engines;
+
+    engines.emplace_back(just(1));
+    engines.emplace_back(then(just(2), [](int x) { return x * 10; }));
+    engines.emplace_back(then(just(3.0), [](double x) { return static_cast<int>(x) * 100; }));
+
+    std::vector<int> results;
+
+    for (const auto& engine : engines)
+        results.push_back(sync_wait(engine).value());
+
+    REQUIRE(results == std::vector<int>{ 1, 20, 300 });
+}
+
+TEST_CASE("AnySender - small buffer", "[async]") {
+    using namespace cc::async;
+
+    SECTION("typical operations are stored in-place") {
+        AnySender<int> work = then(just(5), [](int x) { return x * 2; });
+        int result = 0;
+
+        auto op = work.connect(StoreReceiver{ &result });
+
+        REQUIRE(op.m_Operation.is_inline());
+
+        op.start();
+        REQUIRE(result == 10);
+    }
+
+    SECTION("large senders fall back to the heap") {
+        std::array<int, 64> payload {};
+        payload[63] = 7;
+
+        AnySender<int> work = then(just(payload), [](const std::array<int, 64>& arr) { return arr[63]; });
+        REQUIRE(!work.is_inline());
+
+        int result = 0;
+
+        auto op = std::move(work).connect(StoreReceiver{ &result });
+        REQUIRE(!op.m_Operation.is_inline());
+
+        op.start();
+        REQUIRE(result == 7);
+    }
+}
+
+TEST_CASE("AnySender - move-only and errors", "[async]") {
+    using namespace cc::async;
+
+    AnySender<std::unique_ptr<int>> ptr_work = just(std::make_unique<int>(3));
+    AnySender<std::unique_ptr<int>> moved    = std::move(ptr_work);
+
+    REQUIRE(**sync_wait(std::move(moved)) == 3);
+
+    AnySender<int> failing = just_error(std::make_exception_ptr(std::runtime_error("nope")));
+
+    REQUIRE_THROWS_AS(sync_wait(failing), std::runtime_error);
+}
+
+TEST_CASE("AnySender - threads", "[async]") {
+    using namespace cc::async;
+
+    ThreadContext ctx;
+
+    AnySender<int> work = then(ctx.get_scheduler().schedule(), [](auto) { return 9; });
+
+    auto result = sync_wait(std::move(work));
+
+    ctx.finish();
+    ctx.join();
+
+    REQUIRE(result.value() == 9);
+}
+
+TEST_CASE("AnySender - overhead", "[.][benchmark][async]") {
+    using namespace cc::async;
+
+    auto add_one = [](int x) { return x + 1; };
+    int  result  = 0;
+
+    BENCHMARK("static composition") {
+        auto op = then(then(just(result), add_one), add_one).connect(StoreReceiver{ &result });
+        op.start();
+        return result;
+    };
+
+    BENCHMARK("type-erased composition") {
+        AnySender<int> work = then(then(just(result), add_one), add_one);
+
+        auto op = std::move(work).connect(StoreReceiver{ &result });
+        op.start();
+        return result;
+    };
+
+    AnySender<int> stored = then(then(just(1), add_one), add_one);
+
+    BENCHMARK("type-erased connect/start only") {
+        auto op = stored.connect(StoreReceiver{ &result });
+        op.start();
+        return result;
+    };
+}
+
+TEST_CASE("Split", "[async]") {
+    using namespace cc::async;
+
+    int num_runs = 0;
+
+    auto shared = split(
+        then(just(CopyCounter(6)), [&num_runs](CopyCounter x) {
+            ++num_runs;
+            return x;
+        })
+    );
+
+    CopyCounter::s_NumCopies = 0;
+
+    auto display = then(shared, [](const CopyCounter& x) { return x.m_Value + 1; });
+    auto logger  = then(shared, [](const CopyCounter& x) { return x.m_Value * 2; });
+
+    REQUIRE(sync_wait(display).value() == 7);
+    REQUIRE(sync_wait(logger) .value() == 12);
+
+    REQUIRE(num_runs == 1);
+    REQUIRE(CopyCounter::s_NumCopies == 0);
+}
+
+TEST_CASE("Split - concurrent consumers", "[async]") {
+    using namespace cc::async;
+
+    ThreadContext worker;
+    ThreadContext consumers;
+
+    std::atomic<int> num_runs = 0;
+
+    auto frame = split(
+        then(worker.get_scheduler().schedule(), [&num_runs](auto) {
+            ++num_runs;
+            return std::make_unique<int>(11); // move-only values can be shared as well
+        })
+    );
+
+    std::atomic<int> sum = 0;
+
+    auto consume = [&](int factor) {
+        return [&sum, factor](const std::unique_ptr<int>& value) {
+            sum += *value * factor;
+            return 0;
+        };
+    };
+
+    // attach several consumers before the shared work completes
+    auto op1 = then(frame, consume(1)).connect(CoutReceiver{});
+    auto op2 = then(frame, consume(2)).connect(CoutReceiver{});
+    auto op3 = then(frame, consume(3)).connect(CoutReceiver{});
+
+    op1.start();
+    op2.start();
+    op3.start();
+
+    // and one more that waits on a different thread
+    sync_wait(then(consumers.get_scheduler().schedule(), [&](auto) {
+        return sync_wait(then(frame, consume(4))).value();
+    }));
+
+    worker.finish();
+    worker.join();
+    consumers.finish();
+    consumers.join();
+
+    REQUIRE(num_runs == 1);
+    REQUIRE(sum      == 11 * (1 + 2 + 3 + 4));
+}
+
+TEST_CASE("Split - errors are shared", "[async]") {
+    using namespace cc::async;
+
+    auto shared = split(
+        AnySender<int>(just_error(std::make_exception_ptr(std::runtime_error("broken"))))
+    );
+
+    REQUIRE_THROWS_AS(sync_wait(shared), std::runtime_error);
+    REQUIRE_THROWS_AS(sync_wait(shared), std::runtime_error);
+}
+
+TEST_CASE("EnsureStarted", "[async]") {
+    using namespace cc::async;
+
+    int num_runs = 0;
+
+    auto started = ensure_started(
+        then(just(std::make_unique<int>(5)), [&num_runs](std::unique_ptr<int> ptr) {
+            ++num_runs;
+            return ptr;
+        })
+    );
+
+    REQUIRE(num_runs == 1); // already ran before anyone connected
+
+    auto result = sync_wait(std::move(started));
+
+    REQUIRE(**result == 5);
+}
+
+TEST_CASE("EnsureStarted - threads", "[async]") {
+    using namespace cc::async;
+
+    ThreadContext ctx;
+
+    auto started = ensure_started(then(ctx.get_scheduler().schedule(), [](auto) { return 8; }));
+    auto result  = sync_wait(then(std::move(started), [](int x) { return x + 1; }));
+
+    ctx.finish();
+    ctx.join();
+
+    REQUIRE(result.value() == 9);
+}
+
+TEST_CASE("SchedulerStats - run loop", "[async]") {
+    using namespace cc::async;
+
+    SchedulerStats stats;
+    RunLoop        loop;
+
+    loop.set_stats(&stats);
+
+    auto scheduler = loop.get_scheduler();
+
+    auto op1 = then(scheduler.schedule(), [](auto) { return 1; }).connect(CoutReceiver{});
+    auto op2 = then(scheduler.schedule(), [](auto) { return 2; }).connect(CoutReceiver{});
+    auto op3 = then(scheduler.schedule(), [](auto) { return 3; }).connect(CoutReceiver{});
+
+    op1.start();
+    op2.start();
+    op3.start();
+
+    auto queued = stats.snapshot();
+
+    REQUIRE(queued.m_NumScheduled  == 3);
+    REQUIRE(queued.m_NumExecuted   == 0);
+    REQUIRE(queued.m_QueueDepth    == 3);
+
+    loop.finish();
+    loop.run();
+
+    auto done = stats.snapshot();
+
+    REQUIRE(done.m_NumExecuted            == 3);
+    REQUIRE(done.m_QueueDepth             == 0);
+    REQUIRE(done.m_MaxQueueDepth          == 3);
+    REQUIRE(done.m_WaitTime.m_Count       == 3);
+    REQUIRE(done.m_ExecutionTime.m_Count  == 3);
+
+    std::ostringstream os;
+    os << done;
+
+    REQUIRE(os.str().starts_with("scheduled: 3, executed: 3, queue depth: 0 (max 3)"));
+}
+
+TEST_CASE("SchedulerStats - timers", "[async]") {
+    using namespace cc::async;
+    using namespace std::chrono_literals;
+
+    SchedulerStats stats;
+    TimerContext   timers;
+
+    timers.set_stats(&stats);
+
+    auto work = then(timers.get_scheduler().schedule_after(5ms), [](auto) {
+        std::this_thread::sleep_for(2ms);
+        return 0;
+    });
+
+    sync_wait(work);
+
+    timers.finish();
+    timers.join();
+
+    auto snapshot = stats.snapshot();
+
+    REQUIRE(snapshot.m_NumExecuted == 1);
+    REQUIRE(snapshot.m_QueueDepth  == 0);
+    REQUIRE(snapshot.m_ExecutionTime.max() >= 2ms);
+}
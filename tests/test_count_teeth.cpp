@@ -214,4 +214,59 @@ TEST_CASE("count_teeth - wraparound behavior", "[count_teeth]") {
     REQUIRE(teeth[1].m_ToothIdx             == 2);
     REQUIRE(teeth[1].m_LowHighTransitionIdx == 3); // wraps to position 0 in the next iteration
     REQUIRE(teeth[1].m_HighLowTransitionIdx == 0);
+}
+
+namespace {
+    // a contour on a circle around centroid, with a radius of 40 where the mask is set and 30 elsewhere
+    std::vector<cv::Point> make_round_contour(
+        const std::vector<uint8_t>& mask,
+        const cv::Point2f&          centroid,
+              std::vector<double>&  distances
+    ) {
+        std::vector<cv::Point> contour;
+
+        for (size_t i = 0; i < mask.size(); ++i) {
+            double angle  = (2.0 * std::numbers::pi * i) / mask.size();
+            double radius = mask[i] ? 40 : 30;
+
+            contour.emplace_back(
+                static_cast<int>(centroid.x + radius * cos(angle)),
+                static_cast<int>(centroid.y + radius * sin(angle))
+            );
+            distances.push_back(radius);
+        }
+
+        return contour;
+    }
+}
+
+// used to loop forever, the index wrapped to 0 before it could pass the last point
+TEST_CASE("count_teeth - tooth ending at the last point", "[count_teeth]") {
+    cv::Point2f          centroid(50, 50);
+    std::vector<uint8_t> mask = {0, 1, 1, 1};
+    std::vector<double>  distances;
+
+    auto contour = make_round_contour(mask, centroid, distances);
+    auto teeth   = count_teeth(*find_tooth_start(mask), mask, contour, distances, centroid);
+
+    REQUIRE(teeth.size() == 1);
+    REQUIRE(teeth[0].m_HighLowTransitionIdx == 3);
+    REQUIRE(teeth[0].m_MinDistance == 40.0);
+    REQUIRE(teeth[0].m_MaxDistance == 40.0);
+}
+
+// used to be left unmeasured (+-DBL_MAX), its high->low index is before the low->high one
+TEST_CASE("count_teeth - tooth wrapping around the end", "[count_teeth]") {
+    cv::Point2f          centroid(50, 50);
+    std::vector<uint8_t> mask = {1, 0, 0, 1, 1};
+    std::vector<double>  distances;
+
+    auto contour = make_round_contour(mask, centroid, distances);
+    auto teeth   = count_teeth(*find_tooth_start(mask), mask, contour, distances, centroid);
+
+    REQUIRE(teeth.size() == 1);
+    REQUIRE(teeth[0].m_LowHighTransitionIdx == 2);
+    REQUIRE(teeth[0].m_HighLowTransitionIdx == 0);
+    REQUIRE(teeth[0].m_MinDistance == 40.0);
+    REQUIRE(teeth[0].m_MaxDistance == 40.0);
 }
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "processing/contours.h"
+#include "processing/edge_refinement.h"
+#include "processing/foreground.h"
+#include "synthetic/gear_generator.h"
+
+#include "angles.h"
+
+using namespace cc::processing;
+using namespace cc;
+
+using cc::test::angle_difference;
+
+using Catch::Approx;
+
+namespace {
+    const cv::Point2f k_Center = { 200.3f, 199.6f };
+
+    constexpr double k_EdgeAngle = 0.3;   // radians
+    constexpr double k_Radius    = 150.0; // pixels
+
+    // dark below the ray from k_Center at k_EdgeAngle, bright above it, with a linear ramp of a pixel and a half across
+    // the ray -- a soft edge, like the ones a lens produces
+    cv::Mat make_edge_image(double contrast = 150.0) {
+        cv::Mat image(400, 400, CV_8UC3, cv::Scalar::all(0));
+
+        const double nx = -std::sin(k_EdgeAngle);
+        const double ny =  std::cos(k_EdgeAngle);
+
+        for (int y = 0; y < image.rows; ++y)
+            for (int x = 0; x < image.cols; ++x) {
+                const double across   = (x - k_Center.x) * nx + (y - k_Center.y) * ny;
+                const double coverage = std::clamp(across / 1.5 + 0.5, 0.0, 1.0);
+                const auto   value    = static_cast<uint8_t>(std::lround(50.0 + contrast * coverage));
+
+                image.at<cv::Vec3b>(y, x) = cv::Vec3b(value, value, value);
+            }
+
+        return image;
+    }
+
+    // standard deviation of the angular widths of the teeth
+    double tooth_width_deviation(const std::vector<ToothMeasurement>& teeth) {
+        std::vector<double> widths;
+
+        for (const auto& tooth : teeth)
+            widths.push_back(angle_difference(tooth.m_EndingAngle, tooth.m_StartingAngle));
+
+        double mean = 0.0;
+        for (double width : widths)
+            mean += width;
+        mean /= static_cast<double>(widths.size());
+
+        double variance = 0.0;
+        for (double width : widths)
+            variance += (width - mean) * (width - mean);
+
+        return std::sqrt(variance / static_cast<double>(widths.size()));
+    }
+
+    // the largest angle between an edge of the teeth and the nearest ground truth edge
+    double max_edge_error(const std::vector<ToothMeasurement>& teeth, const synthetic::GearGroundTruth& truth) {
+        auto nearest = [&](double angle) {
+            double result = std::numeric_limits<double>::max();
+
+            for (const auto& tooth : truth.m_Teeth)
+                result = std::min({
+                    result,
+                    angle_difference(angle, tooth.m_StartingAngle),
+                    angle_difference(angle, tooth.m_EndingAngle)
+                });
+
+            return result;
+        };
+
+        double result = 0.0;
+
+        for (const auto& tooth : teeth)
+            result = std::max({ result, nearest(tooth.m_StartingAngle), nearest(tooth.m_EndingAngle) });
+
+        return result;
+    }
+
+    struct EngineResults {
+        std::optional<ContourResult> m_Reference;
+        std::optional<ContourResult> m_Subpixel;
+    };
+
+    EngineResults process_generated(const synthetic::GearSpec& spec, const cv::Mat& image) {
+        cv::Mat foreground_mask;
+        cv::Mat foreground;
+
+        determine_foreground_buffered(spec.m_GearColor, 40, image, foreground_mask, foreground);
+
+        std::vector<std::vector<cv::Point>> contours;
+        std::vector<cv::Vec4i>              hierarchy;
+
+        cv::findContours(foreground_mask, contours, hierarchy, cv::RETR_CCOMP, cv::CHAIN_APPROX_SIMPLE);
+
+        REQUIRE(!contours.empty());
+
+        cv::Mat reference_image = image.clone();
+        cv::Mat subpixel_image  = image.clone();
+
+        return EngineResults {
+            .m_Reference = process_contours         (contours, hierarchy,        reference_image),
+            .m_Subpixel  = process_contours_subpixel(contours, hierarchy, image, subpixel_image)
+        };
+    }
+}
+
+TEST_CASE("interpolate_crossing", "[edge_refinement]") {
+    auto crossing = interpolate_crossing({ 10, 20 }, { 14, 18 }, 100.0, 110.0, 102.5);
+
+    REQUIRE(crossing.x == Approx(11.0));
+    REQUIRE(crossing.y == Approx(19.5));
+
+    // falling edges work the same way
+    crossing = interpolate_crossing({ 10, 20 }, { 14, 18 }, 110.0, 100.0, 102.5);
+
+    REQUIRE(crossing.x == Approx(13.0));
+    REQUIRE(crossing.y == Approx(18.5));
+
+    // no change in distance, no interpolation
+    crossing = interpolate_crossing({ 10, 20 }, { 14, 18 }, 100.0, 100.0, 100.0);
+
+    REQUIRE(crossing.x == Approx(10.0));
+    REQUIRE(crossing.y == Approx(20.0));
+}
+
+TEST_CASE("refine_edge_angle - soft edge", "[edge_refinement]") {
+    const auto image = make_edge_image();
+
+    // start up to two pixels off, on either side
+    auto offset = GENERATE(-2.0, -1.0, -0.3, 0.0, 0.7, 2.0);
+
+    INFO("offset " << offset << " pixels");
+
+    double refined = refine_edge_angle(image, k_Center, k_Radius, k_EdgeAngle + offset / k_Radius);
+
+    // within a tenth of a pixel
+    REQUIRE(angle_difference(refined, k_EdgeAngle) <= 0.1 / k_Radius);
+}
+
+TEST_CASE("refine_edge_angle - no clear edge", "[edge_refinement]") {
+    const double start = k_EdgeAngle + 0.02;
+
+    SECTION("flat image") {
+        cv::Mat image(400, 400, CV_8UC3, cv::Scalar::all(128));
+
+        REQUIRE(refine_edge_angle(image, k_Center, k_Radius, start) == start);
+    }
+
+    SECTION("too little contrast") {
+        REQUIRE(refine_edge_angle(make_edge_image(2.0), k_Center, k_Radius, k_EdgeAngle + 1.0 / k_Radius) == k_EdgeAngle + 1.0 / k_Radius);
+    }
+
+    SECTION("edge out of range") {
+        // ten pixels away
+        REQUIRE(refine_edge_angle(make_edge_image(), k_Center, k_Radius, k_EdgeAngle + 10.0 / k_Radius) == k_EdgeAngle + 10.0 / k_Radius);
+    }
+
+    SECTION("outside the image") {
+        REQUIRE(refine_edge_angle(make_edge_image(), k_Center, 250.0, k_EdgeAngle) == k_EdgeAngle);
+    }
+}
+
+TEST_CASE("process_contours_subpixel - tooth widths are more consistent", "[edge_refinement]") {
+    synthetic::GearSpec spec;
+
+    spec.m_Resolution = { 640, 480 };
+    spec.m_NumTeeth   = 24;
+    spec.m_Rotation   = 0.3;
+
+    const auto image = synthetic::generate_gear(spec).m_Image;
+
+    auto [reference, subpixel] = process_generated(spec, image);
+
+    REQUIRE(reference.has_value());
+    REQUIRE(subpixel.has_value());
+    REQUIRE(reference->m_Teeth.size() == 24);
+    REQUIRE(subpixel ->m_Teeth.size() == 24);
+
+    // all teeth have the same width, the variation is measurement error (0.47 times that of the reference engine)
+    REQUIRE(tooth_width_deviation(subpixel->m_Teeth) < 0.5 * tooth_width_deviation(reference->m_Teeth));
+}
+
+TEST_CASE("process_contours_subpixel - edges match the ground truth", "[edge_refinement]") {
+    // pixels along the outline at half tooth height; the reference engine is off by 1.6 to 3.6 on these gears, as its
+    // edges are on the contour points, the sub-pixel edges by 1.0 to 1.3
+    constexpr double k_MaxEdgeError = 1.5;
+
+    synthetic::GearSpec spec;
+
+    spec.m_Resolution = GENERATE(Resolution { 640, 480 }, Resolution { 1280, 720 }, Resolution { 1920, 1080 });
+    spec.m_Rotation   = GENERATE(0.3, 1.1);
+    spec.m_NoiseSigma = GENERATE(0.0, 6.0);
+    spec.m_BlurRadius = (spec.m_NoiseSigma > 0.0) ? 1 : 0;
+
+    INFO(spec.m_Resolution << ", rotation " << spec.m_Rotation << ", noise " << spec.m_NoiseSigma);
+
+    const auto gear = synthetic::generate_gear(spec);
+
+    auto [reference, subpixel] = process_generated(spec, gear.m_Image);
+
+    REQUIRE(reference.has_value());
+    REQUIRE(subpixel.has_value());
+    REQUIRE(subpixel->m_Teeth.size() == gear.m_Truth.get_num_teeth());
+
+    const double half_height     = (gear.m_Truth.m_TipRadius + gear.m_Truth.m_RootRadius) / 2.0;
+    const double reference_error = max_edge_error(reference->m_Teeth, gear.m_Truth);
+    const double subpixel_error  = max_edge_error(subpixel ->m_Teeth, gear.m_Truth);
+
+    INFO("reference " << reference_error * half_height << " pixels, subpixel " << subpixel_error * half_height << " pixels");
+
+    REQUIRE(subpixel_error <= k_MaxEdgeError / half_height);
+    REQUIRE(subpixel_error <  reference_error);
+}
@@ -0,0 +1,257 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "io/data_location.h"
+#include "io/jpg.h"
+#include "processing/engine.h"
+#include "synthetic/gear_generator.h"
+
+#include "angles.h"
+#include "gear_corpus.h"
+
+// Differential tests -- every engine is run on the same inputs as the reference engine and has to produce the same
+// foreground mask and tooth count; angles and radii may differ slightly for engines that measure differently
+// (engines that resample the contour, or blur the mask less, get a looser tolerance)
+
+using namespace cc::processing;
+
+using cc::bench::Recording;
+using cc::test::angle_difference;
+
+namespace {
+    namespace fs = std::filesystem;
+
+    struct Tolerance {
+        double m_Angle;  // fraction of the tooth pitch, 2 pi / number of teeth
+        double m_Radius; // pixels, for the centroid and the smallest distance of a tooth
+        double m_Flank;  // pixels, for the largest distance of a tooth
+    };
+
+    // measured on the same contour points as the reference engine
+    constexpr Tolerance k_ContourTolerance = { 0.02, 1.0, 1.0 };
+
+    // the polar engines find the edges between contour points, which can be far apart on the straight runs that
+    // CHAIN_APPROX_SIMPLE leaves; and the largest distance of a tooth is on a flank, just below the threshold, which
+    // the rays sample differently than the contour points. An edge that moves by a quarter of the pitch would put
+    // the gaps where the teeth are, so the angles have to agree to within that (measured: up to 0.16 of the pitch
+    // on the recordings, 0.10 on the generated gears, and 6.6 pixels on a flank)
+    constexpr Tolerance k_ResampledTolerance = { 0.2, 1.0, 8.0 };
+
+    // the smoothed engine blurs the mask less, which keeps more of the bottoms of the gaps that the 9x9 median of the
+    // reference rounds off; and its edges are where the filtered distances cross the hysteresis band (measured: up to
+    // 0.14 of the pitch, 3.7 pixels at the bottom of a gap and 5.7 on a flank)
+    constexpr Tolerance k_SmoothedTolerance = { 0.2, 5.0, 8.0 };
+
+    // the subpixel engine moves the edges off the contour points, closer to the true edges than the reference engine
+    // gets; its angles are checked against the ground truth of generated gears instead (see test_edge_refinement.cpp)
+    constexpr Tolerance k_SubpixelTolerance = { std::numeric_limits<double>::infinity(), 1.0, 1.0 };
+
+    const Tolerance& get_tolerance(const Engine& engine) {
+        if (engine.m_Name == "polar" || engine.m_Name == "polar_mask")
+            return k_ResampledTolerance;
+
+        if (engine.m_Name == "smoothed")
+            return k_SmoothedTolerance;
+
+        if (engine.m_Name == "subpixel")
+            return k_SubpixelTolerance;
+
+        return k_ContourTolerance;
+    }
+
+    // engines with a foreground kernel of their own
+    bool has_reference_foreground(const Engine& engine) {
+        return engine.m_Name != "smoothed";
+    }
+
+    struct EngineInput {
+        std::string m_Name;
+        cv::Mat     m_Image;
+        cv::Scalar  m_Color;
+        int         m_Tolerance;
+    };
+
+    struct EngineOutput {
+        cv::Mat                      m_ForegroundMask;
+        cv::Mat                      m_Foreground;
+        std::optional<ContourResult> m_Result;
+    };
+
+    // the outputs may hold the buffers of an earlier frame, just like in the application
+    void run_engine(const Engine& engine, const EngineInput& input, EngineOutput& output) {
+        engine.m_DetermineForeground(
+            input.m_Color,
+            input.m_Tolerance,
+            input.m_Image,
+            output.m_ForegroundMask,
+            output.m_Foreground
+        );
+
+        output.m_Result.reset();
+
+        if (engine.m_ProcessMask) {
+            cv::Mat output_image = input.m_Image.clone();
+            output.m_Result = engine.m_ProcessMask(output.m_ForegroundMask, output_image);
+            return;
+        }
+
+        std::vector<std::vector<cv::Point>> contours;
+        std::vector<cv::Vec4i>              hierarchy;
+
+        cv::findContours(output.m_ForegroundMask, contours, hierarchy, cv::RETR_CCOMP, cv::CHAIN_APPROX_SIMPLE);
+
+        if (!contours.empty()) {
+            cv::Mat output_image = input.m_Image.clone();
+            output.m_Result = engine.m_ProcessContours(contours, hierarchy, input.m_Image, output_image);
+        }
+    }
+
+    bool is_identical(const cv::Mat& a, const cv::Mat& b) {
+        return
+            a.size() == b.size() &&
+            a.type() == b.type() &&
+            cv::norm(a, b, cv::NORM_INF) == 0.0;
+    }
+
+    void require_equivalent(const Engine& engine, const EngineInput& input) {
+        INFO("engine " << engine.m_Name << ", input " << input.m_Name);
+
+        const auto& tolerance = get_tolerance(engine);
+
+        EngineOutput expected;
+        EngineOutput actual;
+
+        run_engine(get_reference_engine(), input, expected);
+
+        // first process an image that is foreground everywhere, so stale buffer contents would show up
+        EngineInput previous_frame = input;
+        previous_frame.m_Image = cv::Mat(input.m_Image.size(), CV_8UC3, input.m_Color);
+
+        run_engine(engine, previous_frame, actual);
+        run_engine(engine, input,          actual);
+
+        if (has_reference_foreground(engine)) {
+            REQUIRE(is_identical(actual.m_ForegroundMask, expected.m_ForegroundMask));
+            REQUIRE(is_identical(actual.m_Foreground,     expected.m_Foreground));
+        }
+
+        REQUIRE(actual.m_Result.has_value() == expected.m_Result.has_value());
+
+        if (!expected.m_Result)
+            return;
+
+        const auto& expected_teeth = expected.m_Result->m_Teeth;
+        const auto& actual_teeth   = actual.m_Result->m_Teeth;
+
+        REQUIRE(actual_teeth.size() == expected_teeth.size());
+        REQUIRE(std::hypot(
+            actual.m_Result->m_Centroid.x - expected.m_Result->m_Centroid.x,
+            actual.m_Result->m_Centroid.y - expected.m_Result->m_Centroid.y
+        ) <= tolerance.m_Radius);
+
+        const double angle_tolerance = tolerance.m_Angle * 2.0 * std::numbers::pi / static_cast<double>(expected_teeth.size());
+
+        for (size_t i = 0; i < expected_teeth.size(); ++i) {
+            INFO("tooth " << i);
+
+            REQUIRE(angle_difference(actual_teeth[i].m_StartingAngle, expected_teeth[i].m_StartingAngle) <= angle_tolerance);
+            REQUIRE(angle_difference(actual_teeth[i].m_EndingAngle,   expected_teeth[i].m_EndingAngle)   <= angle_tolerance);
+
+            REQUIRE(std::abs(actual_teeth[i].m_MinDistance - expected_teeth[i].m_MinDistance) <= tolerance.m_Radius);
+            REQUIRE(std::abs(actual_teeth[i].m_MaxDistance - expected_teeth[i].m_MaxDistance) <= tolerance.m_Flank);
+        }
+    }
+
+    std::vector<EngineInput> make_generated_inputs() {
+        std::vector<EngineInput> result;
+
+        for (const auto& spec : cc::bench::make_generated_specs())
+            result.push_back(EngineInput {
+                .m_Name      = std::to_string(spec.m_NumTeeth) + " generated teeth",
+                .m_Image     = cc::synthetic::generate_gear(spec).m_Image,
+                .m_Color     = spec.m_GearColor,
+                .m_Tolerance = cc::bench::k_GeneratedTolerance
+            });
+
+        return result;
+    }
+
+    std::optional<fs::path> find_data_path() {
+        try {
+            return cc::find_data_folder(fs::current_path());
+        }
+        catch (std::runtime_error&) {
+            return std::nullopt; // tests are running outside the source tree
+        }
+    }
+
+    std::vector<EngineInput> make_recorded_inputs(std::span<const Recording> recordings) {
+        std::vector<EngineInput> result;
+
+        auto data_path = find_data_path();
+
+        if (!data_path)
+            return result;
+
+        for (const auto& recording : recordings)
+            if (fs::exists(*data_path / recording.m_Filename))
+                result.push_back(EngineInput {
+                    .m_Name      = recording.m_Filename,
+                    .m_Image     = cc::io::load_jpg(*data_path / recording.m_Filename),
+                    .m_Color     = recording.m_Color,
+                    .m_Tolerance = recording.m_Tolerance
+                });
+
+        return result;
+    }
+}
+
+TEST_CASE("engines - registry", "[engines]") {
+    auto engines = get_engines();
+
+    REQUIRE(!engines.empty());
+    REQUIRE(&engines.front() == &get_reference_engine());
+    REQUIRE(get_reference_engine().m_Name == "reference");
+
+    for (const auto& engine : engines) {
+        REQUIRE(engine.m_DetermineForeground != nullptr);
+        REQUIRE(find_engine(engine.m_Name)   == &engine);
+
+        // either a contour kernel or a mask kernel
+        REQUIRE((engine.m_ProcessContours != nullptr) != (engine.m_ProcessMask != nullptr));
+    }
+
+    REQUIRE(find_engine("no such engine") == nullptr);
+}
+
+TEST_CASE("engines - generated gears match the reference engine", "[engines]") {
+    static const auto inputs = make_generated_inputs();
+
+    auto input_idx = GENERATE(range(size_t(0), inputs.size()));
+
+    for (const auto& engine : get_engines())
+        require_equivalent(engine, inputs[input_idx]);
+}
+
+TEST_CASE("engines - recorded images match the reference engine", "[engines]") {
+    auto inputs = make_recorded_inputs(cc::bench::k_Recordings);
+
+    if (inputs.empty())
+        WARN("No recorded images found; run the tests from within the source tree");
+
+    for (const auto& input : inputs)
+        for (const auto& engine : get_engines())
+            require_equivalent(engine, input);
+}
@@ -3,11 +3,14 @@
 #include <numbers>
 #include <random>
 #include <numeric>
+#include <algorithm>
 
 #include "processing/anomalies.h"
 #include "types/tooth_measurement.h"
 #include "types/tooth_anomaly.h"
 
+#include "allocation_budget.h"
+
 using std::numbers::pi;
 
 using namespace cc::processing;
@@ -161,4 +164,121 @@ TEST_CASE("find_anomalies - statistical threshold", "[anomalies]") {
 
     // The moderately different tooth should not be flagged due to the 3-sigma threshold
     REQUIRE((result[5] & cc::arc) == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("find_anomalies - allocation budget", "[anomalies][allocation]") {
+    auto teeth = make_uniform_gear(32);
+
+    // the anomaly mask plus the two scratch vectors, independent of the number of teeth
+    REQUIRE_ALLOCATIONS_AT_MOST(3, find_anomalies(teeth));
+}
+
+TEST_CASE("AnomalyScorer - empty input", "[anomalies]") {
+    AnomalyScorer                  scorer;
+    std::vector<ToothAnomalyScore> scores(3); // both are resized
+    std::vector<uint8_t>           mask(3);
+
+    scorer.score({}, scores, mask);
+
+    REQUIRE(scores.empty());
+    REQUIRE(mask.empty());
+}
+
+TEST_CASE("AnomalyScorer - uniform teeth score zero", "[anomalies]") {
+    AnomalyScorer                  scorer;
+    std::vector<ToothAnomalyScore> scores;
+    std::vector<uint8_t>           mask;
+
+    scorer.score(make_uniform_gear(12), scores, mask);
+
+    // all of the arcs are the same up to rounding
+    for (const auto& score : scores) {
+        REQUIRE(score.m_Arc < 1e-6);
+        REQUIRE(score.m_Gap < 1e-6);
+    }
+}
+
+TEST_CASE("AnomalyScorer - a missing tooth doesn't hide itself", "[anomalies]") {
+    auto teeth = make_uniform_gear(12);
+    teeth.erase(std::begin(teeth) + 5);
+
+    AnomalyScorer                  scorer;
+    std::vector<ToothAnomalyScore> scores;
+    std::vector<uint8_t>           mask;
+
+    scorer.score(teeth, scores, mask);
+
+    REQUIRE(scores.size() == 11);
+    REQUIRE(mask == create_anomaly_mask(scores, AnomalyScorer::k_StrongAnomaly));
+
+    // only the tooth before the missing one has a large gap
+    for (size_t i = 0; i < scores.size(); ++i) {
+        INFO("tooth " << i);
+
+        REQUIRE(((mask[i] & cc::gap) != 0) == (i == 4));
+        REQUIRE((mask[i] & cc::arc) == 0);
+    }
+
+    REQUIRE(scores[4].m_Gap > AnomalyScorer::k_StrongAnomaly);
+}
+
+TEST_CASE("AnomalyScorer - a wide tooth doesn't hide itself", "[anomalies]") {
+    auto teeth = make_uniform_gear(12);
+
+    auto regular_tooth_arc = teeth[0].m_EndingAngle - teeth[0].m_StartingAngle;
+
+    teeth[5].m_StartingAngle -= 0.5 * regular_tooth_arc;
+    teeth[5].m_EndingAngle   += 0.5 * regular_tooth_arc;
+
+    AnomalyScorer                  scorer;
+    std::vector<ToothAnomalyScore> scores;
+    std::vector<uint8_t>           mask;
+
+    scorer.score(teeth, scores, mask);
+
+    REQUIRE(mask == create_anomaly_mask(scores, AnomalyScorer::k_StrongAnomaly));
+
+    REQUIRE((mask[5] & cc::arc) != 0);
+    REQUIRE((mask[4] & cc::gap) != 0); // the neighbouring gaps shrunk
+    REQUIRE((mask[5] & cc::gap) != 0);
+
+    REQUIRE(std::count_if(std::begin(mask), std::end(mask), [](uint8_t m) { return (m & cc::arc) != 0; }) == 1);
+}
+
+TEST_CASE("AnomalyScorer - scores are continuous", "[anomalies]") {
+    auto teeth = make_normal_gear(24, 0.01);
+
+    AnomalyScorer                  scorer;
+    std::vector<ToothAnomalyScore> scores;
+    std::vector<uint8_t>           mask;
+
+    scorer.score(teeth, scores, mask);
+    auto before = scores[7].m_Arc;
+
+    // both steps are larger than the spread, so the tooth moves away from the median
+    teeth[7].m_EndingAngle += 0.03;
+    scorer.score(teeth, scores, mask);
+    auto small = scores[7].m_Arc;
+
+    teeth[7].m_EndingAngle += 0.03;
+    scorer.score(teeth, scores, mask);
+    auto large = scores[7].m_Arc;
+
+    REQUIRE(before < small);
+    REQUIRE(small < large);
+}
+
+TEST_CASE("AnomalyScorer - allocation budget", "[anomalies][allocation]") {
+    auto teeth = make_uniform_gear(32);
+
+    AnomalyScorer                  scorer;
+    std::vector<ToothAnomalyScore> scores;
+    std::vector<uint8_t>           mask;
+
+    scorer.score(teeth, scores, mask); // sizes the buffers
+
+    REQUIRE_ALLOCATIONS_AT_MOST(0, [&] {
+        scorer.score(teeth, scores, mask);
+        return mask.size();
+    }());
+}
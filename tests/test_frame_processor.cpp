@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "app/frame_processor.h"
+#include "app/frame_stats.h"
+#include "processing/anomalies.h"
+#include "processing/engine.h"
+#include "types/tooth_anomaly.h"
+#include "types/tooth_measurement.h"
+
+using namespace cc;
+using namespace cc::processing;
+
+using cc::app::FrameProcessor;
+using cc::app::FrameResult;
+using cc::app::FrameStats;
+
+namespace {
+    constexpr int    k_NumTeeth = 24;
+    constexpr double k_ToothArc = std::numbers::pi / k_NumTeeth; // half of the pitch
+    constexpr double k_Noise    = 0.0005; // well below the lowest deviation the scorers assume, so no tooth is flagged by chance
+    constexpr double k_Radius   = 100.0;
+
+    // teeth of the given arc, evenly spaced, with some measurement noise
+    std::vector<ToothMeasurement> make_gear(
+        double   tooth_arc,
+        unsigned seed
+    ) {
+        std::default_random_engine       generator(seed);
+        std::normal_distribution<double> distribution(0.0, k_Noise);
+
+        std::vector<ToothMeasurement> teeth(k_NumTeeth);
+
+        const double pitch = 2.0 * std::numbers::pi / k_NumTeeth;
+
+        for (int i = 0; i < k_NumTeeth; ++i) {
+            teeth[i].m_StartingAngle = i * pitch             + distribution(generator);
+            teeth[i].m_EndingAngle   = i * pitch + tooth_arc + distribution(generator);
+            teeth[i].m_MinDistance   = 0.9 * k_Radius;
+            teeth[i].m_MaxDistance   =       k_Radius;
+            teeth[i].m_ToothIdx      = i;
+        }
+
+        return teeth;
+    }
+
+    // the teeth the stub engine reports for the next frame
+    std::vector<ToothMeasurement> g_NextTeeth;
+
+    // skips the image processing, so the anomaly stages see exactly the prepared teeth
+    const Engine k_StubEngine = {
+        .m_Name                = "stub",
+        .m_DetermineForeground = [](const cv::Scalar&, int, const cv::Mat&, cv::Mat&, cv::Mat&) {},
+        .m_ProcessContours     = nullptr,
+        .m_ProcessMask         = [](const cv::Mat&, cv::Mat&) -> std::optional<ContourResult> {
+            return ContourResult {
+                .m_Teeth            = g_NextTeeth,
+                .m_Centroid         = { 160, 120 },
+                .m_NumContourPoints = g_NextTeeth.size()
+            };
+        }
+    };
+
+    const FrameResult* process(FrameProcessor& processor, std::vector<ToothMeasurement> teeth) {
+        g_NextTeeth = std::move(teeth);
+
+        cv::Mat source_image(240, 320, CV_8UC3, cv::Scalar(0, 0, 0));
+        cv::Mat output_image = source_image.clone();
+
+        return processor.process({ 255, 0, 0 }, 40, source_image, output_image);
+    }
+
+    bool has_anomalies(const std::vector<uint8_t>& mask) {
+        return std::ranges::any_of(mask, [](uint8_t m) { return m != 0; });
+    }
+}
+
+TEST_CASE("FrameProcessor flags gears that are regular on their own but not against the baseline", "[FrameProcessor][anomalies][baseline]") {
+    FrameStats     stats;
+    FrameProcessor processor(stats);
+
+    processor.set_engine(k_StubEngine);
+
+    for (unsigned i = 0; i < 32; ++i) {
+        const auto* result = process(processor, make_gear(k_ToothArc, i));
+
+        REQUIRE(result != nullptr);
+        REQUIRE(!has_anomalies(result->m_AnomalyMask));
+    }
+
+    REQUIRE(processor.get_baseline().is_ready());
+
+    const size_t num_gears = processor.get_baseline().get_num_gears();
+
+    // every tooth is 20% too wide -- regular on its own, but not compared to the earlier gears
+    const auto* result = process(processor, make_gear(1.2 * k_ToothArc, 1000));
+
+    REQUIRE(result != nullptr);
+    REQUIRE(result->m_AnomalyMask.size() == k_NumTeeth);
+
+    for (const auto& score : result->m_AnomalyScores) {
+        REQUIRE(score.m_Arc <= AnomalyScorer::k_StrongAnomaly);
+        REQUIRE(score.m_Gap <= AnomalyScorer::k_StrongAnomaly);
+    }
+
+    for (auto m : result->m_AnomalyMask)
+        REQUIRE((m & cc::arc) != 0);
+
+    // and it doesn't become part of the baseline
+    REQUIRE(processor.get_baseline().get_num_gears() == num_gears);
+
+    // a good gear is still fine
+    result = process(processor, make_gear(k_ToothArc, 2000));
+
+    REQUIRE(result != nullptr);
+    REQUIRE(!has_anomalies(result->m_AnomalyMask));
+}
@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "app/frame_stats.h"
+
+using cc::app::FrameStats;
+using namespace std::chrono_literals;
+
+TEST_CASE("frame stats summarize completed intervals", "[FrameStats]") {
+    FrameStats stats({}, 1s);
+
+    auto t0 = FrameStats::Clock::now();
+
+    stats.on_frame(t0); // marks the start
+
+    for (int i = 1; i <= 10; ++i) {
+        stats.record(FrameStats::e_Stage::foreground, 2ms);
+        stats.record(FrameStats::e_Stage::total,      5ms);
+
+        stats.on_frame(t0 + i * 100ms);
+    }
+
+    // 10 frames in one second
+    REQUIRE(stats.get_fps() == Catch::Approx(10.0));
+
+    const auto& summary = stats.get_summary();
+
+    REQUIRE(summary.size() == 3); // fps + the two stages that have measurements
+    REQUIRE(summary[0] == "10.0 fps");
+    REQUIRE(summary[1].starts_with("foreground"));
+    REQUIRE(summary[2].starts_with("total"));
+
+    // measurements of the next interval don't affect the summary until it completes
+    stats.record(FrameStats::e_Stage::capture, 1ms);
+    stats.on_frame(t0 + 1100ms);
+
+    REQUIRE(stats.get_summary() == summary);
+}
+
+TEST_CASE("frame stats export to csv", "[FrameStats]") {
+    auto path = std::filesystem::temp_directory_path() / "cc_test_frame_stats.csv";
+    std::filesystem::remove(path);
+
+    {
+        FrameStats stats(path, 1s, 2s);
+
+        auto t0 = FrameStats::Clock::now();
+        stats.on_frame(t0);
+
+        for (int i = 1; i <= 30; ++i) {
+            stats.record(FrameStats::e_Stage::process_contours, 3ms);
+            stats.on_frame(t0 + i * 100ms);
+        }
+    }
+
+    std::ifstream in(path);
+    REQUIRE(in.good());
+
+    std::string header;
+    std::string line;
+    std::getline(in, header);
+    std::getline(in, line);
+
+    REQUIRE(header == "time,stage,count,mean_us,p50_us,p99_us,max_us,fps,allocs_per_call,bytes_per_call,ipc,cache_misses_per_unit,branch_misses_per_unit,unit");
+    REQUIRE(line.find(",process_contours,20,") != std::string::npos); // exported after two intervals
+
+    in.close();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+#include <opencv2/opencv.hpp>
+
+#include "synthetic/gear_generator.h"
+#include "processing/contours.h"
+#include "processing/foreground.h"
+
+using namespace cc::synthetic;
+
+namespace {
+    double distance_to(const cv::Point2d& a, const cv::Point2d& b) {
+        return std::hypot(a.x - b.x, a.y - b.y);
+    }
+}
+
+TEST_CASE("gear generator - validation", "[synthetic]") {
+    GearSpec spec;
+    REQUIRE_NOTHROW(validate(spec));
+
+    SECTION("tooth count") {
+        spec.m_NumTeeth = k_MinNumTeeth - 1;
+        REQUIRE_THROWS_AS(validate(spec), GeneratorError);
+
+        spec.m_NumTeeth = k_MaxNumTeeth + 1;
+        REQUIRE_THROWS_AS(validate(spec), GeneratorError);
+    }
+
+    SECTION("resolution") {
+        spec.m_Resolution = { k_MaxResolution.m_Width + 1, 1080 };
+        REQUIRE_THROWS_AS(validate(spec), GeneratorError);
+
+        spec.m_Resolution = { 0, 1080 };
+        REQUIRE_THROWS_AS(validate(spec), GeneratorError);
+    }
+
+    SECTION("tooth indices") {
+        spec.m_MissingTeeth = { spec.m_NumTeeth };
+        REQUIRE_THROWS_AS(validate(spec), GeneratorError);
+    }
+
+    SECTION("eccentricity") {
+        spec.m_Eccentricity = 1.0;
+        REQUIRE_THROWS_AS(generate_gear(spec), GeneratorError);
+    }
+}
+
+TEST_CASE("gear generator - ground truth", "[synthetic]") {
+    GearSpec spec;
+    spec.m_NumTeeth     = 40;
+    spec.m_MissingTeeth = { 3, 17 };
+    spec.m_BrokenTeeth  = { 5 };
+
+    auto truth = make_ground_truth(spec);
+
+    REQUIRE(truth.get_num_teeth() == 38);
+    REQUIRE(truth.m_Center == cv::Point2d(640.0, 360.0));
+    REQUIRE(truth.m_TipRadius  == Catch::Approx(truth.m_Module * 21.0));
+    REQUIRE(truth.m_RootRadius == Catch::Approx(truth.m_Module * 18.75));
+
+    auto broken = std::ranges::find_if(truth.m_Teeth, [](const auto& tooth) { return tooth.m_IsBroken; });
+
+    REQUIRE(broken != truth.m_Teeth.end());
+    REQUIRE(broken->m_ToothIdx == 5);
+    REQUIRE(std::ranges::none_of(truth.m_Teeth, [](const auto& tooth) { return tooth.m_ToothIdx == 3 || tooth.m_ToothIdx == 17; }));
+
+    // without eccentricity, every tooth spans the same arc
+    const double pitch = 2.0 * std::numbers::pi / spec.m_NumTeeth;
+
+    for (const auto& tooth : truth.m_Teeth) {
+        double arc = std::remainder(tooth.m_EndingAngle - tooth.m_StartingAngle, 2.0 * std::numbers::pi);
+        REQUIRE(arc == Catch::Approx(0.4 * pitch));
+    }
+}
+
+TEST_CASE("gear generator - outline", "[synthetic]") {
+    GearSpec spec;
+    spec.m_NumTeeth     = 16;
+    spec.m_Module       = 10.0;
+    spec.m_CenterOffset = { 50.0, -20.0 };
+
+    auto truth   = make_ground_truth(spec);
+    auto outline = make_gear_outline(spec, 2048);
+
+    REQUIRE(outline.size() == 2048);
+    REQUIRE(make_gear_contour(spec, 777).size() == 777);
+
+    double min_radius = std::numeric_limits<double>::max();
+    double max_radius = 0.0;
+
+    for (const auto& pt : outline) {
+        min_radius = std::min(min_radius, distance_to(pt, truth.m_Center));
+        max_radius = std::max(max_radius, distance_to(pt, truth.m_Center));
+    }
+
+    REQUIRE(min_radius == Catch::Approx(truth.m_RootRadius));
+    REQUIRE(max_radius == Catch::Approx(truth.m_TipRadius));
+
+    SECTION("eccentricity squashes the vertical extent") {
+        spec.m_Eccentricity = 0.6; // axis ratio 0.8
+
+        auto squashed = make_gear_outline(spec, 2048);
+        auto [min_y, max_y] = std::ranges::minmax(squashed, {}, &cv::Point2d::y);
+
+        REQUIRE((max_y.y - min_y.y) == Catch::Approx(0.8 * 2.0 * truth.m_TipRadius).epsilon(0.01));
+    }
+
+    SECTION("outlines are deterministic") {
+        REQUIRE(make_gear_outline(spec, 2048) == outline);
+    }
+}
+
+TEST_CASE("gear generator - images", "[synthetic]") {
+    GearSpec spec;
+    spec.m_Resolution = { 640, 480 };
+    spec.m_NoiseSigma = 8.0;
+    spec.m_BlurRadius = 1;
+    spec.m_NumClutter = 20;
+
+    auto a = generate_gear(spec);
+    auto b = generate_gear(spec);
+
+    REQUIRE(a.m_Image.size() == cv::Size(640, 480));
+    REQUIRE(a.m_Image.type() == CV_8UC3);
+    REQUIRE(cv::norm(a.m_Image, b.m_Image, cv::NORM_INF) == 0.0); // same seed, same image
+
+    spec.m_Seed = 2;
+    auto c = generate_gear(spec);
+
+    REQUIRE(cv::norm(a.m_Image, c.m_Image, cv::NORM_INF) > 0.0);
+}
+
+TEST_CASE("gear generator - the pipeline counts the generated teeth", "[synthetic]") {
+    auto num_teeth = GENERATE(12, 24, 48);
+
+    GearSpec spec;
+    spec.m_Resolution = { 1280, 720 };
+    spec.m_NumTeeth   = num_teeth;
+    spec.m_Rotation   = 0.1;
+
+    auto gear = generate_gear(spec);
+
+    cv::Mat foreground_mask;
+    cv::Mat foreground;
+
+    cc::processing::determine_foreground(spec.m_GearColor, 30, gear.m_Image, foreground_mask, foreground);
+
+    std::vector<std::vector<cv::Point>> contours;
+    std::vector<cv::Vec4i>              hierarchy;
+
+    cv::findContours(foreground_mask, contours, hierarchy, cv::RETR_CCOMP, cv::CHAIN_APPROX_SIMPLE);
+    REQUIRE(!contours.empty());
+
+    cv::Mat output_image = gear.m_Image.clone();
+    auto result = cc::processing::process_contours(contours, hierarchy, output_image);
+
+    REQUIRE(result.has_value());
+    REQUIRE(result->m_Teeth.size() == gear.m_Truth.get_num_teeth());
+    REQUIRE(distance_to(cv::Point2d(result->m_Centroid), gear.m_Truth.m_Center) < 2.0);
+}
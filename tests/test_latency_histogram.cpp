@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "util/latency_histogram.h"
+
+using cc::util::LatencyHistogram;
+using namespace std::chrono_literals;
+
+TEST_CASE("bucket boundaries", "[LatencyHistogram]") {
+    // every bucket should contain exactly the values between its bounds
+    for (size_t i = 0; i < LatencyHistogram::k_NumBuckets; ++i) {
+        uint64_t lower = LatencyHistogram::bucket_lower_bound(i);
+        uint64_t upper = LatencyHistogram::bucket_upper_bound(i);
+
+        REQUIRE(lower <= upper);
+        REQUIRE(LatencyHistogram::bucket_index(lower) == i);
+        REQUIRE(LatencyHistogram::bucket_index(upper) == i);
+
+        if (i + 1 < LatencyHistogram::k_NumBuckets)
+            REQUIRE(LatencyHistogram::bucket_lower_bound(i + 1) == upper + 1);
+    }
+
+    REQUIRE(LatencyHistogram::bucket_index(std::numeric_limits<uint64_t>::max()) == LatencyHistogram::k_NumBuckets - 1);
+}
+
+TEST_CASE("empty histogram", "[LatencyHistogram]") {
+    LatencyHistogram histogram;
+
+    auto snapshot = histogram.snapshot();
+
+    REQUIRE(snapshot.m_Count            == 0);
+    REQUIRE(snapshot.percentile(50.0)   == 0ns);
+    REQUIRE(snapshot.mean()             == 0ns);
+    REQUIRE(snapshot.max()              == 0ns);
+}
+
+TEST_CASE("percentiles", "[LatencyHistogram]") {
+    LatencyHistogram histogram;
+
+    // 1..1000 microseconds, uniformly
+    for (int i = 1; i <= 1000; ++i)
+        histogram.record(std::chrono::microseconds(i));
+
+    auto snapshot = histogram.snapshot();
+
+    REQUIRE(snapshot.m_Count == 1000);
+    REQUIRE(snapshot.min()   == 1us);
+    REQUIRE(snapshot.max()   == 1000us);
+
+    // within the relative error of the sub-buckets (12.5%)
+    auto within_error = [](std::chrono::nanoseconds actual, std::chrono::nanoseconds expected) {
+        return std::abs(actual.count() - expected.count()) <= expected.count() / 8;
+    };
+
+    REQUIRE(within_error(snapshot.percentile(50.0), 500us));
+    REQUIRE(within_error(snapshot.percentile(90.0), 900us));
+    REQUIRE(within_error(snapshot.percentile(99.0), 990us));
+    REQUIRE(within_error(snapshot.mean(),           500us));
+
+    REQUIRE(snapshot.percentile(100.0) == 1000us);
+}
+
+TEST_CASE("merge and reset", "[LatencyHistogram]") {
+    LatencyHistogram a;
+    LatencyHistogram b;
+
+    a.record(10us);
+    b.record(20us);
+    b.record(30us);
+
+    auto merged = a.snapshot();
+    merged.merge(b.snapshot());
+
+    REQUIRE(merged.m_Count == 3);
+    REQUIRE(merged.min()   == 10us);
+    REQUIRE(merged.max()   == 30us);
+
+    a.reset();
+    REQUIRE(a.snapshot().m_Count == 0);
+}
+
+TEST_CASE("concurrent recording", "[LatencyHistogram]") {
+    LatencyHistogram histogram;
+
+    constexpr int k_NumThreads   = 4;
+    constexpr int k_NumPerThread = 10000;
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < k_NumThreads; ++t)
+        threads.emplace_back([&histogram, t] {
+            for (int i = 0; i < k_NumPerThread; ++i)
+                histogram.record(std::chrono::nanoseconds(t * 1000 + i % 1000));
+        });
+
+    for (auto& t : threads)
+        t.join();
+
+    REQUIRE(histogram.snapshot().m_Count == k_NumThreads * k_NumPerThread);
+}
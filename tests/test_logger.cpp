@@ -0,0 +1,253 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <format>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/async_log_backend.h"
+#include "util/logger.h"
+#include "util/spsc_ring_buffer.h"
+
+using cc::util::AsyncLogBackend;
+using cc::util::Logger;
+using cc::util::LogLevel;
+using cc::util::LogRecord;
+using cc::util::LogSink;
+using cc::util::SpscRingBuffer;
+using namespace std::chrono_literals;
+
+namespace {
+    // collects messages in memory; shared so the test can inspect it after the backend took ownership
+    struct MemorySink:
+        LogSink
+    {
+        struct Lines {
+            std::mutex               m_Mutex;
+            std::vector<std::string> m_Messages;
+            std::vector<std::string> m_Locations; // file:line
+            size_t                   m_NumFlushes = 0;
+        };
+
+        explicit MemorySink(Lines* lines): m_Lines(lines) {}
+
+        void write(const LogRecord& record) override {
+            std::unique_lock guard(m_Lines->m_Mutex);
+            m_Lines->m_Messages.emplace_back(record.get_message());
+
+            if (record.m_File)
+                m_Lines->m_Locations.push_back(std::format("{}:{}", record.m_File, record.m_Line));
+        }
+
+        void flush() override {
+            std::unique_lock guard(m_Lines->m_Mutex);
+            ++m_Lines->m_NumFlushes;
+        }
+
+        Lines* m_Lines;
+    };
+}
+
+TEST_CASE("spsc ring buffer", "[SpscRingBuffer]") {
+    SpscRingBuffer<int> buffer(3);
+
+    REQUIRE(buffer.get_capacity() == 4);
+    REQUIRE(buffer.is_empty());
+    REQUIRE(buffer.begin_read() == nullptr);
+
+    for (int i = 0; i < 4; ++i) {
+        int* slot = buffer.begin_write();
+        REQUIRE(slot != nullptr);
+        *slot = i;
+        buffer.end_write();
+    }
+
+    REQUIRE(buffer.begin_write() == nullptr); // full
+
+    for (int i = 0; i < 4; ++i) {
+        int* slot = buffer.begin_read();
+        REQUIRE(slot != nullptr);
+        REQUIRE(*slot == i);
+        buffer.end_read();
+    }
+
+    REQUIRE(buffer.is_empty());
+}
+
+TEST_CASE("spsc ring buffer across threads", "[SpscRingBuffer]") {
+    constexpr int k_NumItems = 100'000;
+
+    SpscRingBuffer<int> buffer(64);
+
+    std::thread producer([&] {
+        for (int i = 0; i < k_NumItems; ++i) {
+            int* slot = nullptr;
+
+            while (!(slot = buffer.begin_write()))
+                std::this_thread::yield();
+
+            *slot = i;
+            buffer.end_write();
+        }
+    });
+
+    bool in_order = true;
+
+    for (int expected = 0; expected < k_NumItems; ) {
+        if (int* slot = buffer.begin_read()) {
+            in_order &= (*slot == expected++);
+            buffer.end_read();
+        }
+        else
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    REQUIRE(in_order);
+}
+
+TEST_CASE("async log backend writes formatted messages", "[logger]") {
+    MemorySink::Lines lines;
+
+    {
+        AsyncLogBackend backend;
+        backend.add_sink(std::make_unique<MemorySink>(&lines));
+
+        REQUIRE(backend.push(LogLevel::INFO,    "hello {}", 42));
+        REQUIRE(backend.push(LogLevel::WARNING, "{} + {} = {}", 1, 2, 3));
+
+        backend.flush();
+
+        REQUIRE(lines.m_Messages.size() == 2);
+        REQUIRE(lines.m_Messages[0] == "hello 42");
+        REQUIRE(lines.m_Messages[1] == "1 + 2 = 3");
+        REQUIRE(lines.m_NumFlushes  >= 1);
+    }
+}
+
+TEST_CASE("async log backend truncates long messages", "[logger]") {
+    MemorySink::Lines lines;
+
+    AsyncLogBackend backend;
+    backend.add_sink(std::make_unique<MemorySink>(&lines));
+
+    std::string long_message(LogRecord::k_MaxMessageLength * 2, 'x');
+    backend.push(LogLevel::INFO, "{}", long_message);
+    backend.flush();
+
+    REQUIRE(lines.m_Messages.size() == 1);
+    REQUIRE(lines.m_Messages[0].size() == LogRecord::k_MaxMessageLength);
+}
+
+TEST_CASE("async log backend collapses repeated messages", "[logger]") {
+    MemorySink::Lines lines;
+
+    AsyncLogBackend backend(AsyncLogBackend::Config{ .m_RepeatInterval = 1h });
+    backend.add_sink(std::make_unique<MemorySink>(&lines));
+
+    for (int i = 0; i < 100; ++i)
+        backend.push(LogLevel::INFO, "same message");
+
+    backend.push(LogLevel::INFO, "different message");
+    backend.flush();
+
+    REQUIRE(lines.m_Messages.size() == 3);
+    REQUIRE(lines.m_Messages[0] == "same message");
+    REQUIRE(lines.m_Messages[1] == "Previous message repeated 99 times");
+    REQUIRE(lines.m_Messages[2] == "different message");
+    REQUIRE(backend.get_num_suppressed() == 99);
+}
+
+TEST_CASE("async log backend from multiple threads", "[logger]") {
+    constexpr int k_NumThreads   = 4;
+    constexpr int k_NumMessages  = 2000;
+
+    MemorySink::Lines lines;
+
+    // small buffers, so some messages are likely to be dropped
+    AsyncLogBackend backend(AsyncLogBackend::Config{ .m_RingCapacity = 16 });
+    backend.add_sink(std::make_unique<MemorySink>(&lines));
+
+    std::vector<std::thread> threads;
+    std::atomic<int>         num_accepted = 0;
+
+    for (int t = 0; t < k_NumThreads; ++t)
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < k_NumMessages; ++i)
+                if (backend.push(LogLevel::DEBUG, "thread {} message {}", t, i))
+                    ++num_accepted;
+        });
+
+    for (auto& t : threads)
+        t.join();
+
+    backend.flush();
+
+    // every message is either written or accounted for as dropped
+    REQUIRE(num_accepted + backend.get_num_dropped() == k_NumThreads * k_NumMessages);
+
+    size_t num_dropped_notices = (backend.get_num_dropped() > 0) ? 1 : 0;
+    REQUIRE(lines.m_Messages.size() >= static_cast<size_t>(num_accepted.load()) + num_dropped_notices);
+}
+
+TEST_CASE("log records capture the call site", "[logger]") {
+    MemorySink::Lines lines;
+
+    AsyncLogBackend backend;
+    backend.add_sink(std::make_unique<MemorySink>(&lines));
+
+    auto expected_line = __LINE__ + 1;
+    backend.push(LogLevel::INFO, "here");
+    backend.flush();
+
+    REQUIRE(lines.m_Locations.size() == 1);
+    REQUIRE(lines.m_Locations[0].ends_with(std::format("test_logger.cpp:{}", expected_line)));
+}
+
+TEST_CASE("logger forwards to the attached backend", "[logger]") {
+    MemorySink::Lines lines;
+
+    auto& logger = Logger::instance();
+
+    {
+        AsyncLogBackend backend;
+        backend.add_sink(std::make_unique<MemorySink>(&lines));
+
+        logger.set_backend(&backend);
+        LOG_WARNING("via logger {}", 1);
+        logger.set_backend(nullptr);
+
+        backend.flush();
+    }
+
+    if constexpr (Logger::is_compiled_in(LogLevel::WARNING)) {
+        REQUIRE(lines.m_Messages.size() == 1);
+        REQUIRE(lines.m_Messages[0] == "via logger 1");
+        REQUIRE(lines.m_Locations.size() == 1);
+    }
+    else
+        REQUIRE(lines.m_Messages.empty());
+}
+
+TEST_CASE("disabled log levels don't evaluate their arguments", "[logger]") {
+    auto& logger   = Logger::instance();
+    auto  previous = logger.get_level();
+
+    int num_evaluated = 0;
+    [[maybe_unused]] auto evaluate = [&] { return ++num_evaluated; }; // unused when compiled out
+
+    logger.set_level(LogLevel::ERR);
+
+    LOG_DEBUG("{}", evaluate());
+    LOG_INFO("{}", evaluate());
+    LOG_WARNING("{}", evaluate());
+
+    logger.set_level(previous);
+
+    REQUIRE(num_evaluated == 0);
+
+    STATIC_REQUIRE(Logger::is_compiled_in(LogLevel::ERR) == (CC_LOG_MIN_LEVEL <= CC_LOG_LEVEL_ERROR));
+    STATIC_REQUIRE(Logger::is_compiled_in(LogLevel::DEBUG) == (CC_LOG_MIN_LEVEL <= CC_LOG_LEVEL_DEBUG));
+}
@@ -0,0 +1,46 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cstdint>
+
+#include "util/perf_counters.h"
+
+using cc::util::PerfCounters;
+using cc::util::PerfSample;
+
+TEST_CASE("perf sample arithmetic", "[perf]") {
+    PerfSample a { .m_Cycles = 1000, .m_Instructions = 2500, .m_CacheMisses = 10, .m_BranchMisses = 4 };
+    PerfSample b { .m_Cycles =  200, .m_Instructions =  500, .m_CacheMisses =  3, .m_BranchMisses = 1 };
+
+    auto difference = a - b;
+
+    REQUIRE(difference == PerfSample{ .m_Cycles = 800, .m_Instructions = 2000, .m_CacheMisses = 7, .m_BranchMisses = 3 });
+    REQUIRE(difference.get_ipc() == Catch::Approx(2.5));
+
+    difference += b;
+    REQUIRE(difference == a);
+
+    REQUIRE(PerfSample{}.get_ipc() == 0.0);
+}
+
+TEST_CASE("perf counters measure the current thread or fall back to zero", "[perf]") {
+    PerfCounters counters;
+
+    auto before = counters.sample();
+
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 1'000'000; ++i)
+        sum = sum + i;
+
+    auto delta = counters.sample() - before;
+
+    if (counters.is_available()) {
+        REQUIRE(delta.m_Cycles       > 0);
+        REQUIRE(delta.m_Instructions > 0);
+    }
+    else
+        REQUIRE(delta == PerfSample{});
+
+    if constexpr (!cc::util::is_perf_counters_enabled())
+        REQUIRE_FALSE(counters.is_available());
+}
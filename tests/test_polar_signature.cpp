@@ -0,0 +1,310 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "processing/polar_signature.h"
+#include "processing/radial_analysis.h"
+#include "synthetic/gear_generator.h"
+
+#include "angles.h"
+
+using namespace cc::processing;
+using namespace cc;
+
+using cc::test::angle_difference;
+
+using Catch::Approx;
+
+namespace {
+    const cv::Point2f k_Center = { 500.0f, 500.0f };
+
+    // the generated gears are centered in the default 1280 x 720 image
+    const cv::Point2i k_GearCentroidI = { 640, 360 };
+    const cv::Point2f k_GearCentroidF = { 640.0f, 360.0f };
+
+    constexpr double k_AngleTolerance  = 0.01; // radians
+    constexpr double k_RadiusTolerance = 1.0;  // pixels
+
+    // the largest distance of a tooth is found on a flank, just below the threshold; that depends on where the flank
+    // is sampled -- by the contour points or by the rays of the signature
+    constexpr double k_FlankTolerance  = 5.0;  // pixels
+
+    // the outline of a generated gear, sampled about as densely as the contours of the camera images
+    std::vector<cv::Point> make_gear_contour(
+        int    num_teeth,
+        double rotation,
+        size_t num_points = 4096
+    ) {
+        synthetic::GearSpec spec;
+
+        spec.m_NumTeeth = num_teeth;
+        spec.m_Rotation = rotation;
+
+        return synthetic::make_gear_contour(spec, num_points);
+    }
+
+    // a 1000 x 1000 mask with the pixels for which is_inside(dx, dy) holds, relative to k_Center
+    template <typename F>
+    cv::Mat make_mask(F&& is_inside) {
+        cv::Mat mask(1000, 1000, CV_8UC1, cv::Scalar(0));
+
+        for (int y = 0; y < mask.rows; ++y)
+            for (int x = 0; x < mask.cols; ++x)
+                mask.at<uint8_t>(y, x) = is_inside(x - k_Center.x, y - k_Center.y) ? 255 : 0;
+
+        return mask;
+    }
+}
+
+TEST_CASE("resample_polar - circle", "[polar_signature]") {
+    std::vector<cv::Point> contour;
+
+    // a few points per ray and a few rays per point, both have to work
+    auto num_points = GENERATE(size_t(360), size_t(20000));
+
+    for (size_t i = 0; i < num_points; ++i) {
+        double angle = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(num_points);
+
+        contour.emplace_back(
+            static_cast<int>(std::lround(k_Center.x + 400.0 * std::cos(angle))),
+            static_cast<int>(std::lround(k_Center.y + 400.0 * std::sin(angle)))
+        );
+    }
+
+    PolarSignature signature;
+
+    REQUIRE(resample_polar(contour, k_Center, signature));
+    REQUIRE(signature.m_Direction == 1);
+    REQUIRE(signature.m_FirstBin  == 0);
+
+    for (float radius : signature.m_Radii)
+        REQUIRE(radius == Approx(400.0).margin(1.0));
+
+    std::ranges::reverse(contour);
+
+    REQUIRE(resample_polar(contour, k_Center, signature));
+    REQUIRE(signature.m_Direction == -1);
+}
+
+TEST_CASE("resample_polar - the outermost crossing is used", "[polar_signature]") {
+    // a square around the center with a zig-zag on the right side, the ray to the right crosses it three times
+    std::vector<cv::Point> contour = {
+        { 600, 400 }, { 600, 510 }, { 620, 510 }, { 620, 490 }, { 640, 490 }, { 640, 600 },
+        { 400, 600 }, { 400, 400 }
+    };
+
+    PolarSignature signature;
+
+    REQUIRE(resample_polar(contour, k_Center, signature));
+    REQUIRE(signature.m_Radii[0]                             == Approx(140.0));
+    REQUIRE(signature.m_Radii[PolarSignature::k_NumBins / 2] == Approx(100.0));
+    REQUIRE(signature.m_Radii[PolarSignature::k_NumBins / 8] == Approx(100.0 * std::numbers::sqrt2).epsilon(0.001));
+}
+
+TEST_CASE("resample_polar - empty contour", "[polar_signature]") {
+    PolarSignature signature;
+
+    REQUIRE(!resample_polar({}, k_Center, signature));
+}
+
+TEST_CASE("sample_polar - disc with a hole", "[polar_signature]") {
+    // the hole is off-center, so the centroid of the mask itself is off too
+    auto mask = make_mask([](float dx, float dy) {
+        return
+            std::hypot(dx,         dy)         <= 300.0f &&
+            std::hypot(dx + 60.0f, dy - 40.0f) >  100.0f;
+    });
+
+    PolarSignature signature;
+
+    REQUIRE(sample_polar(mask, k_Center, 450.0f, signature));
+    REQUIRE(signature.m_Direction == -1);
+
+    // the topmost point is straight up
+    REQUIRE(angle_difference(PolarSignature::get_angle(signature.m_FirstBin), 1.5 * std::numbers::pi) <= 0.05);
+
+    for (float radius : signature.m_Radii)
+        REQUIRE(radius == Approx(300.0).margin(k_RadiusTolerance));
+
+    auto centroid = find_outline_centroid(signature);
+
+    REQUIRE(centroid.x == Approx(k_Center.x).margin(0.5));
+    REQUIRE(centroid.y == Approx(k_Center.y).margin(0.5));
+}
+
+TEST_CASE("sample_polar - foreground past the outer radius is ignored", "[polar_signature]") {
+    auto mask = make_mask([](float dx, float dy) {
+        const float distance = std::hypot(dx, dy);
+
+        return distance <= 200.0f || (distance >= 350.0f && distance <= 360.0f);
+    });
+
+    PolarSignature signature;
+
+    REQUIRE(sample_polar(mask, k_Center, 300.0f, signature));
+
+    for (float radius : signature.m_Radii)
+        REQUIRE(radius == Approx(200.0).margin(k_RadiusTolerance));
+}
+
+TEST_CASE("sample_polar - foreground inside the outer radius is found on every ray", "[polar_signature]") {
+    // a blob just outside the disc, away from the boundaries of the sectors the rays are split into -- the rays next
+    // to it stop on the disc, which must not keep the rays through it from stopping on the blob
+    constexpr double k_BlobAngle    = 0.2;   // radians
+    constexpr double k_BlobDistance = 260.0;
+    constexpr double k_BlobRadius   = 20.0;
+
+    const double blob_x = k_BlobDistance * std::cos(k_BlobAngle);
+    const double blob_y = k_BlobDistance * std::sin(k_BlobAngle);
+
+    auto mask = make_mask([&](float dx, float dy) {
+        return
+            std::hypot(dx,          dy)          <= 200.0 ||
+            std::hypot(dx - blob_x, dy - blob_y) <= k_BlobRadius;
+    });
+
+    PolarSignature signature;
+
+    REQUIRE(sample_polar(mask, k_Center, 300.0f, signature));
+
+    const double blob_half_angle = std::asin(k_BlobRadius / k_BlobDistance);
+
+    for (size_t bin = 0; bin < PolarSignature::k_NumBins; ++bin) {
+        INFO("bin " << bin);
+
+        const double offset = angle_difference(PolarSignature::get_angle(bin), k_BlobAngle);
+
+        if (offset < 0.5 * blob_half_angle) {
+            // where the ray leaves the blob
+            const double across = k_BlobDistance * std::sin(offset);
+            const double far    = k_BlobDistance * std::cos(offset) + std::sqrt(k_BlobRadius * k_BlobRadius - across * across);
+
+            REQUIRE(signature.m_Radii[bin] == Approx(far).margin(k_RadiusTolerance));
+        }
+        else if (offset > 1.5 * blob_half_angle)
+            REQUIRE(signature.m_Radii[bin] == Approx(200.0).margin(k_RadiusTolerance));
+    }
+}
+
+TEST_CASE("sample_polar - square teeth", "[polar_signature]") {
+    constexpr int    k_NumTeeth = 24;
+    constexpr double k_Pitch    = 2.0 * std::numbers::pi / k_NumTeeth;
+
+    // teeth out to 300, gaps down to 250; the first tooth starts at a quarter pitch
+    auto mask = make_mask([](float dx, float dy) {
+        const double angle = std::atan2(dy, dx) + 2.0 * std::numbers::pi - 0.25 * k_Pitch;
+        const bool   tooth = std::fmod(angle, k_Pitch) < 0.5 * k_Pitch;
+
+        return std::hypot(dx, dy) <= (tooth ? 300.0f : 250.0f);
+    });
+
+    PolarSignature signature;
+
+    REQUIRE(sample_polar(mask, k_Center, 450.0f, signature));
+
+    auto teeth = measure_teeth_polar(signature);
+
+    REQUIRE(teeth.has_value());
+    REQUIRE(teeth->size() == k_NumTeeth);
+
+    for (const auto& tooth : *teeth) {
+        REQUIRE(tooth.m_MinDistance == Approx(250.0).margin(k_RadiusTolerance));
+
+        // measured below the threshold, so across a gap
+        REQUIRE(std::abs(angle_difference(tooth.m_EndingAngle, tooth.m_StartingAngle) - 0.5 * k_Pitch) <= k_AngleTolerance);
+    }
+}
+
+TEST_CASE("sample_polar - empty mask", "[polar_signature]") {
+    auto mask = make_mask([](float, float) { return false; });
+
+    PolarSignature signature;
+
+    REQUIRE(!sample_polar(mask, k_Center, 450.0f, signature));
+}
+
+TEST_CASE("measure_teeth_polar matches measure_teeth_fused", "[polar_signature]") {
+    auto num_teeth   = GENERATE(8, 24, 97);
+    auto rotation    = GENERATE(0.0, 0.3, 2.0);
+    auto is_reversed = GENERATE(false, true);
+
+    INFO(num_teeth << " teeth, rotation " << rotation << (is_reversed ? ", reversed" : ""));
+
+    auto contour = make_gear_contour(num_teeth, rotation);
+
+    if (is_reversed)
+        std::ranges::reverse(contour);
+
+    PolarSignature signature;
+
+    REQUIRE(resample_polar(contour, k_GearCentroidF, signature));
+
+    auto expected = measure_teeth_fused(contour, k_GearCentroidI, k_GearCentroidF);
+    auto actual   = measure_teeth_polar(signature);
+
+    REQUIRE(expected.has_value());
+    REQUIRE(actual.has_value());
+    REQUIRE(actual->size() == expected->size());
+    REQUIRE(actual->size() == static_cast<size_t>(num_teeth));
+
+    for (size_t i = 0; i < expected->size(); ++i) {
+        const auto& e = (*expected)[i];
+        const auto& a = (*actual)[i];
+
+        INFO("tooth " << i);
+
+        REQUIRE(a.m_ToothIdx == e.m_ToothIdx);
+
+        REQUIRE(a.m_LowHighTransitionIdx < PolarSignature::k_NumBins);
+        REQUIRE(a.m_HighLowTransitionIdx < PolarSignature::k_NumBins);
+
+        REQUIRE(angle_difference(a.m_StartingAngle, e.m_StartingAngle) <= k_AngleTolerance);
+        REQUIRE(angle_difference(a.m_EndingAngle,   e.m_EndingAngle)   <= k_AngleTolerance);
+
+        REQUIRE(std::abs(a.m_MinDistance - e.m_MinDistance) <= k_RadiusTolerance);
+        REQUIRE(std::abs(a.m_MaxDistance - e.m_MaxDistance) <= k_FlankTolerance);
+    }
+}
+
+TEST_CASE("measure_teeth_polar - the result doesn't depend on the contour resolution", "[polar_signature]") {
+    PolarSignature coarse;
+    PolarSignature fine;
+
+    REQUIRE(resample_polar(make_gear_contour(24, 0.3,    500), k_GearCentroidF, coarse));
+    REQUIRE(resample_polar(make_gear_contour(24, 0.3, 50'000), k_GearCentroidF, fine));
+
+    auto coarse_teeth = measure_teeth_polar(coarse);
+    auto fine_teeth   = measure_teeth_polar(fine);
+
+    REQUIRE(coarse_teeth.has_value());
+    REQUIRE(fine_teeth.has_value());
+    REQUIRE(coarse_teeth->size() == 24);
+    REQUIRE(fine_teeth->size()   == 24);
+
+    for (size_t i = 0; i < 24; ++i) {
+        const auto& c = (*coarse_teeth)[i];
+        const auto& f = (*fine_teeth)[i];
+
+        REQUIRE(angle_difference(c.m_StartingAngle, f.m_StartingAngle) <= k_AngleTolerance);
+        REQUIRE(angle_difference(c.m_EndingAngle,   f.m_EndingAngle)   <= k_AngleTolerance);
+
+        REQUIRE(std::abs(c.m_MinDistance - f.m_MinDistance) <= k_RadiusTolerance);
+        REQUIRE(std::abs(c.m_MaxDistance - f.m_MaxDistance) <= k_FlankTolerance);
+    }
+}
+
+TEST_CASE("measure_teeth_polar - no transitions", "[polar_signature]") {
+    PolarSignature signature;
+
+    signature.m_Radii.fill(250.0f);
+
+    REQUIRE(!measure_teeth_polar(signature).has_value());
+}
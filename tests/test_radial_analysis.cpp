@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "processing/count_teeth.h"
+#include "processing/radial_analysis.h"
+
+using namespace cc::processing;
+using namespace cc;
+
+using Catch::Approx;
+
+namespace {
+    const cv::Point2i k_CentroidI = { 500, 500 };
+    const cv::Point2f k_CentroidF = { 500.3f, 499.6f };
+
+    // a gear outline with square teeth; the contour starts at the given fraction of a tooth pitch,
+    // so depending on the phase a tooth wraps around the end of the contour
+    std::vector<cv::Point> make_gear_contour(
+        size_t num_points,
+        int    num_teeth,
+        double phase
+    ) {
+        std::vector<cv::Point> contour;
+
+        const double pitch = 2.0 * std::numbers::pi / num_teeth;
+
+        for (size_t i = 0; i < num_points; ++i) {
+            double angle  = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(num_points) + phase * pitch;
+            double radius = (std::fmod(angle, pitch) < pitch / 2.0) ? 300.0 : 260.0;
+
+            contour.emplace_back(
+                static_cast<int>(std::lround(k_CentroidI.x + radius * std::cos(angle))),
+                static_cast<int>(std::lround(k_CentroidI.y + radius * std::sin(angle)))
+            );
+        }
+
+        return contour;
+    }
+
+    // the separate passes of process_contours
+    std::optional<std::vector<ToothMeasurement>> measure_teeth_reference(
+        const std::vector<cv::Point>& contour,
+              std::vector<double>&    distances,
+              std::vector<uint8_t>&   tooth_mask
+    ) {
+        distances.clear();
+        tooth_mask.clear();
+
+        for (const auto& pt : contour)
+            distances.push_back(std::hypot(pt.x - k_CentroidI.x, pt.y - k_CentroidI.y));
+
+        auto [min_distance, max_distance] = std::minmax_element(distances.begin(), distances.end());
+        double threshold = (*min_distance + *max_distance) / 2.0;
+
+        for (double distance : distances)
+            tooth_mask.push_back((distance < threshold) ? 1 : 0);
+
+        auto first_tooth = find_tooth_start(tooth_mask);
+
+        if (!first_tooth)
+            return std::nullopt;
+
+        return count_teeth(*first_tooth, tooth_mask, contour, distances, k_CentroidF);
+    }
+}
+
+TEST_CASE("measure_teeth_fused matches the separate passes", "[radial_analysis]") {
+    auto num_teeth = GENERATE(8, 24, 97);
+    auto phase     = GENERATE(0.0, 0.1, 0.25, 0.5, 0.6, 0.9);
+
+    INFO(num_teeth << " teeth, phase " << phase);
+
+    auto contour = make_gear_contour(static_cast<size_t>(num_teeth) * 40, num_teeth, phase);
+
+    std::vector<double>  distances;
+    std::vector<uint8_t> tooth_mask;
+
+    auto expected = measure_teeth_reference(contour, distances, tooth_mask);
+
+    RadialDebug debug;
+    auto actual = measure_teeth_fused(contour, k_CentroidI, k_CentroidF, &debug);
+
+    REQUIRE(expected.has_value());
+    REQUIRE(actual.has_value());
+    REQUIRE(actual->size() == expected->size());
+    REQUIRE(actual->size() == static_cast<size_t>(num_teeth));
+
+    REQUIRE(debug.m_Distances == distances);
+    REQUIRE(debug.m_ToothMask == tooth_mask);
+
+    for (size_t i = 0; i < expected->size(); ++i) {
+        const auto& e = (*expected)[i];
+        const auto& a = (*actual)[i];
+
+        INFO("tooth " << i);
+
+        REQUIRE(a.m_ToothIdx             == e.m_ToothIdx);
+        REQUIRE(a.m_LowHighTransitionIdx == e.m_LowHighTransitionIdx);
+        REQUIRE(a.m_HighLowTransitionIdx == e.m_HighLowTransitionIdx);
+        REQUIRE(a.m_StartingAngle        == e.m_StartingAngle);
+        REQUIRE(a.m_EndingAngle          == e.m_EndingAngle);
+        REQUIRE(a.m_MinDistance          == Approx(e.m_MinDistance));
+        REQUIRE(a.m_MaxDistance          == Approx(e.m_MaxDistance));
+    }
+}
+
+TEST_CASE("measure_teeth_fused - the wrapped tooth is measured", "[radial_analysis]") {
+    // the contour starts halfway a tooth, so the last tooth ends near the start of the contour
+    auto contour = make_gear_contour(480, 12, 0.75);
+    auto teeth   = measure_teeth_fused(contour, k_CentroidI, k_CentroidF);
+
+    REQUIRE(teeth.has_value());
+    REQUIRE(teeth->size() == 12);
+
+    const auto& last = teeth->back();
+
+    REQUIRE(last.m_HighLowTransitionIdx < last.m_LowHighTransitionIdx);
+    REQUIRE(last.m_MinDistance == Approx(260.0).margin(1.0));
+    REQUIRE(last.m_MaxDistance == Approx(260.0).margin(1.0));
+}
+
+TEST_CASE("measure_teeth_fused - no transitions", "[radial_analysis]") {
+    REQUIRE(!measure_teeth_fused({}, k_CentroidI, k_CentroidF).has_value());
+
+    std::vector<cv::Point> square = { { 400, 400 }, { 600, 400 }, { 600, 600 }, { 400, 600 } };
+
+    REQUIRE(!measure_teeth_fused(square, k_CentroidI, k_CentroidF).has_value());
+}
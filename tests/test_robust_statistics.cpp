@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "math/robust_statistics.h"
+
+using namespace cc::math;
+
+TEST_CASE("select_median", "[math][statistics]") {
+    std::vector<double> odd   = { 5.0, 1.0, 4.0, 2.0, 3.0 };
+    std::vector<double> even  = { 4.0, 1.0, 3.0, 2.0 };
+    std::vector<double> one   = { 7.0 };
+    std::vector<double> empty = {};
+
+    REQUIRE(select_median(odd)   == 3.0);
+    REQUIRE(select_median(even)  == 2.5);
+    REQUIRE(select_median(one)   == 7.0);
+    REQUIRE(select_median(empty) == 0.0);
+}
+
+TEST_CASE("select_median matches sorting", "[math][statistics]") {
+    std::default_random_engine             generator(7); // fixed seed for reproducibility
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    for (size_t count : { 2, 3, 31, 32, 1001 }) {
+        std::vector<double> values(count);
+
+        for (auto& value : values)
+            value = distribution(generator);
+
+        auto sorted = values;
+        std::ranges::sort(sorted);
+
+        double expected = (count % 2 == 1) ?
+            sorted[count / 2] :
+            (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+
+        REQUIRE(select_median(values) == expected);
+    }
+}
+
+TEST_CASE("select_median_absolute_deviation", "[math][statistics]") {
+    // one outlier barely moves the median or the MAD
+    std::vector<double> values = { 1.0, 2.0, 3.0, 4.0, 100.0 };
+
+    double median = select_median(values);
+    double mad    = select_median_absolute_deviation(values, median);
+
+    REQUIRE(median == 3.0);
+    REQUIRE(mad    == 1.0);
+}
+
+TEST_CASE("select_low_median", "[math][statistics]") {
+    std::vector<double> odd   = { 5.0, 1.0, 4.0, 2.0, 3.0 };
+    std::vector<double> even  = { 4.0, 1.0, 3.0, 2.0 };
+    std::vector<double> empty = {};
+
+    REQUIRE(select_low_median(odd)   == 3.0);
+    REQUIRE(select_low_median(even)  == 2.0);
+    REQUIRE(select_low_median(empty) == 0.0);
+
+    // the same outlier as above
+    std::vector<double> values = { 1.0, 2.0, 3.0, 4.0, 100.0, 5.0 };
+
+    double median = select_low_median(values);
+    double mad    = select_low_median_absolute_deviation(values, median);
+
+    REQUIRE(median == 3.0);
+    REQUIRE(mad    == 1.0); // deviations 0, 1, 1, 2, 2, 97
+}
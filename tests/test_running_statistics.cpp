@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "math/running_statistics.h"
+#include "math/statistics.h"
+
+using namespace cc::math;
+using Catch::Approx;
+
+namespace {
+    std::vector<double> make_values(size_t count, double offset) {
+        std::default_random_engine       generator(42); // fixed seed for reproducibility
+        std::normal_distribution<double> distribution(0.0, 1.0);
+
+        std::vector<double> values(count);
+
+        for (auto& value : values)
+            value = offset + distribution(generator);
+
+        return values;
+    }
+
+    // straightforward two-pass reference
+    double two_pass_variance(const std::vector<double>& values) {
+        double mean = 0.0;
+
+        for (double value : values)
+            mean += value;
+
+        mean /= static_cast<double>(values.size());
+
+        double sum_of_squares = 0.0;
+
+        for (double value : values)
+            sum_of_squares += (value - mean) * (value - mean);
+
+        return sum_of_squares / static_cast<double>(values.size());
+    }
+}
+
+TEST_CASE("RunningStatistics matches the two-pass calculation", "[math][statistics]") {
+    auto values = make_values(1000, 3.0);
+
+    RunningStatistics stats;
+
+    for (double value : values)
+        stats.add(value);
+
+    REQUIRE(stats.get_count() == values.size());
+    REQUIRE(stats.get_mean()  == Approx(calculate_mean(values)));
+    REQUIRE(stats.get_variance() == Approx(two_pass_variance(values)));
+    REQUIRE(stats.get_sample_variance() == Approx(two_pass_variance(values) * 1000.0 / 999.0));
+    REQUIRE(stats.get_standard_deviation() == Approx(std::sqrt(two_pass_variance(values))));
+
+    REQUIRE(stats.get_min() == *std::ranges::min_element(values));
+    REQUIRE(stats.get_max() == *std::ranges::max_element(values));
+}
+
+TEST_CASE("RunningStatistics stays accurate with a large offset", "[math][statistics]") {
+    // a sum of squares approach loses all precision here, the spread is tiny compared to the values
+    std::vector<double> values = { 1e9 + 4.0, 1e9 + 7.0, 1e9 + 13.0, 1e9 + 16.0 };
+
+    auto stats = calculate_statistics(values);
+
+    REQUIRE(stats.get_mean()        == 1e9 + 10.0);
+    REQUIRE(stats.get_variance()    == Approx(22.5));
+    REQUIRE(calculate_variance(values) == Approx(22.5));
+}
+
+TEST_CASE("RunningStatistics merge equals a single accumulator", "[math][statistics]") {
+    auto values = make_values(999, -2.0);
+
+    auto all = calculate_statistics(values);
+
+    // uneven parts, including an empty one
+    std::span<const double> view(values);
+
+    RunningStatistics merged;
+    merged.merge(calculate_statistics(view.subspan(  0, 100)));
+    merged.merge(RunningStatistics());
+    merged.merge(calculate_statistics(view.subspan(100, 1)));
+    merged.merge(calculate_statistics(view.subspan(101)));
+
+    REQUIRE(merged.get_count()    == all.get_count());
+    REQUIRE(merged.get_mean()     == Approx(all.get_mean()));
+    REQUIRE(merged.get_variance() == Approx(all.get_variance()));
+    REQUIRE(merged.get_min()      == all.get_min());
+    REQUIRE(merged.get_max()      == all.get_max());
+}
+
+TEST_CASE("RunningStatistics accepts any contiguous range", "[math][statistics]") {
+    std::array<float, 4> floats = { 1.0f, 2.0f, 3.0f, 4.0f };
+    std::vector<int>     ints   = { 1, 2, 3, 4 };
+
+    REQUIRE(calculate_mean(floats)                       == 2.5);
+    REQUIRE(calculate_mean(std::span(ints))              == 2.5);
+    REQUIRE(calculate_variance(ints)                     == Approx(1.25));
+    REQUIRE(calculate_standard_deviation(floats)         == Approx(std::sqrt(1.25)));
+    REQUIRE(calculate_statistics(ints).get_max()         == 4.0);
+}
+
+TEST_CASE("RunningStatistics empty and reset", "[math][statistics]") {
+    RunningStatistics stats;
+
+    REQUIRE(stats.get_count()           == 0);
+    REQUIRE(stats.get_mean()            == 0.0);
+    REQUIRE(stats.get_variance()        == 0.0);
+    REQUIRE(stats.get_sample_variance() == 0.0);
+    REQUIRE(stats.get_min()             ==  std::numeric_limits<double>::infinity());
+    REQUIRE(stats.get_max()             == -std::numeric_limits<double>::infinity());
+
+    stats.add(5.0);
+
+    REQUIRE(stats.get_mean()            == 5.0);
+    REQUIRE(stats.get_variance()        == 0.0);
+    REQUIRE(stats.get_sample_variance() == 0.0);
+
+    stats.reset();
+
+    REQUIRE(stats.get_count() == 0);
+    REQUIRE(stats.get_mean()  == 0.0);
+}
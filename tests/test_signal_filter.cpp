@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "processing/signal_filter.h"
+
+using namespace cc::processing;
+
+TEST_CASE("median_filter - removes single spikes", "[signal_filter]") {
+    std::vector<double> signal = { 5, 5, 5, 9, 5, 5, 1, 5, 5, 5 };
+    std::vector<double> result;
+
+    median_filter(signal, 3, result);
+
+    REQUIRE(result == std::vector<double>(signal.size(), 5.0));
+}
+
+TEST_CASE("median_filter - keeps steps", "[signal_filter]") {
+    std::vector<double> signal = { 1, 1, 1, 1, 8, 8, 8, 8 };
+    std::vector<double> result;
+
+    median_filter(signal, 5, result);
+
+    REQUIRE(result == signal);
+}
+
+TEST_CASE("median_filter - wraps around", "[signal_filter]") {
+    // the spike at the end is surrounded by the start of the signal
+    std::vector<double> signal = { 2, 2, 3, 3, 3, 3, 2, 9 };
+    std::vector<double> result;
+
+    median_filter(signal, 3, result);
+
+    REQUIRE(result == std::vector<double>{ 2, 2, 3, 3, 3, 3, 3, 2 });
+}
+
+TEST_CASE("median_filter - empty signal", "[signal_filter]") {
+    std::vector<double> result = { 1.0 };
+
+    median_filter({}, 5, result);
+
+    REQUIRE(result.empty());
+}
+
+TEST_CASE("threshold_hysteresis - noise within the band doesn't toggle", "[signal_filter]") {
+    std::vector<double> signal = { 10, 10, 5.5, 4.5, 5.5, 4.5, 0, 0, 4.5, 5.5, 4.5, 10 };
+    std::vector<uint8_t> mask;
+
+    threshold_hysteresis(signal, 4, 6, mask);
+
+    REQUIRE(mask == std::vector<uint8_t>{ 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0 });
+}
+
+TEST_CASE("threshold_hysteresis - the start continues from the end", "[signal_filter]") {
+    // low at the end, so the first (in-band) samples are low too
+    std::vector<double> signal = { 5, 5, 10, 10, 5, 0, 5 };
+    std::vector<uint8_t> mask;
+
+    threshold_hysteresis(signal, 4, 6, mask);
+
+    REQUIRE(mask == std::vector<uint8_t>{ 1, 1, 0, 0, 0, 1, 1 });
+}
+
+TEST_CASE("threshold_hysteresis - within the band everywhere", "[signal_filter]") {
+    std::vector<uint8_t> mask;
+
+    threshold_hysteresis(std::vector<double>{ 4.5, 5.5, 4.5 }, 4, 6, mask);
+    REQUIRE(mask == std::vector<uint8_t>{ 1, 1, 1 });
+
+    threshold_hysteresis(std::vector<double>{ 5.5, 4.5, 5.5 }, 4, 6, mask);
+    REQUIRE(mask == std::vector<uint8_t>{ 0, 0, 0 });
+}
@@ -0,0 +1,261 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "util/small_flat_map.h"
+
+#include "allocation_budget.h"
+
+namespace {
+    enum class e_Kind: uint8_t {
+        gap,
+        arc,
+        broken
+    };
+
+    struct MoveOnly {
+        explicit MoveOnly(int value): m_Value(std::make_unique<int>(value)) {}
+
+        std::unique_ptr<int> m_Value;
+    };
+
+    // counts the live objects; moves throw on request
+    struct ThrowingMove {
+        static inline int  s_NumAlive   = 0;
+        static inline bool s_IsThrowing = false;
+
+        explicit ThrowingMove(int value): m_Value(value) { ++s_NumAlive; }
+
+        ThrowingMove(ThrowingMove&& other):
+            m_Value(other.m_Value)
+        {
+            if (s_IsThrowing)
+                throw std::runtime_error("move");
+
+            ++s_NumAlive;
+        }
+
+        ThrowingMove& operator = (ThrowingMove&& other) {
+            if (s_IsThrowing)
+                throw std::runtime_error("move");
+
+            m_Value = other.m_Value;
+            return *this;
+        }
+
+        ~ThrowingMove() { --s_NumAlive; }
+
+        int m_Value;
+    };
+}
+
+TEMPLATE_TEST_CASE("SmallFlatMap key sizes", "[SmallFlatMap]", int8_t, uint16_t, int32_t, uint64_t, int64_t) {
+    cc::SmallFlatMap<TestType, int, 20> map; // spans multiple 16-byte blocks for every key size
+
+    for (int i = 0; i < 20; ++i)
+        map.insert(static_cast<TestType>(i * 3), int(i));
+
+    REQUIRE(map.is_full());
+
+    for (int i = 0; i < 20; ++i) {
+        REQUIRE(map.contains(static_cast<TestType>(i * 3)));
+        REQUIRE(map[static_cast<TestType>(i * 3)] == i);
+
+        REQUIRE(!map.contains(static_cast<TestType>(i * 3 + 1)));
+    }
+
+    REQUIRE_THROWS_AS(map.insert(static_cast<TestType>(100), 0), std::length_error);
+}
+
+TEST_CASE("SmallFlatMap 64-bit keys compare both halves", "[SmallFlatMap]") {
+    cc::SmallFlatMap<uint64_t, int> map;
+
+    map.insert(0x0000'0001'0000'0002ull, 1);
+
+    REQUIRE( map.contains(0x0000'0001'0000'0002ull));
+    REQUIRE(!map.contains(0x0000'0003'0000'0002ull)); // same lower half
+    REQUIRE(!map.contains(0x0000'0001'0000'0003ull)); // same upper half
+}
+
+TEST_CASE("SmallFlatMap insert, overwrite and remove", "[SmallFlatMap]") {
+    cc::SmallFlatMap<e_Kind, std::string, 4> map;
+
+    map.insert(e_Kind::gap,    "gap");
+    map.insert(e_Kind::arc,    "arc");
+    map.insert(e_Kind::broken, "broken");
+    map.insert(e_Kind::gap,    "GAP");
+
+    REQUIRE(map.get_num_entries() == 3);
+    REQUIRE(map[e_Kind::gap] == "GAP");
+
+    map.remove(e_Kind::gap); // the last entry moves into its slot
+    map.remove(e_Kind::gap); // silently ignored
+
+    REQUIRE(map.get_num_entries() == 2);
+    REQUIRE(!map.contains(e_Kind::gap)); // its key is still in the (unused) third slot
+    REQUIRE(map[e_Kind::arc]    == "arc");
+    REQUIRE(map[e_Kind::broken] == "broken");
+
+    REQUIRE_THROWS_AS(map[e_Kind::gap], std::runtime_error);
+
+    map.clear();
+
+    REQUIRE(map.empty());
+    REQUIRE(!map.contains(e_Kind::arc));
+}
+
+TEST_CASE("SmallFlatMap try_emplace and emplace", "[SmallFlatMap]") {
+    cc::SmallFlatMap<int, MoveOnly> map;
+
+    auto [it, is_inserted] = map.try_emplace(1, 10);
+
+    REQUIRE(is_inserted);
+    REQUIRE(it->first == 1);
+    REQUIRE(*it->second.m_Value == 10);
+
+    auto [existing, is_inserted_again] = map.try_emplace(1, 20);
+
+    REQUIRE(!is_inserted_again);
+    REQUIRE(existing == it);
+    REQUIRE(*map[1].m_Value == 10); // untouched
+
+    REQUIRE(*map.emplace(1, 30).m_Value == 30); // replaced
+    REQUIRE(*map.emplace(2, 40).m_Value == 40); // inserted
+    REQUIRE(map.get_num_entries() == 2);
+
+    map.insert(3, MoveOnly(50));
+    map.insert(3, MoveOnly(60));
+
+    REQUIRE(*map[3].m_Value == 60);
+}
+
+TEST_CASE("SmallFlatMap emplace with a throwing move", "[SmallFlatMap]") {
+    {
+        cc::SmallFlatMap<int, ThrowingMove, 4> map;
+
+        map.emplace(1, 10);
+        map.emplace(2, 20);
+
+        ThrowingMove::s_IsThrowing = true;
+        REQUIRE_THROWS_AS(map.emplace(1, 11), std::runtime_error);
+        ThrowingMove::s_IsThrowing = false;
+
+        // the old value is still there
+        REQUIRE(map.size()               == 2);
+        REQUIRE(map[1].m_Value           == 10);
+        REQUIRE(map[2].m_Value           == 20);
+        REQUIRE(ThrowingMove::s_NumAlive == 2);
+
+        REQUIRE(map.emplace(1, 12).m_Value == 12);
+        REQUIRE(ThrowingMove::s_NumAlive == 2);
+    }
+
+    // nothing was destroyed twice
+    REQUIRE(ThrowingMove::s_NumAlive == 0);
+}
+
+TEST_CASE("SmallFlatMap remove with a throwing move", "[SmallFlatMap]") {
+    {
+        cc::SmallFlatMap<int, ThrowingMove, 4> map;
+
+        map.emplace(1, 10);
+        map.emplace(2, 20);
+        map.emplace(3, 30);
+
+        ThrowingMove::s_IsThrowing = true;
+        REQUIRE_THROWS_AS(map.remove(1), std::runtime_error);
+        ThrowingMove::s_IsThrowing = false;
+
+        // every entry is still there
+        REQUIRE(map.size()               == 3);
+        REQUIRE(map[1].m_Value           == 10);
+        REQUIRE(map[2].m_Value           == 20);
+        REQUIRE(map[3].m_Value           == 30);
+        REQUIRE(ThrowingMove::s_NumAlive == 3);
+
+        map.remove(1);
+
+        REQUIRE(map.size()               == 2);
+        REQUIRE(!map.contains(1));
+        REQUIRE(map[3].m_Value           == 30);
+        REQUIRE(ThrowingMove::s_NumAlive == 2);
+    }
+
+    // nothing was destroyed twice
+    REQUIRE(ThrowingMove::s_NumAlive == 0);
+}
+
+TEST_CASE("SmallFlatMap copy and move", "[SmallFlatMap]") {
+    cc::SmallFlatMap<uint16_t, std::string> map;
+
+    map.insert(7, "seven");
+    map.insert(9, "nine");
+
+    auto copy = map;
+
+    REQUIRE(copy.get_num_entries() == 2);
+    REQUIRE(copy[7] == "seven");
+    REQUIRE(map[9]  == "nine");
+
+    auto moved = std::move(copy);
+
+    REQUIRE(moved[9] == "nine");
+    REQUIRE(copy.empty()); // NOLINT: moved-from maps are empty
+
+    map = moved;
+    map.remove(7);
+
+    REQUIRE(moved.contains(7));
+
+    cc::SmallFlatMap<int, MoveOnly> move_only;
+    move_only.try_emplace(1, 1);
+
+    cc::SmallFlatMap<int, MoveOnly> other;
+    other = std::move(move_only);
+
+    REQUIRE(*other[1].m_Value == 1);
+}
+
+TEST_CASE("SmallFlatMap iteration", "[SmallFlatMap]") {
+    int a = 1;
+    int b = 2;
+
+    cc::SmallFlatMap<const int*, int> map; // pointers are fine as keys too
+
+    map.insert(&a, 10);
+    map.insert(&b, 20);
+
+    int total = 0;
+
+    for (auto [key, value] : map) {
+        value += *key;
+        total += value;
+    }
+
+    REQUIRE(total == 33);
+    REQUIRE(map[&b] == 22);
+
+    const auto& const_map = map;
+    REQUIRE(const_map.find(&a)->second == 11);
+    REQUIRE(const_map.find(nullptr) == const_map.end());
+}
+
+TEST_CASE("SmallFlatMap doesn't allocate", "[SmallFlatMap]") {
+    cc::SmallFlatMap<int, double, 8> map;
+
+    REQUIRE_ALLOCATIONS_AT_MOST(0, [&] {
+        for (int i = 0; i < 8; ++i)
+            map.insert(i, i * 0.5);
+
+        for (int i = 0; i < 8; i += 2)
+            map.remove(i);
+
+        return map.contains(3);
+    }());
+
+    REQUIRE(map[3] == 1.5);
+}
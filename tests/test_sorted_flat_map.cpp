@@ -0,0 +1,258 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../src/util/sorted_flat_map.h"
+
+namespace {
+    // a value that throws when it is copied once the budget is used up
+    struct ThrowingCopy {
+        static inline int s_NumCopiesLeft = std::numeric_limits<int>::max();
+
+        int m_Value = 0;
+
+        explicit ThrowingCopy(int value): m_Value(value) {}
+
+        ThrowingCopy(const ThrowingCopy& other):
+            m_Value(other.m_Value)
+        {
+            if (s_NumCopiesLeft-- <= 0)
+                throw std::runtime_error("copy budget exceeded");
+        }
+
+        ThrowingCopy& operator = (const ThrowingCopy&) = default;
+    };
+}
+
+TEST_CASE("insert keeps keys sorted", "[SortedFlatMap]") {
+    cc::SortedFlatMap<int, std::string> map;
+
+    map.insert(3, "three");
+    map.insert(1, "one");
+    map.insert(2, "two");
+    map.insert(1, "ONE");
+
+    REQUIRE(map.get_num_entries() == 3);
+    REQUIRE(map.keys()   == std::vector<int>         { 1, 2, 3 });
+    REQUIRE(map.values() == std::vector<std::string> { "ONE", "two", "three" });
+    REQUIRE(map[1] == "ONE");
+}
+
+TEST_CASE("remove keeps keys sorted", "[SortedFlatMap]") {
+    cc::SortedFlatMap<int, std::string> map;
+
+    map.insert(1, "one");
+    map.insert(2, "two");
+    map.insert(3, "three");
+
+    map.remove(2);
+    map.remove(99); // silently ignored
+
+    REQUIRE(map.get_num_entries() == 2);
+    REQUIRE(!map.contains(2));
+    REQUIRE(map[1] == "one");
+    REQUIRE(map[3] == "three");
+
+    REQUIRE_THROWS_AS(map[2], std::runtime_error);
+}
+
+TEST_CASE("insert_range sorts and deduplicates", "[SortedFlatMap]") {
+    cc::SortedFlatMap<int, std::string> map;
+
+    map.insert(5, "five");
+    map.insert(7, "seven");
+
+    std::vector<std::pair<int, std::string>> entries = {
+        { 3, "three"   },
+        { 5, "FIVE"    }, // overwrites an existing entry
+        { 1, "one"     },
+        { 3, "THREE"   }, // the last one in the range wins
+        { 9, "nine"    }
+    };
+
+    map.insert_range(entries);
+
+    REQUIRE(map.keys()   == std::vector<int>         { 1, 3, 5, 7, 9 });
+    REQUIRE(map.values() == std::vector<std::string> { "one", "THREE", "FIVE", "seven", "nine" });
+    REQUIRE(entries[0].second == "three"); // lvalue ranges are copied from
+
+    SECTION("from an rvalue range") {
+        map.insert_range(std::move(entries));
+
+        REQUIRE(map.get_num_entries() == 5);
+        REQUIRE(map[3] == "THREE");
+    }
+
+    SECTION("empty range") {
+        map.insert_range(std::vector<std::pair<int, std::string>>());
+        REQUIRE(map.get_num_entries() == 5);
+    }
+}
+
+TEST_CASE("insert_range matches repeated insert", "[SortedFlatMap]") {
+    std::vector<std::pair<int, int>> entries(1000);
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 300); // lots of duplicates
+
+    for (int i = 0; i < static_cast<int>(entries.size()); ++i)
+        entries[i] = { distribution(generator), i };
+
+    cc::SortedFlatMap<int, int> bulk;
+    cc::SortedFlatMap<int, int> incremental;
+    std::map<int, int>          reference;
+
+    bulk.insert_range(entries);
+
+    for (auto [key, value] : entries) {
+        incremental.insert(key, std::move(value));
+        reference.insert_or_assign(key, value);
+    }
+
+    REQUIRE(bulk.keys()   == incremental.keys());
+    REQUIRE(bulk.values() == incremental.values());
+    REQUIRE(std::equal(bulk.begin(), bulk.end(), reference.begin(), reference.end(), [](const auto& a, const auto& b) {
+        return a.first == b.first && a.second == b.second;
+    }));
+}
+
+TEST_CASE("heterogeneous lookup", "[SortedFlatMap]") {
+    cc::SortedFlatMap<std::string, int> map;
+
+    map.insert("hello", 42);
+    map.insert("world", 24);
+
+    std::string_view key = "world";
+
+    REQUIRE(map.contains(key));
+    REQUIRE(!map.contains(std::string_view("nope")));
+
+    auto it = map.find(key);
+
+    REQUIRE(it != map.end());
+    REQUIRE(it->first  == "world");
+    REQUIRE(it->second == 24);
+
+    REQUIRE(map.find("nope") == map.end());
+}
+
+TEST_CASE("iteration", "[SortedFlatMap]") {
+    cc::SortedFlatMap<int, double> map;
+
+    map.insert_range(std::vector<std::pair<int, double>> {
+        { 2, 2.0 },
+        { 0, 0.0 },
+        { 1, 1.0 }
+    });
+
+    int expected_key = 0;
+
+    for (auto [key, value] : map) {
+        REQUIRE(key == expected_key);
+
+        value *= 10.0; // refers to the value in the map
+        ++expected_key;
+    }
+
+    REQUIRE(map[2] == 20.0);
+
+    const auto& const_map = map;
+
+    REQUIRE(std::distance(const_map.begin(), const_map.end()) == 3);
+    REQUIRE(const_map.begin()[1].second == 10.0);
+    REQUIRE((map.end() - 1)->first == 2);
+
+    cc::SortedFlatMap<int, double>::const_iterator it = map.begin(); // iterator -> const_iterator
+    REQUIRE(it == const_map.cbegin());
+
+    auto found = std::lower_bound(map.begin(), map.end(), 1, [](const auto& entry, int key) {
+        return entry.first < key;
+    });
+
+    REQUIRE(found->second == 10.0);
+}
+
+TEST_CASE("move-only values", "[SortedFlatMap]") {
+    cc::SortedFlatMap<int, std::unique_ptr<int>> map;
+
+    map.insert(2, std::make_unique<int>(2));
+    map.insert(1, std::make_unique<int>(1));
+
+    std::vector<std::pair<int, std::unique_ptr<int>>> entries;
+    entries.emplace_back(3, std::make_unique<int>(3));
+    entries.emplace_back(0, std::make_unique<int>(0));
+
+    map.insert_range(std::move(entries));
+
+    REQUIRE(map.get_num_entries() == 4);
+
+    for (const auto& [key, value] : map)
+        REQUIRE(*value == key);
+}
+
+TEST_CASE("insert_range leaves the map unchanged when a copy throws", "[SortedFlatMap]") {
+    std::vector<std::pair<int, ThrowingCopy>> entries;
+
+    for (int key : { 5, 1, 3, 2 })
+        entries.emplace_back(key, ThrowingCopy(key * 10));
+
+    // let every copy throw in turn, until the budget is enough to complete
+    for (int budget = 0; ; ++budget) {
+        INFO("copy budget " << budget);
+
+        cc::SortedFlatMap<int, ThrowingCopy> map;
+
+        ThrowingCopy::s_NumCopiesLeft = std::numeric_limits<int>::max();
+
+        map.insert(2, ThrowingCopy(2));
+        map.insert(4, ThrowingCopy(4));
+
+        ThrowingCopy::s_NumCopiesLeft = budget;
+
+        try {
+            map.insert_range(entries);
+        }
+        catch (std::runtime_error&) {
+            REQUIRE(map.keys() == std::vector<int> { 2, 4 });
+            REQUIRE(map.values()[0].m_Value == 2);
+            REQUIRE(map.values()[1].m_Value == 4);
+            continue;
+        }
+
+        REQUIRE(map.keys() == std::vector<int> { 1, 2, 3, 4, 5 });
+        REQUIRE(map[2].m_Value == 20);
+        REQUIRE(map[4].m_Value == 4);
+        break;
+    }
+
+    ThrowingCopy::s_NumCopiesLeft = std::numeric_limits<int>::max();
+}
+
+TEST_CASE("reserve and clear", "[SortedFlatMap]") {
+    cc::SortedFlatMap<int, int> map;
+
+    map.reserve(64);
+    REQUIRE(map.keys().capacity() >= 64);
+    REQUIRE(map.empty());
+
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, i * 2);
+
+    REQUIRE(map.size() == 10);
+
+    map.clear();
+
+    REQUIRE(map.empty());
+    REQUIRE(!map.contains(1));
+}
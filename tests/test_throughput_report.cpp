@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "throughput_report.h"
+
+using namespace cc::bench;
+
+namespace {
+    std::optional<Metrics> parse(const std::string& text) {
+        std::istringstream is(text);
+        return read_metrics(is);
+    }
+}
+
+TEST_CASE("read_metrics - round trip", "[throughput]") {
+    Metrics metrics = {
+        { "fps",                            123.5  },
+        { "foreground.p99_us",              4100.0 },
+        { "find_anomalies.allocs_per_call", 0.0    }
+    };
+
+    std::stringstream ss;
+    write_metrics(ss, metrics);
+
+    auto result = read_metrics(ss);
+
+    REQUIRE(result.has_value());
+    REQUIRE(*result == metrics);
+}
+
+TEST_CASE("read_metrics - empty object", "[throughput]") {
+    auto result = parse(" { } ");
+
+    REQUIRE(result.has_value());
+    REQUIRE(result->empty());
+}
+
+TEST_CASE("read_metrics - malformed input", "[throughput]") {
+    REQUIRE(!parse("").has_value());
+    REQUIRE(!parse("[ 1, 2 ]").has_value());
+    REQUIRE(!parse("{ \"fps\": 10").has_value());             // unterminated object
+    REQUIRE(!parse("{ \"fps\" 10 }").has_value());            // no colon
+    REQUIRE(!parse("{ \"fps\": fast }").has_value());         // not a number
+    REQUIRE(!parse("{ \"fps: 10 }").has_value());             // unterminated name
+    REQUIRE(!parse("{ \"fps\": 10, }").has_value());          // trailing comma
+    REQUIRE(!parse("{ \"fps\": 10 \"p99\": 2 }").has_value()); // no comma
+}
+
+TEST_CASE("find_regressions - threshold boundary", "[throughput]") {
+    const Metrics baseline = { { "total.mean_us", 100.0 } };
+
+    // exactly at the threshold is still fine
+    REQUIRE(find_regressions(baseline, { { "total.mean_us", 110.0 } }, 0.1).empty());
+
+    auto regressions = find_regressions(baseline, { { "total.mean_us", 110.5 } }, 0.1);
+
+    REQUIRE(regressions.size() == 1);
+    REQUIRE(regressions[0].m_Metric   == "total.mean_us");
+    REQUIRE(regressions[0].m_Baseline == 100.0);
+    REQUIRE(regressions[0].m_Current  == 110.5);
+    REQUIRE(std::abs(regressions[0].m_Change - 0.105) < 1e-9);
+
+    // improvements are never regressions
+    REQUIRE(find_regressions(baseline, { { "total.mean_us", 50.0 } }, 0.1).empty());
+}
+
+TEST_CASE("find_regressions - higher is better for fps", "[throughput]") {
+    const Metrics baseline = { { "fps", 100.0 } };
+
+    REQUIRE(find_regressions(baseline, { { "fps", 150.0 } }, 0.1).empty());
+    REQUIRE(find_regressions(baseline, { { "fps",  90.0 } }, 0.1).empty());
+    REQUIRE(find_regressions(baseline, { { "fps",  89.0 } }, 0.1).size() == 1);
+}
+
+TEST_CASE("find_regressions - missing metrics are skipped", "[throughput]") {
+    const Metrics baseline = {
+        { "fps",               100.0 },
+        { "foreground.p99_us", 500.0 }
+    };
+
+    const Metrics current = {
+        { "fps",                  10.0   },
+        { "find_contours.p99_us", 9000.0 } // not in the baseline
+    };
+
+    auto regressions = find_regressions(baseline, current, 0.1);
+
+    // foreground.p99_us is not in the current run
+    REQUIRE(regressions.size() == 1);
+    REQUIRE(regressions[0].m_Metric == "fps");
+}
+
+TEST_CASE("find_regressions - metrics that aren't compared", "[throughput]") {
+    REQUIRE(!is_compared("frames"));
+    REQUIRE(find_regressions({ { "frames", 100.0 } }, { { "frames", 1.0 } }, 0.1).empty());
+}
+
+TEST_CASE("find_regressions - zero baseline", "[throughput]") {
+    const Metrics baseline = { { "process_contours.allocs_per_call", 0.0 } };
+
+    REQUIRE(find_regressions(baseline, { { "process_contours.allocs_per_call", 0.0 } }, 0.1).empty());
+
+    // a stage that starts allocating is always a regression
+    auto regressions = find_regressions(baseline, { { "process_contours.allocs_per_call", 1.0 } }, 0.1);
+
+    REQUIRE(regressions.size() == 1);
+    REQUIRE(std::isinf(regressions[0].m_Change));
+}
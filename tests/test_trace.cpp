@@ -0,0 +1,114 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/trace.h"
+
+using cc::util::Tracer;
+using cc::util::TraceScope;
+
+namespace {
+    size_t count_occurrences(const std::string& haystack, const std::string& needle) {
+        size_t result = 0;
+
+        for (
+            size_t pos = haystack.find(needle);
+                   pos != std::string::npos;
+                   pos = haystack.find(needle, pos + needle.size())
+        )
+            ++result;
+
+        return result;
+    }
+}
+
+TEST_CASE("tracer only records during a capture", "[trace]") {
+    Tracer tracer;
+
+    auto now = Tracer::Clock::now();
+
+    tracer.record("before", now, now);
+    REQUIRE(tracer.get_num_events() == 0);
+
+    tracer.start();
+    tracer.record("during", Tracer::Clock::now(), Tracer::Clock::now());
+    tracer.stop();
+
+    REQUIRE(tracer.get_num_events() == 1);
+
+    // a new capture discards the previous one
+    tracer.start();
+    tracer.stop();
+
+    REQUIRE(tracer.get_num_events() == 0);
+}
+
+TEST_CASE("tracer writes chrome trace json", "[trace]") {
+    Tracer tracer;
+
+    tracer.start();
+
+    std::thread worker([&] {
+        tracer.set_thread_name("worker");
+
+        for (int i = 0; i < 10; ++i) {
+            auto begin = Tracer::Clock::now();
+            tracer.record("work", begin, Tracer::Clock::now());
+        }
+    });
+    worker.join();
+
+    auto begin = Tracer::Clock::now();
+    tracer.record("main \"quoted\"", begin, Tracer::Clock::now());
+
+    tracer.stop();
+
+    std::stringstream ss;
+    tracer.write_chrome_trace(ss);
+    std::string json = ss.str();
+
+    REQUIRE(tracer.get_num_events() == 11);
+    REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    REQUIRE(count_occurrences(json, R"("ph":"X")")     == 11);
+    REQUIRE(count_occurrences(json, R"("name":"work")") == 10);
+    REQUIRE(count_occurrences(json, R"("name":"worker")") == 1);          // thread name metadata
+    REQUIRE(count_occurrences(json, R"("name":"main \"quoted\"")") == 1); // escaped
+}
+
+TEST_CASE("tracer drops events when a thread buffer is full", "[trace]") {
+    Tracer tracer(4);
+
+    tracer.start();
+
+    for (int i = 0; i < 10; ++i) {
+        auto begin = Tracer::Clock::now();
+        tracer.record("event", begin, Tracer::Clock::now());
+    }
+
+    tracer.stop();
+
+    REQUIRE(tracer.get_num_events()  == 4);
+    REQUIRE(tracer.get_num_dropped() == 6);
+}
+
+TEST_CASE("trace scope records into the global tracer", "[trace]") {
+    auto& tracer = Tracer::instance();
+
+    {
+        TraceScope outside_capture("outside");
+    }
+
+    tracer.start();
+
+    {
+        TraceScope outer("outer");
+        TraceScope inner("inner");
+    }
+
+    tracer.stop();
+
+    REQUIRE(tracer.get_num_events() == 2);
+}